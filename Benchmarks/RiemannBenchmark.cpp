@@ -0,0 +1,365 @@
+/************************************************************************
+ * Copyright © 2020 The Multiphysics Modeling and Computation (M2C) Lab
+ * <kevin.wgy@gmail.com> <kevinw3@vt.edu>
+ ************************************************************************/
+
+/*********************************************************************************
+ * Micro-benchmark of the exact Riemann solvers (ExactRiemannSolverBase and
+ * ExactRiemannSolverInterfaceJump) and the numerical flux functions (LLF, HLLC,
+ * GenRoe, Godunov), independent of the M2C solver. It reads a regular M2C input
+ * file, but only uses the material models (Equations), the exact Riemann solver
+ * parameters (ExactRiemannSolution), and the states specified in the boundary and
+ * initial conditions (Inlet, Inlet2, GeometricEntities) as reference states.
+ * Problems:
+ *   1. The input problem: Inlet (left) vs. Inlet2 (right), as in Tests/RiemannProblems.
+ *   2. A sweep over every (ordered) pair of materials: For each pair of reference
+ *      states, the left and right pressures are scaled by 0.5, 1, and 4 (at fixed
+ *      density), and a relative velocity of -0.2, 0, or 0.2 times the average
+ *      sound speed is added (i.e. expansion, contact, compression).
+ *      States that violate hyperbolicity are skipped.
+ * Reported: time per call (ns), iterations of the main loop of the exact Riemann
+ * solver (mean and max), and the failure rate (non-zero error code).
+ * Usage:
+ *   riemann_benchmark <input file> [number of repetitions (default: 100)]
+ *   e.g., riemann_benchmark Tests/RiemannProblems/Test7/input.st  (repeat for Test1, ..., Test12)
+ *         riemann_benchmark Benchmarks/AllEOS/input.st  (all the EOS types)
+ * Note: Runs on a single process. (With more processes, every process does the same.)
+ *********************************************************************************/
+
+#include <VarFcnSG.h>
+#include <VarFcnNASG.h>
+#include <VarFcnMG.h>
+#include <VarFcnMGExt.h>
+#include <VarFcnTillot.h>
+#include <VarFcnJWL.h>
+#include <VarFcnANEOSEx1.h>
+#include <VarFcnTabulated.h>
+#include <FluxFcnGenRoe.h>
+#include <FluxFcnLLF.h>
+#include <FluxFcnHLLC.h>
+#include <FluxFcnGodunov.h>
+#include <ExactRiemannSolverInterfaceJump.h>
+#include <Timer.h>
+#include <Utils.h>
+#include <cmath>
+#include <array>
+#include <map>
+#include <string>
+
+int verbose;
+double domain_diagonal;
+double start_time;
+MPI_Comm m2c_comm;
+Timer m2c_timer;
+
+int INACTIVE_MATERIAL_ID;
+
+typedef std::array<double,5> State; //primitive state
+
+struct RiemannProblem {
+  State Vm, Vp;
+  int idm, idp;
+};
+
+//! Statistics of one solver (or flux function) on a set of problems
+struct BenchmarkResult {
+  double ns_per_call;
+  double mean_iters;
+  int max_iters;
+  double failure_rate; //!< percentage
+};
+
+//---------------------------------------------------------------------------------
+
+static const char*
+GetEOSName(VarFcnBase &vf)
+{
+  switch(vf.type) {
+    case VarFcnBase::STIFFENED_GAS :               return "SG";
+    case VarFcnBase::NOBLE_ABEL_STIFFENED_GAS :    return "NASG";
+    case VarFcnBase::MIE_GRUNEISEN :               return "MG";
+    case VarFcnBase::EXTENDED_MIE_GRUNEISEN :      return "MGExt";
+    case VarFcnBase::TILLOTSON :                   return "Tillotson";
+    case VarFcnBase::JWL :                         return "JWL";
+    case VarFcnBase::ANEOS_BIRCH_MURNAGHAN_DEBYE : return "ANEOS";
+    default :                                      return "Other";
+  }
+}
+
+//---------------------------------------------------------------------------------
+
+static void
+AddReferenceState(StateVariable &s, std::vector<VarFcnBase*> &vf, std::map<int, std::vector<State> > &refs)
+{
+  if(s.materialid<0 || s.materialid>=(int)vf.size() || s.pressure==0.0)
+    return; //not specified by user
+  if(vf[s.materialid]->CheckState(s.density, s.pressure, true))
+    return;
+  refs[s.materialid].push_back(State{s.density, s.velocity_x, s.velocity_y, s.velocity_z, s.pressure});
+}
+
+//---------------------------------------------------------------------------------
+
+static double
+SoundSpeed(VarFcnBase &vf, const State &V)
+{
+  double e  = vf.GetInternalEnergyPerUnitMass(V[0], V[4]);
+  double c2 = vf.ComputeSoundSpeedSquare(V[0], e);
+  return c2>0.0 ? sqrt(c2) : 0.0;
+}
+
+//---------------------------------------------------------------------------------
+
+static BenchmarkResult
+RunRiemannSolver(ExactRiemannSolverBase &riemann, std::vector<RiemannProblem> &problems, int reps)
+{
+  BenchmarkResult res{0.0, 0.0, 0, 0.0};
+  if(problems.empty())
+    return res;
+
+  double dir[3] = {1.0, 0.0, 0.0};
+  double Vm[5], Vp[5], Vs[5], Vsm[5], Vsp[5];
+  int id;
+
+  // one pass to collect iterations and failures
+  long long total_iters = 0;
+  int failures = 0;
+  for(auto&& prob : problems) {
+    std::copy(prob.Vm.begin(), prob.Vm.end(), Vm);
+    std::copy(prob.Vp.begin(), prob.Vp.end(), Vp);
+    if(riemann.ComputeRiemannSolution(dir, Vm, prob.idm, Vp, prob.idp, Vs, id, Vsm, Vsp))
+      failures++;
+    int its = riemann.GetNumberOfIterations();
+    total_iters += its;
+    res.max_iters = std::max(res.max_iters, its);
+  }
+  res.mean_iters   = (double)total_iters/problems.size();
+  res.failure_rate = 100.0*failures/problems.size();
+
+  // timing
+  double t0 = walltime();
+  for(int r=0; r<reps; r++)
+    for(auto&& prob : problems) {
+      std::copy(prob.Vm.begin(), prob.Vm.end(), Vm);
+      std::copy(prob.Vp.begin(), prob.Vp.end(), Vp);
+      riemann.ComputeRiemannSolution(dir, Vm, prob.idm, Vp, prob.idp, Vs, id, Vsm, Vsp);
+    }
+  res.ns_per_call = (walltime() - t0)*1.0e9/((double)reps*problems.size());
+
+  return res;
+}
+
+//---------------------------------------------------------------------------------
+
+static BenchmarkResult
+RunFluxFunction(FluxFcnBase &ff, std::vector<RiemannProblem> &problems, int reps)
+{
+  BenchmarkResult res{0.0, 0.0, 0, 0.0};
+  if(problems.empty())
+    return res;
+
+  double Vm[5], Vp[5], F[5];
+  volatile double sink = 0.0; //prevents the compiler from skipping the calls
+
+  int failures = 0;
+  for(auto&& prob : problems) {
+    std::copy(prob.Vm.begin(), prob.Vm.end(), Vm);
+    std::copy(prob.Vp.begin(), prob.Vp.end(), Vp);
+    ff.ComputeNumericalFluxAtCellInterface(0, Vm, Vp, prob.idm, F);
+    for(int i=0; i<5; i++)
+      if(!std::isfinite(F[i])) {
+        failures++;
+        break;
+      }
+  }
+  res.failure_rate = 100.0*failures/problems.size();
+
+  double t0 = walltime();
+  for(int r=0; r<reps; r++)
+    for(auto&& prob : problems) {
+      std::copy(prob.Vm.begin(), prob.Vm.end(), Vm);
+      std::copy(prob.Vp.begin(), prob.Vp.end(), Vp);
+      ff.ComputeNumericalFluxAtCellInterface(0, Vm, Vp, prob.idm, F);
+      sink = F[0];
+    }
+  res.ns_per_call = (walltime() - t0)*1.0e9/((double)reps*problems.size());
+  (void)sink;
+
+  return res;
+}
+
+//---------------------------------------------------------------------------------
+
+static void
+PrintResult(const char *name, BenchmarkResult &res, bool iterations)
+{
+  if(iterations)
+    print("    %-16s %12.1f ns/call | iterations: %6.2f (mean), %4d (max) | failures: %6.2f%%\n",
+          name, res.ns_per_call, res.mean_iters, res.max_iters, res.failure_rate);
+  else
+    print("    %-16s %12.1f ns/call | failures: %6.2f%%\n", name, res.ns_per_call, res.failure_rate);
+}
+
+//---------------------------------------------------------------------------------
+
+static void
+RunAllSolvers(std::vector<RiemannProblem> &problems, int reps, ExactRiemannSolverBase &riemann,
+              ExactRiemannSolverInterfaceJump &riemann_jump, std::vector<FluxFcnBase*> &ffs,
+              std::vector<std::string> &ff_names)
+{
+  BenchmarkResult res = RunRiemannSolver(riemann, problems, reps);
+  PrintResult("ExactRiemann", res, true);
+  res = RunRiemannSolver(riemann_jump, problems, reps);
+  PrintResult("InterfaceJump", res, true);
+
+  if(problems[0].idm != problems[0].idp)
+    return; //flux functions are for a single material
+
+  for(int i=0; i<(int)ffs.size(); i++) {
+    res = RunFluxFunction(*ffs[i], problems, reps);
+    PrintResult(ff_names[i].c_str(), res, false);
+  }
+}
+
+/*********************************************************************************
+ * Main Function
+ ********************************************************************************/
+int main(int argc, char* argv[])
+{
+  MPI_Init(NULL,NULL);
+  start_time = walltime();
+  m2c_comm = MPI_COMM_WORLD;
+
+  if(argc<2) {
+    print_error("*** Error: Usage: riemann_benchmark <input file> [number of repetitions]\n");
+    exit_mpi();
+  }
+  int reps = argc>2 ? atoi(argv[2]) : 100;
+  if(reps<1) reps = 1;
+
+  //! Read the input file. (Note: iod.finalize() is not called, as mesh files, etc. are not needed.)
+  IoData iod(argc, argv);
+  verbose = 0; //no warnings from the Riemann solvers
+
+  //! Initialize VarFcn (same as in Main.cpp)
+  int nmat = iod.eqs.materials.dataMap.size();
+  std::vector<VarFcnBase *> vf(nmat, NULL);
+  for(auto it = iod.eqs.materials.dataMap.begin(); it != iod.eqs.materials.dataMap.end(); it++) {
+    int matid = it->first;
+    if(matid < 0 || matid >= nmat) {
+      print_error("*** Error: Detected error in the specification of material indices (id = %d).\n", matid);
+      exit_mpi();
+    }
+    if(it->second->eos == MaterialModelData::STIFFENED_GAS)
+      vf[matid] = new VarFcnSG(*it->second);
+    else if(it->second->eos == MaterialModelData::NOBLE_ABEL_STIFFENED_GAS)
+      vf[matid] = new VarFcnNASG(*it->second);
+    else if(it->second->eos == MaterialModelData::MIE_GRUNEISEN)
+      vf[matid] = new VarFcnMG(*it->second);
+    else if(it->second->eos == MaterialModelData::EXTENDED_MIE_GRUNEISEN)
+      vf[matid] = new VarFcnMGExt(*it->second);
+    else if(it->second->eos == MaterialModelData::TILLOTSON)
+      vf[matid] = new VarFcnTillot(*it->second);
+    else if(it->second->eos == MaterialModelData::JWL)
+      vf[matid] = new VarFcnJWL(*it->second);
+    else if(it->second->eos == MaterialModelData::ANEOS_BIRCH_MURNAGHAN_DEBYE)
+      vf[matid] = new VarFcnANEOSEx1(*it->second);
+    else {
+      print_error("*** Error: Material %d is not supported by the benchmark (compressible only).\n", matid);
+      exit_mpi();
+    }
+    if(it->second->eos_table.type != EOSRuntimeTableData::NONE) //benchmark the tables
+      vf[matid] = new VarFcnTabulated(*it->second, vf[matid]);
+  }
+  for(int i=0; i<nmat; i++)
+    if(!vf[i]) {
+      print_error("*** Error: Detected error in the specification of material IDs.\n");
+      exit_mpi();
+    }
+  INACTIVE_MATERIAL_ID = nmat; //not used
+
+  //! Solvers and flux functions
+  ExactRiemannSolverBase riemann(vf, iod.exact_riemann);
+  ExactRiemannSolverInterfaceJump riemann_jump(vf, iod.exact_riemann);
+  std::vector<FluxFcnBase*> ffs{new FluxFcnLLF(vf, iod), new FluxFcnHLLC(vf, iod),
+                                new FluxFcnGenRoe(vf, iod), new FluxFcnGodunov(vf, iod)};
+  std::vector<std::string> ff_names{"LLF", "HLLC", "GenRoe", "Godunov"};
+
+  //! Collect reference states
+  std::map<int, std::vector<State> > refs;
+  AddReferenceState(iod.bc.inlet, vf, refs);
+  AddReferenceState(iod.bc.inlet2, vf, refs);
+  MultiInitialConditionsData &ic(iod.ic.multiInitialConditions);
+  for(auto&& obj : ic.pointMap.dataMap)          AddReferenceState(obj.second->initialConditions, vf, refs);
+  for(auto&& obj : ic.planeMap.dataMap)          AddReferenceState(obj.second->initialConditions, vf, refs);
+  for(auto&& obj : ic.sphereMap.dataMap)         AddReferenceState(obj.second->initialConditions, vf, refs);
+  for(auto&& obj : ic.parallelepipedMap.dataMap) AddReferenceState(obj.second->initialConditions, vf, refs);
+  for(auto&& obj : ic.spheroidMap.dataMap)       AddReferenceState(obj.second->initialConditions, vf, refs);
+  for(auto&& obj : ic.cylinderconeMap.dataMap)   AddReferenceState(obj.second->initialConditions, vf, refs);
+  for(auto&& obj : ic.cylindersphereMap.dataMap) AddReferenceState(obj.second->initialConditions, vf, refs);
+
+  print("\n- Riemann solver benchmark: %s (%d materials, %d repetitions).\n", argv[1], nmat, reps);
+  for(auto&& ref : refs)
+    print("  o Material %d (%s): %d reference state(s).\n", ref.first, GetEOSName(*vf[ref.first]),
+          (int)ref.second.size());
+
+  //! Problem 1: Inlet vs. Inlet2
+  StateVariable &sl(iod.bc.inlet), &sr(iod.bc.inlet2);
+  if(sl.pressure!=0.0 && sr.pressure!=0.0 && sl.materialid>=0 && sl.materialid<nmat &&
+     sr.materialid>=0 && sr.materialid<nmat &&
+     !vf[sl.materialid]->CheckState(sl.density, sl.pressure, true) &&
+     !vf[sr.materialid]->CheckState(sr.density, sr.pressure, true)) {
+    std::vector<RiemannProblem> problems(1);
+    problems[0].Vm  = State{sl.density, sl.velocity_x, sl.velocity_y, sl.velocity_z, sl.pressure};
+    problems[0].Vp  = State{sr.density, sr.velocity_x, sr.velocity_y, sr.velocity_z, sr.pressure};
+    problems[0].idm = sl.materialid;
+    problems[0].idp = sr.materialid;
+    print("\n  o Input problem (Inlet vs. Inlet2): material %d (%s) | material %d (%s)\n",
+          sl.materialid, GetEOSName(*vf[sl.materialid]), sr.materialid, GetEOSName(*vf[sr.materialid]));
+    RunAllSolvers(problems, reps, riemann, riemann_jump, ffs, ff_names);
+  }
+
+  //! Problem 2: Sweep over material pairs
+  double pfac[3] = {0.5, 1.0, 4.0};
+  double ufac[3] = {-0.2, 0.0, 0.2};
+  for(auto&& refm : refs) {
+    for(auto&& refp : refs) {
+      int idm = refm.first, idp = refp.first;
+      std::vector<RiemannProblem> problems;
+      for(auto&& Vm0 : refm.second)
+        for(auto&& Vp0 : refp.second)
+          for(int a=0; a<3; a++)
+            for(int b=0; b<3; b++) {
+              RiemannProblem prob{Vm0, Vp0, idm, idp};
+              prob.Vm[4] *= pfac[a];
+              prob.Vp[4] *= pfac[b];
+              if(vf[idm]->CheckState(prob.Vm[0], prob.Vm[4], true) ||
+                 vf[idp]->CheckState(prob.Vp[0], prob.Vp[4], true))
+                continue;
+              double c_avg = 0.5*(SoundSpeed(*vf[idm], prob.Vm) + SoundSpeed(*vf[idp], prob.Vp));
+              for(int c=0; c<3; c++) {
+                RiemannProblem prob2 = prob;
+                prob2.Vm[1] += 0.5*ufac[c]*c_avg;
+                prob2.Vp[1] -= 0.5*ufac[c]*c_avg;
+                problems.push_back(prob2);
+              }
+            }
+      if(problems.empty())
+        continue;
+      print("\n  o Sweep: material %d (%s) | material %d (%s): %d problems\n", idm, GetEOSName(*vf[idm]),
+            idp, GetEOSName(*vf[idp]), (int)problems.size());
+      RunAllSolvers(problems, reps, riemann, riemann_jump, ffs, ff_names);
+    }
+  }
+  print("\n");
+
+  for(auto&& ff : ffs)
+    delete ff;
+  for(auto&& v : vf)
+    delete v;
+
+  MPI_Finalize();
+  return 0;
+}
+
+//---------------------------------------------------------------------------------
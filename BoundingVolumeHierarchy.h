@@ -0,0 +1,429 @@
+/************************************************************************
+ * Copyright © 2020 The Multiphysics Modeling and Computation (M2C) Lab
+ * <kevin.wgy@gmail.com> <kevinw3@vt.edu>
+ ************************************************************************/
+
+#ifndef _BOUNDING_VOLUME_HIERARCHY_H_
+#define _BOUNDING_VOLUME_HIERARCHY_H_
+
+#include <vector>
+#include <algorithm>
+#include <cfloat>
+
+/**********************************************************************************
+ * class BVH is a bounding volume hierarchy of objects with axis-aligned bounding
+ * boxes. Like KDTree, the Obj class must provide val(d) (lower corner of its box)
+ * and width(d), and the tree does not store its own copy of the objects: the
+ * array passed to the constructor is reordered and referenced by the tree.
+ * The tree is built top-down using the surface area heuristic (SAH), evaluated
+ * on a fixed number of bins. When the objects move (i.e. their boxes are updated
+ * in place), the tree can be refitted in O(n) without changing its topology.
+ * Refit() returns the ratio of the current SAH cost to that right after the build,
+ * which can be used to decide when to rebuild the tree.
+ * The query functions have the same arguments and return values as those of KDTree.
+ **********************************************************************************/
+
+template <class Obj, int dim=3>
+class BVH {
+
+  struct Node {
+    double bmin[dim], bmax[dim];
+    int first, count; //!< objects of a leaf (count>0 means leaf)
+    int right; //!< index of the right child (the left child is the next node)
+  };
+
+  int nObj;
+  Obj *obj;
+  std::vector<Node> nodes; //!< depth-first order (a child always follows its parent)
+
+  double built_cost; //!< SAH cost right after the build
+
+  static const int nBins = 16;
+  static const int maxLeafSize = 8;
+
+public:
+
+  BVH(int nobj, Obj *allObjs);
+  ~BVH() {}
+
+  //! Recomputes the bounding boxes after the objects have moved. Returns the SAH cost relative to the original
+  double Refit();
+
+  int maxdepth() {return nodes.empty() ? 0 : Depth(0);}
+
+  int findCloseCandidates(double x[dim], Obj *o, int maxNObj, double &dist);
+  int findCandidatesWithin(double x[dim], Obj *o, int maxNObj, double dist);
+  int findCandidatesInBox(double xmin[dim], double xmax[dim], Obj *o, int maxNObj);
+
+private:
+
+  void Build(int first, int count);
+  void SetLeafBox(Node &node);
+  void MergeChildBoxes(int n);
+  double SAHCost();
+
+  int Depth(int n) {
+    return nodes[n].count>0 ? 1 : std::max(Depth(n+1), Depth(nodes[n].right))+1;}
+
+  static double HalfArea(const double *bmin, const double *bmax) {
+    double a = 0.0;
+    for(int d=0; d<dim; d++) {
+      double p = 1.0;
+      for(int e=0; e<dim; e++)
+        if(e!=d) p *= std::max(bmax[e]-bmin[e], 0.0);
+      a += p;
+    }
+    return a;
+  }
+
+  //! Chebyshev (max-norm) distance from x to a box, 0 if inside (same measure as in KDTree)
+  static double BoxDistance(const double *x, const double *bmin, const double *bmax) {
+    double dist = 0.0;
+    for(int d=0; d<dim; d++)
+      dist = std::max(dist, std::max(bmin[d]-x[d], x[d]-bmax[d]));
+    return dist;
+  }
+
+  static double ObjDistance(const double *x, const Obj &o) {
+    double dist = 0.0;
+    for(int d=0; d<dim; d++)
+      dist = std::max(dist, std::max(o.val(d)-x[d], x[d]-o.val(d)-o.width(d)));
+    return dist;
+  }
+
+  void FindInBox(int n, double *xmin, double *xmax, Obj *o, int maxNObj, int &nFound);
+  bool FindWithin(int n, double *x, Obj *o, int maxNObj, double dist, int &nFound);
+  bool FindClose(int n, double *x, Obj *o, int maxNObj, double &dist, int &nFound);
+
+};
+
+//------------------------------------------------------------------------------
+
+template <class Obj, int dim>
+BVH<Obj, dim>::BVH(int nobj, Obj *allObjs) : nObj(nobj), obj(allObjs), built_cost(0.0)
+{
+  if(nObj<=0)
+    return;
+  nodes.reserve(2*(nObj/maxLeafSize+1));
+  Build(0, nObj);
+  built_cost = SAHCost();
+}
+
+//------------------------------------------------------------------------------
+
+template <class Obj, int dim>
+void
+BVH<Obj, dim>::Build(int first, int count)
+{
+  int n = nodes.size();
+  nodes.push_back(Node());
+  nodes[n].first = first;
+  nodes[n].count = count;
+  nodes[n].right = -1;
+  SetLeafBox(nodes[n]);
+
+  if(count <= 2)
+    return; //leaf
+
+  // bounds of the centroids
+  double cmin[dim], cmax[dim];
+  for(int d=0; d<dim; d++) {
+    cmin[d] = DBL_MAX;
+    cmax[d] = -DBL_MAX;
+  }
+  for(int i=first; i<first+count; i++)
+    for(int d=0; d<dim; d++) {
+      double c = obj[i].val(d) + 0.5*obj[i].width(d);
+      cmin[d] = std::min(cmin[d], c);
+      cmax[d] = std::max(cmax[d], c);
+    }
+
+  // binned SAH: find the best split plane
+  int best_dir = -1, best_bin = -1;
+  double best_cost = DBL_MAX;
+  for(int d=0; d<dim; d++) {
+    if(cmax[d] <= cmin[d])
+      continue;
+    double scale = nBins/(cmax[d]-cmin[d]);
+
+    int bin_count[nBins];
+    double bin_min[nBins][dim], bin_max[nBins][dim];
+    for(int b=0; b<nBins; b++) {
+      bin_count[b] = 0;
+      for(int e=0; e<dim; e++) {
+        bin_min[b][e] = DBL_MAX;
+        bin_max[b][e] = -DBL_MAX;
+      }
+    }
+    for(int i=first; i<first+count; i++) {
+      int b = std::min(nBins-1, (int)((obj[i].val(d) + 0.5*obj[i].width(d) - cmin[d])*scale));
+      bin_count[b]++;
+      for(int e=0; e<dim; e++) {
+        bin_min[b][e] = std::min(bin_min[b][e], obj[i].val(e));
+        bin_max[b][e] = std::max(bin_max[b][e], obj[i].val(e) + obj[i].width(e));
+      }
+    }
+
+    // sweep from the right, then from the left
+    double right_area[nBins];
+    double lo[dim], hi[dim];
+    for(int e=0; e<dim; e++) {
+      lo[e] = DBL_MAX;
+      hi[e] = -DBL_MAX;
+    }
+    int right_count[nBins], nr = 0;
+    for(int b=nBins-1; b>0; b--) {
+      nr += bin_count[b];
+      for(int e=0; e<dim; e++) {
+        lo[e] = std::min(lo[e], bin_min[b][e]);
+        hi[e] = std::max(hi[e], bin_max[b][e]);
+      }
+      right_count[b] = nr;
+      right_area[b]  = nr ? HalfArea(lo, hi) : 0.0;
+    }
+    for(int e=0; e<dim; e++) {
+      lo[e] = DBL_MAX;
+      hi[e] = -DBL_MAX;
+    }
+    int nl = 0;
+    for(int b=0; b<nBins-1; b++) { //split between bins b and b+1
+      nl += bin_count[b];
+      for(int e=0; e<dim; e++) {
+        lo[e] = std::min(lo[e], bin_min[b][e]);
+        hi[e] = std::max(hi[e], bin_max[b][e]);
+      }
+      if(nl==0 || right_count[b+1]==0)
+        continue;
+      double cost = nl*HalfArea(lo, hi) + right_count[b+1]*right_area[b+1];
+      if(cost < best_cost) {
+        best_cost = cost;
+        best_dir  = d;
+        best_bin  = b;
+      }
+    }
+  }
+
+  int mid;
+  if(best_dir<0) { //all centroids coincide
+    if(count <= maxLeafSize)
+      return; //leaf
+    mid = first + count/2;
+  }
+  else {
+    // compare with the cost of not splitting (traversal cost ~ one intersection test)
+    double leaf_cost = count*HalfArea(nodes[n].bmin, nodes[n].bmax);
+    if(count <= maxLeafSize && best_cost + HalfArea(nodes[n].bmin, nodes[n].bmax) >= leaf_cost)
+      return; //leaf
+
+    int d = best_dir;
+    double scale = nBins/(cmax[d]-cmin[d]);
+    double dmin = cmin[d];
+    Obj *pivot = std::partition(obj+first, obj+first+count,
+                   [&](const Obj &o) {
+                     return std::min(nBins-1, (int)((o.val(d) + 0.5*o.width(d) - dmin)*scale)) <= best_bin;});
+    mid = pivot - obj;
+    if(mid==first || mid==first+count) //should not happen, but just in case (round-off)
+      mid = first + count/2;
+  }
+
+  nodes[n].count = 0; //not a leaf
+  Build(first, mid-first);
+  nodes[n].right = nodes.size();
+  Build(mid, first+count-mid);
+}
+
+//------------------------------------------------------------------------------
+
+template <class Obj, int dim>
+void
+BVH<Obj, dim>::SetLeafBox(Node &node)
+{
+  for(int d=0; d<dim; d++) {
+    node.bmin[d] = DBL_MAX;
+    node.bmax[d] = -DBL_MAX;
+  }
+  for(int i=node.first; i<node.first+node.count; i++)
+    for(int d=0; d<dim; d++) {
+      node.bmin[d] = std::min(node.bmin[d], obj[i].val(d));
+      node.bmax[d] = std::max(node.bmax[d], obj[i].val(d) + obj[i].width(d));
+    }
+}
+
+//------------------------------------------------------------------------------
+
+template <class Obj, int dim>
+void
+BVH<Obj, dim>::MergeChildBoxes(int n)
+{
+  Node &left(nodes[n+1]), &right(nodes[nodes[n].right]);
+  for(int d=0; d<dim; d++) {
+    nodes[n].bmin[d] = std::min(left.bmin[d], right.bmin[d]);
+    nodes[n].bmax[d] = std::max(left.bmax[d], right.bmax[d]);
+  }
+}
+
+//------------------------------------------------------------------------------
+
+template <class Obj, int dim>
+double
+BVH<Obj, dim>::Refit()
+{
+  // children are always stored after their parent
+  for(int n=nodes.size()-1; n>=0; n--) {
+    if(nodes[n].count>0)
+      SetLeafBox(nodes[n]);
+    else
+      MergeChildBoxes(n);
+  }
+
+  return built_cost>0.0 ? SAHCost()/built_cost : 1.0;
+}
+
+//------------------------------------------------------------------------------
+
+template <class Obj, int dim>
+double
+BVH<Obj, dim>::SAHCost()
+{
+  if(nodes.empty())
+    return 0.0;
+
+  double cost = 0.0;
+  for(auto&& node : nodes)
+    cost += HalfArea(node.bmin, node.bmax)*(node.count>0 ? node.count : 1);
+
+  double root_area = HalfArea(nodes[0].bmin, nodes[0].bmax);
+  return root_area>0.0 ? cost/root_area : cost;
+}
+
+//------------------------------------------------------------------------------
+
+template <class Obj, int dim>
+int
+BVH<Obj, dim>::findCandidatesInBox(double xmin[dim], double xmax[dim], Obj *o, int maxNObj)
+{
+  int nFound = 0;
+  if(!nodes.empty())
+    FindInBox(0, xmin, xmax, o, maxNObj, nFound);
+  return nFound; //may be larger than maxNObj (only maxNObj are stored)
+}
+
+//------------------------------------------------------------------------------
+
+template <class Obj, int dim>
+void
+BVH<Obj, dim>::FindInBox(int n, double *xmin, double *xmax, Obj *o, int maxNObj, int &nFound)
+{
+  Node &node(nodes[n]);
+  for(int d=0; d<dim; d++)
+    if(xmax[d] < node.bmin[d] || xmin[d] > node.bmax[d])
+      return;
+
+  if(node.count>0) {
+    for(int i=node.first; i<node.first+node.count; i++) {
+      bool isOutside = false;
+      for(int d=0; d<dim; d++)
+        if(xmax[d] < obj[i].val(d) || xmin[d] > obj[i].val(d)+obj[i].width(d)) {
+          isOutside = true;
+          break;
+        }
+      if(isOutside)
+        continue;
+      if(nFound < maxNObj)
+        o[nFound] = obj[i];
+      nFound++;
+    }
+    return;
+  }
+
+  FindInBox(n+1, xmin, xmax, o, maxNObj, nFound);
+  FindInBox(node.right, xmin, xmax, o, maxNObj, nFound);
+}
+
+//------------------------------------------------------------------------------
+
+template <class Obj, int dim>
+int
+BVH<Obj, dim>::findCandidatesWithin(double x[dim], Obj *o, int maxNObj, double dist)
+{
+  int nFound = 0;
+  if(!nodes.empty() && !FindWithin(0, x, o, maxNObj, dist, nFound))
+    return maxNObj+1; // we do not have enough space
+  return nFound;
+}
+
+//------------------------------------------------------------------------------
+
+template <class Obj, int dim>
+bool
+BVH<Obj, dim>::FindWithin(int n, double *x, Obj *o, int maxNObj, double dist, int &nFound)
+{
+  Node &node(nodes[n]);
+  if(BoxDistance(x, node.bmin, node.bmax) > dist)
+    return true;
+
+  if(node.count>0) {
+    for(int i=node.first; i<node.first+node.count; i++) {
+      if(ObjDistance(x, obj[i]) > dist)
+        continue;
+      if(nFound >= maxNObj)
+        return false;
+      o[nFound++] = obj[i];
+    }
+    return true;
+  }
+
+  return FindWithin(n+1, x, o, maxNObj, dist, nFound) &&
+         FindWithin(node.right, x, o, maxNObj, dist, nFound);
+}
+
+//------------------------------------------------------------------------------
+
+template <class Obj, int dim>
+int
+BVH<Obj, dim>::findCloseCandidates(double x[dim], Obj *o, int maxNObj, double &dist)
+{
+  int nFound = 0;
+  if(!nodes.empty() && !FindClose(0, x, o, maxNObj, dist, nFound))
+    return maxNObj+1; // we do not have enough space
+  return nFound;
+}
+
+//------------------------------------------------------------------------------
+
+//! Finds the objects with the smallest (pseudo-)distance to x. dist<0: no initial bound
+template <class Obj, int dim>
+bool
+BVH<Obj, dim>::FindClose(int n, double *x, Obj *o, int maxNObj, double &dist, int &nFound)
+{
+  Node &node(nodes[n]);
+  if(dist >= 0 && BoxDistance(x, node.bmin, node.bmax) > dist)
+    return true;
+
+  if(node.count>0) {
+    for(int i=node.first; i<node.first+node.count; i++) {
+      double locDist = ObjDistance(x, obj[i]);
+      if(dist >= 0 && locDist > dist)
+        continue;
+      if(dist < 0 || locDist < dist) {
+        nFound = 0;
+        dist = locDist;
+      }
+      if(nFound >= maxNObj)
+        return false;
+      o[nFound++] = obj[i];
+    }
+    return true;
+  }
+
+  // visit the closer child first, to tighten "dist" early
+  int first = n+1, second = node.right;
+  if(BoxDistance(x, nodes[second].bmin, nodes[second].bmax) < BoxDistance(x, nodes[first].bmin, nodes[first].bmax))
+    std::swap(first, second);
+  return FindClose(first, x, o, maxNObj, dist, nFound) &&
+         FindClose(second, x, o, maxNObj, dist, nFound);
+}
+
+//------------------------------------------------------------------------------
+
+#endif
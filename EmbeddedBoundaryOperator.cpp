@@ -4,6 +4,7 @@
  ************************************************************************/
 
 #include<EmbeddedBoundaryOperator.h>
+#include<Timer.h>
 #include<Vector5D.h>
 #include<CommunicationTools.h>
 #include<GeoTools.h>
@@ -1035,6 +1036,8 @@ EmbeddedBoundaryOperator::ComputeForces(SpaceVariable3D &V, SpaceVariable3D &ID)
 double
 EmbeddedBoundaryOperator::TrackSurfaces(int phi_layers)
 {
+  ScopedTimer scoped_timer("SurfaceTracking");
+
   assert(phi_layers>0);
 
   double max_dist = -DBL_MAX;
@@ -1081,6 +1084,8 @@ EmbeddedBoundaryOperator::TrackSurfaces(int phi_layers)
 double
 EmbeddedBoundaryOperator::TrackUpdatedSurfaces()
 {
+  ScopedTimer scoped_timer("SurfaceTracking");
+
   double max_dist = -DBL_MAX;
 
   int phi_layers = 3;
@@ -1091,7 +1096,9 @@ EmbeddedBoundaryOperator::TrackUpdatedSurfaces()
 
     surfaces[i].CalculateNormalsAndAreas();
 
-    double max_dist0 = intersector[i]->RecomputeFullCourse(surfaces_prev[i].X, phi_layers);
+    double max_dist0 = iod_embedded_surfaces[i]->tracking == EmbeddedSurfaceData::INCREMENTAL ?
+                       intersector[i]->RecomputeIncrementally(surfaces_prev[i].X, phi_layers) :
+                       intersector[i]->RecomputeFullCourse(surfaces_prev[i].X, phi_layers);
     if(max_dist0>max_dist)
       max_dist = max_dist0;
   }
@@ -1214,6 +1221,58 @@ EmbeddedBoundaryOperator::OutputResults(double time, double dt, int time_step, b
 
 //------------------------------------------------------------------------------------------------
 
+void
+EmbeddedBoundaryOperator::WriteRestartData(std::ostream &out)
+{
+  int nSurfaces = surfaces.size();
+  out.write(reinterpret_cast<const char*>(&nSurfaces), sizeof(int));
+  for(auto&& surface : surfaces) {
+    int nNodes = surface.X.size();
+    out.write(reinterpret_cast<const char*>(&nNodes), sizeof(int));
+    out.write(reinterpret_cast<const char*>(surface.X.data()), sizeof(Vec3D)*nNodes);
+    int nVel = surface.Udot.size(); //may be 0
+    out.write(reinterpret_cast<const char*>(&nVel), sizeof(int));
+    out.write(reinterpret_cast<const char*>(surface.Udot.data()), sizeof(Vec3D)*nVel);
+  }
+  for(auto&& lo : lagout)
+    lo.WriteRestartData(out);
+}
+
+//------------------------------------------------------------------------------------------------
+
+void
+EmbeddedBoundaryOperator::ReadRestartData(std::istream &in, double t0)
+{
+  int nSurfaces = 0;
+  in.read(reinterpret_cast<char*>(&nSurfaces), sizeof(int));
+  if(nSurfaces != (int)surfaces.size()) {
+    print_error(comm, "*** Error: Number of embedded surfaces in the restart files (%d) does not match "
+                "the input file (%d).\n", nSurfaces, (int)surfaces.size());
+    exit_mpi();
+  }
+
+  for(int i=0; i<nSurfaces; i++) {
+    int nNodes = 0, nVel = 0;
+    in.read(reinterpret_cast<char*>(&nNodes), sizeof(int));
+    if(nNodes != (int)surfaces[i].X.size()) {
+      print_error(comm, "*** Error: Embedded surface %d has %d nodes in the restart files, but %d in the "
+                  "mesh file.\n", i, nNodes, (int)surfaces[i].X.size());
+      exit_mpi();
+    }
+    in.read(reinterpret_cast<char*>(surfaces[i].X.data()), sizeof(Vec3D)*nNodes);
+    in.read(reinterpret_cast<char*>(&nVel), sizeof(int));
+    surfaces[i].Udot.resize(nVel);
+    in.read(reinterpret_cast<char*>(surfaces[i].Udot.data()), sizeof(Vec3D)*nVel);
+
+    surfaces[i].CalculateNormalsAndAreas();
+  }
+
+  for(auto&& lo : lagout)
+    lo.ReadRestartData(in, t0);
+}
+
+//------------------------------------------------------------------------------------------------
+
 void
 EmbeddedBoundaryOperator::ComputeForcesOnSurfaceDirectly(int surf, int np, Vec5D*** v, double*** id,
                                                          vector<Vec3D> &Fs, vector<Vec3D> &FAs)
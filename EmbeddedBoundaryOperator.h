@@ -118,6 +118,11 @@ public:
   //! Check if an embedded surface is likely a surface in 3D
   bool IsEmbeddedSurfaceIn3D(int surf);
 
+  //! Checkpoint/restart: nodal coordinates and velocities of the surfaces (topology is not stored), and
+  //! the state of the Lagrangian output. t0 is the time of the checkpoint.
+  void WriteRestartData(std::ostream &out);
+  void ReadRestartData(std::istream &in, double t0); //!< should be called before tracking the surfaces
+
 private:
 
   void ReadMeshFile(const char *filename, vector<Vec3D> &Xs, vector<Int3> &Es);
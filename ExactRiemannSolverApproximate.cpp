@@ -0,0 +1,112 @@
+/************************************************************************
+ * Copyright © 2020 The Multiphysics Modeling and Computation (M2C) Lab
+ * <kevin.wgy@gmail.com> <kevinw3@vt.edu>
+ ************************************************************************/
+
+#include<ExactRiemannSolverApproximate.h>
+#include<Timer.h>
+#include<Utils.h>
+#include<cmath>
+
+//-----------------------------------------------------
+
+ExactRiemannSolverApproximate::ExactRiemannSolverApproximate(std::vector<VarFcnBase*> &vf_,
+                                                             ExactRiemannSolverData &iod_riemann_,
+                                                             ExactRiemannSolverBase *solver_)
+                             : ExactRiemannSolverBase(vf_, iod_riemann_), solver(solver_),
+                               approximated(0), exact(0)
+{
+  threshold = iod_riemann.approximation_threshold;
+  if(threshold<=0.0) {
+    print_error("*** Error: The threshold of the approximate Riemann solver (%e) must be positive.\n",
+                threshold);
+    exit_mpi();
+  }
+}
+
+//-----------------------------------------------------
+
+ExactRiemannSolverApproximate::~ExactRiemannSolverApproximate()
+{
+  delete solver;
+}
+
+//-----------------------------------------------------
+
+int
+ExactRiemannSolverApproximate::ComputeRiemannSolution(double *dir, double *Vm, int idl, double *Vp, int idr,
+                                                      double *Vs, int &id, double *Vsm, double *Vsp,
+                                                      double curvature)
+{
+  // Convert to a 1D problem
+  double rhol = Vm[0];
+  double ul   = Vm[1]*dir[0] + Vm[2]*dir[1] + Vm[3]*dir[2];
+  double pl   = Vm[4];
+  double rhor = Vp[0];
+  double ur   = Vp[1]*dir[0] + Vp[2]*dir[1] + Vp[3]*dir[2];
+  double pr   = Vp[4];
+
+  double cl2 = rhol>0.0 ? vf[idl]->ComputeSoundSpeedSquare(rhol, vf[idl]->GetInternalEnergyPerUnitMass(rhol,pl))
+                        : -1.0;
+  double cr2 = rhor>0.0 ? vf[idr]->ComputeSoundSpeedSquare(rhor, vf[idr]->GetInternalEnergyPerUnitMass(rhor,pr))
+                        : -1.0;
+
+  if(cl2>0.0 && cr2>0.0) {
+
+    // acoustic approximation
+    double cl = sqrt(cl2), cr = sqrt(cr2);
+    double Zl = rhol*cl, Zr = rhor*cr;
+    double p2 = (Zr*pl + Zl*pr + Zl*Zr*(ul - ur))/(Zl + Zr);
+    double u2 = (Zl*ul + Zr*ur + pl - pr)/(Zl + Zr);
+
+    // error control: wave strength
+    double eps = std::max(fabs(p2 - pl)/(rhol*cl2), fabs(p2 - pr)/(rhor*cr2));
+
+    if(eps <= threshold) { //also false if p2 is not a number
+
+      double rhol2 = rhol + (p2 - pl)/cl2;
+      double rhor2 = rhor + (p2 - pr)/cr2;
+      double cl2s = rhol2>0.0 ? vf[idl]->ComputeSoundSpeedSquare(rhol2,
+                                  vf[idl]->GetInternalEnergyPerUnitMass(rhol2,p2)) : -1.0;
+      double cr2s = rhor2>0.0 ? vf[idr]->ComputeSoundSpeedSquare(rhor2,
+                                  vf[idr]->GetInternalEnergyPerUnitMass(rhor2,p2)) : -1.0;
+
+      if(cl2s>0.0 && cr2s>0.0) {
+        // transonic rarefaction: head and tail on different sides of x = 0
+        bool trans_rare = (pl>p2 && (ul - cl)*(u2 - sqrt(cl2s))<0.0) ||
+                          (pr>p2 && (ur + cr)*(u2 + sqrt(cr2s))<0.0);
+        if(!trans_rare) {
+          double Vrare_x0[3] = {0.0, 0.0, 0.0}; //not used
+          FinalizeSolution(dir, Vm, Vp, rhol, ul, pl, idl, rhor, ur, pr, idr, rhol2, rhor2, u2, p2,
+                           false, Vrare_x0, Vs, id, Vsm, Vsp);
+          approximated++;
+          last_iters = 0;
+          return 0;
+        }
+      }
+    }
+  }
+
+  exact++;
+  int err = solver->ComputeRiemannSolution(dir, Vm, idl, Vp, idr, Vs, id, Vsm, Vsp, curvature);
+  last_iters = solver->GetNumberOfIterations();
+  return err;
+}
+
+//-----------------------------------------------------
+
+void
+ExactRiemannSolverApproximate::ReportStatistics(MPI_Comm &comm)
+{
+  long long counts[2] = {approximated, exact};
+  MPI_Allreduce(MPI_IN_PLACE, counts, 2, MPI_LONG_LONG, MPI_SUM, comm);
+
+  double rate = counts[0]+counts[1]>0 ? 100.0*counts[0]/(counts[0]+counts[1]) : 0.0;
+  print(comm, "- Approximate Riemann solver: %lld approximated (%.1f%%), %lld solved exactly.\n",
+        counts[0], rate, counts[1]);
+
+  m2c_timer.AddCount("RiemannApproximated", approximated);
+  m2c_timer.AddCount("RiemannSolvedExactly", exact);
+}
+
+//-----------------------------------------------------
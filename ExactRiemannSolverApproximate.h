@@ -0,0 +1,62 @@
+/************************************************************************
+ * Copyright © 2020 The Multiphysics Modeling and Computation (M2C) Lab
+ * <kevin.wgy@gmail.com> <kevinw3@vt.edu>
+ ************************************************************************/
+
+#ifndef _EXACT_RIEMANN_SOLVER_APPROXIMATE_H_
+#define _EXACT_RIEMANN_SOLVER_APPROXIMATE_H_
+
+#include <ExactRiemannSolverBase.h>
+#include <mpi.h>
+
+/*****************************************************************************************
+ * ExactRiemannSolverApproximate wraps an exact Riemann solver (which it owns). For two-sided
+ * Riemann problems, it first tries the acoustic (i.e. linearized) approximation:
+ *   p* = (Zr*pl + Zl*pr + Zl*Zr*(ul-ur))/(Zl+Zr),  u* = (Zl*ul + Zr*ur + pl - pr)/(Zl+Zr),
+ *   rhoK* = rhoK + (p* - pK)/cK^2  (K = l,r),  where Z = rho*c is the acoustic impedance.
+ * The error of this approximation is O(eps^2), where eps = max_K |p* - pK|/(rhoK*cK^2) is the
+ * strength of the waves. The exact solver is called if eps exceeds the threshold specified
+ * by the user (ExactRiemannSolverData::approximation_threshold), if a star state is not
+ * physical (rho <= 0 or c^2 <= 0), or if there is a transonic rarefaction.
+ * One-sided Riemann problems are passed to the wrapped solver directly.
+ *****************************************************************************************/
+
+class ExactRiemannSolverApproximate : public ExactRiemannSolverBase {
+
+  ExactRiemannSolverBase *solver; //!< the exact solver
+
+  double threshold; //!< max. wave strength for the approximation
+
+  //! statistics
+  long long approximated, exact;
+
+public:
+
+  ExactRiemannSolverApproximate(std::vector<VarFcnBase*> &vf_, ExactRiemannSolverData &iod_riemann_,
+                                ExactRiemannSolverBase *solver_);
+  ~ExactRiemannSolverApproximate();
+
+  double GetSurfaceTensionCoefficient() {return solver->GetSurfaceTensionCoefficient();}
+
+  int ComputeRiemannSolution(double *dir/*unit normal*/, double *Vm, int idm /*"left" state*/,
+                             double *Vp, int idp /*"right" state*/,
+                             double *Vs, int &id /*solution at xi = 0 (i.e. x=0) */,
+                             double *Vsm /*left 'star' solution*/,
+                             double *Vsp /*right 'star' solution*/,
+                             double curvature = 0.0);
+
+  void PrintStarRelations(double rhol, double ul, double pl, int idl,
+                          double rhor, double ur, double pr, int idr,
+                          double pmin, double pmax, double dp) {
+    solver->PrintStarRelations(rhol, ul, pl, idl, rhor, ur, pr, idr, pmin, pmax, dp);}
+
+  int ComputeOneSidedRiemannSolution(double *dir, double *Vm, int idm, double *Ustar,
+                                     double *Vs, int &id, double *Vsm) {
+    return solver->ComputeOneSidedRiemannSolution(dir, Vm, idm, Ustar, Vs, id, Vsm);}
+
+  //! Collective. Prints the fraction of approximated solutions and adds the counters to m2c_timer
+  void ReportStatistics(MPI_Comm &comm);
+
+};
+
+#endif
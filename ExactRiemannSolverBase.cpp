@@ -4,6 +4,7 @@
  ************************************************************************/
 
 #include<ExactRiemannSolverBase.h>
+#include<Timer.h>
 #include<array>
 #include<utility> //std::pair
 #include<bits/stdc++.h> //std::swap
@@ -45,8 +46,7 @@ ExactRiemannSolverBase::ExactRiemannSolverBase(std::vector<VarFcnBase*> &vf_,
   failure_threshold    = iod_riemann.failure_threshold;
   pressure_at_failure  = iod_riemann.pressure_at_failure;
   surface_tension      = iod_riemann.surface_tension == ExactRiemannSolverData::YES;
-  integrationPath1.reserve(500);
-  integrationPath3.reserve(500);
+  last_iters           = 0;
 }
 
 //-----------------------------------------------------
@@ -65,6 +65,8 @@ ExactRiemannSolverBase::ComputeRiemannSolution(double *dir,
     double *Vsp /*right 'star' solution*/,
     double curvature)
 {
+  ScopedTimer scoped_timer("RiemannSolve");
+
   assert(curvature == 0.0); //the base class does not handle curvature!
 
   //std::cout << "ExactRiemannSolverBase::ComputeRiemannSolution: this is the base version!" << std::endl;
@@ -77,12 +79,11 @@ ExactRiemannSolverBase::ComputeRiemannSolution(double *dir,
   double pr    = Vp[4];
   //fprintf(stdout,"1DRiemann: left = %e %e %e (%d) : right = %e %e %e (%d)\n", rhol, ul, pl, idl, rhor, ur, pr, idr);
 
+  last_iters = 0;
   integrationPath1.clear();
   integrationPath3.clear();
-  std::vector<double> vectL{pl, rhol, ul};
-  std::vector<double> vectR{pr, rhor, ur};
-  integrationPath1.push_back(vectL);
-  integrationPath3.push_back(vectR); 
+  integrationPath1.push_back(pl, rhol, ul);
+  integrationPath3.push_back(pr, rhor, ur);
 
 #if PRINT_RIEMANN_SOLUTION == 1
   std::cout << "Left State (rho, u, p): " << rhol << ", " << ul << ", " << pl << "." << std::endl;
@@ -311,6 +312,8 @@ try_again:
   }
 
 
+  last_iters = iter;
+
   // -------------------------------
   // Step 3: Find state at xi = x = 0 (for output)
   // -------------------------------
@@ -331,6 +334,7 @@ try_again:
 
     ExactRiemannSolverNonAdaptive riemannNonAdaptive(vf, iod_riemann);
     int retryRiemann = riemannNonAdaptive.ComputeRiemannSolution(dir, Vm, idl, Vp, idr, Vs, id, Vsm, Vsp);
+    last_iters += riemannNonAdaptive.GetNumberOfIterations();
     if(verbose>=1)
       cout << "Warning: Exact Riemann solver (adaptive) failed to converge. Activated the non-adaptive version." << endl;
     return retryRiemann;
@@ -368,15 +372,13 @@ ExactRiemannSolverBase::FinalizeSolution(double *dir, double *Vm, double *Vp,
 
 #if PRINT_RIEMANN_SOLUTION == 1
   // the 2-wave
-  sol1d.push_back(vector<double>{u2 - std::max(1e-6, 0.001*fabs(u2)), rhol2, u2, p2, (double)idl});
-  sol1d.push_back(vector<double>{u2, rhor2, u2, p2, (double)idr});
+  sol1d.push_back(std::array<double,5>{u2 - std::max(1e-6, 0.001*fabs(u2)), rhol2, u2, p2, (double)idl});
+  sol1d.push_back(std::array<double,5>{u2, rhor2, u2, p2, (double)idr});
   // 1- and 3- waves
   integrationPath1.clear();
   integrationPath3.clear();
-  std::vector<double> vectL{pl, rhol, ul};
-  std::vector<double> vectR{pr, rhor, ur};
-  integrationPath1.push_back(vectL);
-  integrationPath3.push_back(vectR); 
+  integrationPath1.push_back(pl, rhol, ul);
+  integrationPath3.push_back(pr, rhor, ur);
  
   bool success;
   double ul2_tmp, ur2_tmp, rhol2_tmp, rhor2_tmp;
@@ -522,12 +524,12 @@ ExactRiemannSolverBase::FinalizeSolution(double *dir, double *Vm, double *Vp,
 
 #if PRINT_RIEMANN_SOLUTION == 1
   std::sort(sol1d.begin(), sol1d.end(), 
-      [](vector<double> v1, vector<double> v2){return v1[0]<v2[0];});
+      [](const std::array<double,5> &v1, const std::array<double,5> &v2){return v1[0]<v2[0];});
   int last = sol1d.size()-1;
   double xi_span = sol1d[last][0] - sol1d[0][0];
-  sol1d.insert(sol1d.begin(), vector<double>{sol1d[0][0]-xi_span, sol1d[0][1], sol1d[0][2], sol1d[0][3], sol1d[0][4]});
+  sol1d.insert(sol1d.begin(), std::array<double,5>{sol1d[0][0]-xi_span, sol1d[0][1], sol1d[0][2], sol1d[0][3], sol1d[0][4]});
   last++;
-  sol1d.push_back(vector<double>{sol1d[last][0]+xi_span, sol1d[last][1], sol1d[last][2], sol1d[last][3], sol1d[last][4]});
+  sol1d.push_back(std::array<double,5>{sol1d[last][0]+xi_span, sol1d[last][1], sol1d[last][2], sol1d[last][3], sol1d[last][4]});
 
   FILE* solFile = fopen("RiemannSolution.txt", "w");
   print(solFile, "## One-Dimensional Riemann Problem.\n");
@@ -564,7 +566,7 @@ ExactRiemannSolverBase::FinalizeOneSidedSolution(double *dir, double *Vm,
 
 #if PRINT_RIEMANN_SOLUTION == 1
   // the 2-wave
-  sol1d.push_back(vector<double>{u2, rhol2, u2, p2, (double)idl});
+  sol1d.push_back(std::array<double,5>{u2, rhol2, u2, p2, (double)idl});
 #endif
 
   if(id != INVALID_MATERIAL_ID) {
@@ -635,10 +637,10 @@ ExactRiemannSolverBase::FinalizeOneSidedSolution(double *dir, double *Vm,
 
 #if PRINT_RIEMANN_SOLUTION == 1
   std::sort(sol1d.begin(), sol1d.end(), 
-      [](vector<double> v1, vector<double> v2){return v1[0]<v2[0];});
+      [](const std::array<double,5> &v1, const std::array<double,5> &v2){return v1[0]<v2[0];});
   int last = sol1d.size()-1;
   double xi_span = sol1d[last][0] - sol1d[0][0];
-  sol1d.insert(sol1d.begin(), vector<double>{sol1d[0][0]-xi_span, sol1d[0][1], sol1d[0][2], sol1d[0][3], sol1d[0][4]});
+  sol1d.insert(sol1d.begin(), std::array<double,5>{sol1d[0][0]-xi_span, sol1d[0][1], sol1d[0][2], sol1d[0][3], sol1d[0][4]});
 
   FILE* solFile = fopen("RiemannSolution.txt", "w");
   print(solFile, "## One-Dimensional Riemann Problem.\n");
@@ -1198,7 +1200,7 @@ ExactRiemannSolverBase::FindInitialFeasiblePointsOneSidedByAcousticTheory(double
 //! Connect the left/right initial state with the left/right star state (the 1-wave or 3-wave)
   bool  //true: success  | false: failure
 ExactRiemannSolverBase::ComputeRhoUStar(int wavenumber /*1 or 3*/,
-    std::vector<std::vector<double>>& integrationPath /*3 by n, first index: 1-pressure, 2-density, 3-velocity*/,
+    RiemannIntegrationPath& integrationPath /*points (p, rho, u) on the path*/,
     double rho, double u, double p, double ps, int id/*inputs*/,
     double rhos0, double rhos1/*initial guesses for Hugo. eq.*/,
     double &rhos, double &us/*outputs*/, 
@@ -1231,19 +1233,19 @@ ExactRiemannSolverBase::ComputeRhoUStar(int wavenumber /*1 or 3*/,
     // find the new starting point, and update dp accordingly
     if (integrationPath.size() > 1) { 
       for (int j = integrationPath.size()-1; j >= 0; j--) {
-	if (integrationPath[j][0] > ps) {
+	if (integrationPath.p(j) > ps) {
 	  index0 = j;
 	  break;
 	}
       }
-      ps_0 = integrationPath[index0][0];
-      rhos_0 = integrationPath[index0][1];
-      us_0 = integrationPath[index0][2];
+      ps_0 = integrationPath.p(index0);
+      rhos_0 = integrationPath.rho(index0);
+      us_0 = integrationPath.u(index0);
       dp_min_adaption = (ps_0 - ps) / numSteps_rarefaction / 2.5;
       if (index0 != (int)integrationPath.size()-1) { // new starting point is not the last on the trajectory
 	dp = ps_0-ps; 
       } else { // dp from the last step 
-	dp = std::min( integrationPath[index0-1][0]-integrationPath[index0][0], ps_0-ps );
+	dp = std::min( integrationPath.p(index0-1)-integrationPath.p(index0), ps_0-ps );
 	// dp = ps_0-ps;
       }
     }
@@ -1252,7 +1254,7 @@ ExactRiemannSolverBase::ComputeRhoUStar(int wavenumber /*1 or 3*/,
     xi_0 = xi;
 
 #if PRINT_RIEMANN_SOLUTION == 1
-    sol1d.push_back(vector<double>{xi, rho, u, p, (double)id});
+    sol1d.push_back(std::array<double,5>{xi, rho, u, p, (double)id});
 #endif
 
     //fprintf(stdout,"rho = %e, p = %e, ps = %e\n", rho, p, ps);
@@ -1311,13 +1313,13 @@ ExactRiemannSolverBase::ComputeRhoUStar(int wavenumber /*1 or 3*/,
       double uErrScaled = uErr / c + tiny;
       double rhoErrScaled = rhoErr / rho + tiny;
       if (isnan(rhoErrScaled)) {
-	fprintf(stdout,"Warning: rhoErrScaled is nan. id = %d, p = %e, ps = %e, dp = %e, ps_0 = %e, ps_1 = %e, uErr = %e, uErrScaled = %e, rhos_0 = %e, rhos_1 = %e, rhoErr = %e, rhoErrScaled = %e, c = %e, rho = %e, path size = %ld.\n",
+	fprintf(stdout,"Warning: rhoErrScaled is nan. id = %d, p = %e, ps = %e, dp = %e, ps_0 = %e, ps_1 = %e, uErr = %e, uErrScaled = %e, rhos_0 = %e, rhos_1 = %e, rhoErr = %e, rhoErrScaled = %e, c = %e, rho = %e, path size = %d.\n",
 	    id, p, ps, dp, ps_0, ps_1, uErr, uErrScaled, rhos_0, rhos_1, rhoErr, rhoErrScaled, c, rho, integrationPath.size());
 	exit(-1);
       }  
 
       if (isnan(uErrScaled)) {
-	fprintf(stdout,"Warning: uErrScaled is nan. id = %d, p = %e, ps = %e, dp = %e, ps_0 = %e, ps_1 = %e, uErr = %e, uErrScaled = %e, rhoErr = %e, rhoErrScaled = %e, c = %e, rho = %e, path size = %ld.\n",
+	fprintf(stdout,"Warning: uErrScaled is nan. id = %d, p = %e, ps = %e, dp = %e, ps_0 = %e, ps_1 = %e, uErr = %e, uErrScaled = %e, rhoErr = %e, rhoErrScaled = %e, c = %e, rho = %e, path size = %d.\n",
 	    id, p, ps, dp, ps_0, ps_1, uErr, uErrScaled, rhoErr, rhoErrScaled, c, rho, integrationPath.size());
 	exit(-1);
       }  
@@ -1339,13 +1341,12 @@ ExactRiemannSolverBase::ComputeRhoUStar(int wavenumber /*1 or 3*/,
 	continue;
       }
 
-      if (ps_1 < integrationPath[integrationPath.size()-1][0]) { // store the new point if necessary
-	std::vector<double> currentVect = {ps_1, rhos_1, us_1};
-	integrationPath.push_back(currentVect);
+      if (ps_1 < integrationPath.p(integrationPath.size()-1)) { // store the new point if necessary
+	integrationPath.push_back(ps_1, rhos_1, us_1);
       }
 
 #if PRINT_RIEMANN_SOLUTION == 1
-      sol1d.push_back(vector<double>{xi_1, rhos_1, us_1, ps_1, (double)id});
+      sol1d.push_back(std::array<double,5>{xi_1, rhos_1, us_1, ps_1, (double)id});
 #endif
 
       if(trans_rare && Vrare_x0 && xi_0*xi_1<=0) {//transonic rarefaction, crossing x = xi = 0
@@ -1359,7 +1360,7 @@ ExactRiemannSolverBase::ComputeRhoUStar(int wavenumber /*1 or 3*/,
 	Vrare_x0[2] = w0*ps_0   + w1*ps_1;
 
 #if PRINT_RIEMANN_SOLUTION == 1
-	sol1d.push_back(vector<double>{0.0, Vrare_x0[0], Vrare_x0[1], Vrare_x0[2], (double)id});
+	sol1d.push_back(std::array<double,5>{0.0, Vrare_x0[0], Vrare_x0[1], Vrare_x0[2], (double)id});
 #endif
 
       }
@@ -1597,11 +1598,11 @@ ExactRiemannSolverBase::ComputeRhoUStar(int wavenumber /*1 or 3*/,
 #if PRINT_RIEMANN_SOLUTION == 1
     double xi = (rhos*us - rho*u)/(rhos-rho);
     if(wavenumber==1) {
-      sol1d.push_back(vector<double>{xi-0.0001*fabs(xi), rho, u, p, (double)id});
-      sol1d.push_back(vector<double>{xi, rhos, us, ps, (double)id});
+      sol1d.push_back(std::array<double,5>{xi-0.0001*fabs(xi), rho, u, p, (double)id});
+      sol1d.push_back(std::array<double,5>{xi, rhos, us, ps, (double)id});
     } else {
-      sol1d.push_back(vector<double>{xi, rhos, us, ps, (double)id});
-      sol1d.push_back(vector<double>{xi+0.0001*fabs(xi), rho, u, p, (double)id});
+      sol1d.push_back(std::array<double,5>{xi, rhos, us, ps, (double)id});
+      sol1d.push_back(std::array<double,5>{xi+0.0001*fabs(xi), rho, u, p, (double)id});
     }
 #endif
 
@@ -1647,7 +1648,7 @@ ExactRiemannSolverBase::ComputeOneSidedRarefaction(double rho, double u, double
   xi_0 = xi;
 
 #if PRINT_RIEMANN_SOLUTION == 1
-  sol1d.push_back(vector<double>{xi, rho, u, p, (double)id});
+  sol1d.push_back(std::array<double,5>{xi, rho, u, p, (double)id});
 #endif
 
   // integration by Runge-Kutta 4
@@ -1682,7 +1683,7 @@ ExactRiemannSolverBase::ComputeOneSidedRarefaction(double rho, double u, double
     } 
 
 #if PRINT_RIEMANN_SOLUTION == 1
-    sol1d.push_back(vector<double>{xi_1, rhos_1, us_1, ps_1, (double)id});
+    sol1d.push_back(std::array<double,5>{xi_1, rhos_1, us_1, ps_1, (double)id});
 #endif
 
     if(trans_rare && Vrare_x0 && xi_0*xi_1<=0) {//transonic rarefaction, crossing x = xi = 0
@@ -1696,7 +1697,7 @@ ExactRiemannSolverBase::ComputeOneSidedRarefaction(double rho, double u, double
       Vrare_x0[2] = w0*ps_0   + w1*ps_1;
 
 #if PRINT_RIEMANN_SOLUTION == 1
-      sol1d.push_back(vector<double>{0.0, Vrare_x0[0], Vrare_x0[1], Vrare_x0[2], (double)id});
+      sol1d.push_back(std::array<double,5>{0.0, Vrare_x0[0], Vrare_x0[1], Vrare_x0[2], (double)id});
 #endif
 
     }
@@ -1965,6 +1966,8 @@ ExactRiemannSolverBase::ComputeOneSidedRiemannSolution(double *dir/*unit normal
     double *Vs, int &id, /*solution at xi = 0 (i.e. x=0), id = -1 if invalid*/
     double *Vsm /*left 'star' solution*/)
 {
+  ScopedTimer scoped_timer("OneSidedRiemannSolve");
+
 
   // Convert to a 1D problem (i.e. One-Dimensional Riemann)
   double rhol  = Vm[0];
@@ -1984,8 +1987,7 @@ ExactRiemannSolverBase::ComputeOneSidedRiemannSolution(double *dir/*unit normal
     cl = sqrt(cl);
 
   integrationPath1.clear();
-  std::vector<double> vectL{pl, rhol, ul};
-  integrationPath1.push_back(vectL);
+  integrationPath1.push_back(pl, rhol, ul);
 
 
   // Declare variables in the "star region"
@@ -2246,12 +2248,11 @@ ExactRiemannSolverNonAdaptive::ComputeRiemannSolution(double *dir,
   double pr    = Vp[4];
   //fprintf(stdout,"1DRiemann: left = %e %e %e (%d) : right = %e %e %e (%d)\n", rhol, ul, pl, idl, rhor, ur, pr, idr);
 
+  last_iters = 0;
   integrationPath1.clear();
   integrationPath3.clear();
-  std::vector<double> vectL{pl, rhol, ul};
-  std::vector<double> vectR{pr, rhor, ur};
-  integrationPath1.push_back(vectL);
-  integrationPath3.push_back(vectR); 
+  integrationPath1.push_back(pl, rhol, ul);
+  integrationPath3.push_back(pr, rhor, ur);
 
 #if PRINT_RIEMANN_SOLUTION == 1
   std::cout << "Left State (rho, u, p): " << rhol << ", " << ul << ", " << pl << "." << std::endl;
@@ -2472,6 +2473,8 @@ try_again:
   }
 
 
+  last_iters = iter;
+
   // -------------------------------
   // Step 3: Find state at xi = x = 0 (for output)
   // -------------------------------
@@ -2508,7 +2511,7 @@ try_again:
 //! non-adptive version, Connect the left/right initial state with the left/right star state (the 1-wave or 3-wave)
   bool  //true: success  | false: failure
 ExactRiemannSolverNonAdaptive::ComputeRhoUStar(int wavenumber /*1 or 3*/,
-    std::vector<std::vector<double>>& integrationPath /*3 by n, first index: 1-pressure, 2-density, 3-velocity*/, double rho, double u, double p, double ps, int id/*inputs*/,
+    RiemannIntegrationPath& integrationPath /*points (p, rho, u) on the path*/, double rho, double u, double p, double ps, int id/*inputs*/,
     double rhos0, double rhos1/*initial guesses for Hugo. eq.*/,
     double &rhos, double &us/*outputs*/, 
     bool *trans_rare, double *Vrare_x0/*filled only if found tran rf*/)
@@ -2552,14 +2555,14 @@ ExactRiemannSolverNonAdaptive::ComputeRhoUStar(int wavenumber /*1 or 3*/,
     int index0 = 0;
     if (integrationPath.size() > 1) {
       for (int j = integrationPath.size()-1; j >= 0; j--) {
-	if (integrationPath[j][0] > ps) {
+	if (integrationPath.p(j) > ps) {
 	  index0 = j;
 	  break;
 	}
       }
-      ps_0 = integrationPath[index0][0];
-      rhos_0 = integrationPath[index0][1];
-      us_0 = integrationPath[index0][2];
+      ps_0 = integrationPath.p(index0);
+      rhos_0 = integrationPath.rho(index0);
+      us_0 = integrationPath.u(index0);
       dp = std::min( (p-ps)/numSteps_rarefaction, ps_0 - ps );
     }
 
@@ -2567,7 +2570,7 @@ ExactRiemannSolverNonAdaptive::ComputeRhoUStar(int wavenumber /*1 or 3*/,
     xi_0 = xi;
 
 #if PRINT_RIEMANN_SOLUTION == 1
-    sol1d.push_back(vector<double>{xi, rho, u, p, (double)id});
+    sol1d.push_back(std::array<double,5>{xi, rho, u, p, (double)id});
 #endif
 
     //fprintf(stdout,"rho = %e, p = %e, ps = %e\n", rho, p, ps);
@@ -2618,13 +2621,12 @@ ExactRiemannSolverNonAdaptive::ComputeRhoUStar(int wavenumber /*1 or 3*/,
 	continue;
       }
 
-      if (ps_1 < integrationPath[integrationPath.size()-1][0]) {
-	std::vector<double> currentVect = {ps_1, rhos_1, us_1};
-	integrationPath.push_back(currentVect);
+      if (ps_1 < integrationPath.p(integrationPath.size()-1)) {
+	integrationPath.push_back(ps_1, rhos_1, us_1);
       }  
 
 #if PRINT_RIEMANN_SOLUTION == 1
-      sol1d.push_back(vector<double>{xi_1, rhos_1, us_1, ps_1, (double)id});
+      sol1d.push_back(std::array<double,5>{xi_1, rhos_1, us_1, ps_1, (double)id});
 #endif
 
       if(trans_rare && Vrare_x0 && xi_0*xi_1<=0) {//transonic rarefaction, crossing x = xi = 0
@@ -2638,7 +2640,7 @@ ExactRiemannSolverNonAdaptive::ComputeRhoUStar(int wavenumber /*1 or 3*/,
 	Vrare_x0[2] = w0*ps_0   + w1*ps_1;
 
 #if PRINT_RIEMANN_SOLUTION == 1
-	sol1d.push_back(vector<double>{0.0, Vrare_x0[0], Vrare_x0[1], Vrare_x0[2], (double)id});
+	sol1d.push_back(std::array<double,5>{0.0, Vrare_x0[0], Vrare_x0[1], Vrare_x0[2], (double)id});
 #endif
 
       }
@@ -2866,11 +2868,11 @@ ExactRiemannSolverNonAdaptive::ComputeRhoUStar(int wavenumber /*1 or 3*/,
 #if PRINT_RIEMANN_SOLUTION == 1
     double xi = (rhos*us - rho*u)/(rhos-rho);
     if(wavenumber==1) {
-      sol1d.push_back(vector<double>{xi-0.0001*fabs(xi), rho, u, p, (double)id});
-      sol1d.push_back(vector<double>{xi, rhos, us, ps, (double)id});
+      sol1d.push_back(std::array<double,5>{xi-0.0001*fabs(xi), rho, u, p, (double)id});
+      sol1d.push_back(std::array<double,5>{xi, rhos, us, ps, (double)id});
     } else {
-      sol1d.push_back(vector<double>{xi, rhos, us, ps, (double)id});
-      sol1d.push_back(vector<double>{xi+0.0001*fabs(xi), rho, u, p, (double)id});
+      sol1d.push_back(std::array<double,5>{xi, rhos, us, ps, (double)id});
+      sol1d.push_back(std::array<double,5>{xi+0.0001*fabs(xi), rho, u, p, (double)id});
     }
 #endif
 
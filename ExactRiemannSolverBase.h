@@ -8,6 +8,43 @@
 
 #include <VarFcnBase.h>
 #include <vector>
+#include <array>
+#include <algorithm>
+
+/*****************************************************************************************
+ * Points (p, rho, u) on the integration path of a rarefaction wave, stored as arrays that
+ * are allocated once (per solver) and reused by all the Riemann solves. (The path is reused
+ * within a solve, as the star pressure is updated.) The arrays are enlarged only if a path
+ * has more points than ever before, so a Riemann solve normally does no heap allocation.
+ *****************************************************************************************/
+class RiemannIntegrationPath {
+
+  std::vector<double> pbuf, rhobuf, ubuf;
+  int n; //!< number of points
+
+public:
+
+  RiemannIntegrationPath(int capacity = 500) : pbuf(capacity), rhobuf(capacity), ubuf(capacity), n(0) {}
+  ~RiemannIntegrationPath() {}
+
+  inline int size() const {return n;}
+  inline void clear() {n = 0;}
+
+  inline void push_back(double p_, double rho_, double u_) {
+    if(n == (int)pbuf.size()) {
+      int capacity = std::max(2*n, 16);
+      pbuf.resize(capacity);  rhobuf.resize(capacity);  ubuf.resize(capacity);
+    }
+    pbuf[n] = p_;  rhobuf[n] = rho_;  ubuf[n] = u_;
+    n++;
+  }
+
+  inline double p(int j) const {return pbuf[j];}
+  inline double rho(int j) const {return rhobuf[j];}
+  inline double u(int j) const {return ubuf[j];}
+
+};
+
 
 /*****************************************************************************************
  * Base class for solving one-dimensional, single- or two-material Riemann problems
@@ -26,11 +63,13 @@ protected:
   double tol_shock;
   double tol_rarefaction; // non-dimensional, for rarefaction end points
   double min_pressure, failure_threshold, pressure_at_failure;
-  std::vector<std::vector<double> > integrationPath1; // first index: 1-pressure, 2-density, 3-velocity
-  std::vector<std::vector<double> > integrationPath3;
+  RiemannIntegrationPath integrationPath1; //!< 1-wave
+  RiemannIntegrationPath integrationPath3; //!< 3-wave
 
   bool surface_tension; // an indicator of whether consider surface tension
 
+  int last_iters; //!< number of iterations of the main loop in the latest (two-sided) solve
+
 public:
 
   ExactRiemannSolverBase(std::vector<VarFcnBase*> &vf_, ExactRiemannSolverData &iod_riemann_);
@@ -39,6 +78,9 @@ public:
 
   virtual double GetSurfaceTensionCoefficient();
 
+  //! for performance analysis (e.g., the micro-benchmark)
+  virtual int GetNumberOfIterations() {return last_iters;}
+
   virtual int ComputeRiemannSolution(double *dir/*unit normal*/, double *Vm, int idm /*"left" state*/, 
                                      double *Vp, int idp /*"right" state*/,
                                      double *Vs, int &id /*solution at xi = 0 (i.e. x=0) */,
@@ -57,7 +99,7 @@ public:
                                              double *Vsm /*left 'star' solution*/);
 
 #if PRINT_RIEMANN_SOLUTION == 1
-  vector<vector<double> > sol1d;
+  vector<std::array<double,5> > sol1d; //!< xi, rho, u, p, id
 #endif
 
 protected: //internal functions
@@ -98,7 +140,7 @@ protected: //internal functions
            double &p1, double &rhol1, double &rhor1, double &ul1, double &ur1/*outputs*/);
 
   virtual bool ComputeRhoUStar(int wavenumber /*1 or 3*/,
-		   std::vector<std::vector<double>>& integrationPath /*3 by n, first index: 1-pressure, 2-density, 3-velocity*/,
+		   RiemannIntegrationPath& integrationPath /*points (p, rho, u) on the path*/,
                    double rho, double u, double p, double ps, int id/*inputs*/,
                    double rhos0, double rhos1/*initial guesses for Hugo. eq.*/,
                    double &rhos, double &us/*outputs*/,
@@ -166,7 +208,7 @@ public:
 
 protected:
   bool ComputeRhoUStar(int wavenumber /*1 or 3*/,
-		   std::vector<std::vector<double>>& integrationPath /*3 by n, first index: 1-pressure, 2-density, 3-velocity*/,
+		   RiemannIntegrationPath& integrationPath /*points (p, rho, u) on the path*/,
                    double rho, double u, double p, double ps, int id/*inputs*/,
                    double rhos0, double rhos1/*initial guesses for Hugo. eq.*/,
                    double &rhos, double &us/*outputs*/,
@@ -0,0 +1,155 @@
+/************************************************************************
+ * Copyright © 2020 The Multiphysics Modeling and Computation (M2C) Lab
+ * <kevin.wgy@gmail.com> <kevinw3@vt.edu>
+ ************************************************************************/
+
+#include<ExactRiemannSolverCached.h>
+#include<Timer.h>
+#include<Utils.h>
+#include<cmath>
+#include<cassert>
+
+//-----------------------------------------------------
+
+ExactRiemannSolverCached::ExactRiemannSolverCached(std::vector<VarFcnBase*> &vf_,
+                                                   ExactRiemannSolverData &iod_riemann_,
+                                                   ExactRiemannSolverBase *solver_)
+                        : ExactRiemannSolverBase(vf_, iod_riemann_), solver(solver_),
+                          hits(0), misses(0), evictions(0), last_hit(false)
+{
+  tol = iod_riemann.cache_tolerance;
+  if(tol<1.0e-12 || tol>=1.0) {
+    print_error("*** Error: The tolerance of the Riemann solution cache (%e) must be in [1e-12, 1).\n", tol);
+    exit_mpi();
+  }
+  inv_tol = 1.0/tol;
+
+  max_size = iod_riemann.cache_size;
+  if(max_size<=0) {
+    print_error("*** Error: The size of the Riemann solution cache (%d) must be positive.\n", max_size);
+    exit_mpi();
+  }
+  cache.reserve(std::min(max_size, 65536));
+}
+
+//-----------------------------------------------------
+
+ExactRiemannSolverCached::~ExactRiemannSolverCached()
+{
+  delete solver;
+}
+
+//-----------------------------------------------------
+
+int
+ExactRiemannSolverCached::ComputeRiemannSolution(double *dir, double *Vm, int idm, double *Vp, int idp,
+                                                 double *Vs, int &id, double *Vsm, double *Vsp,
+                                                 double curvature)
+{
+  // unusual inputs are not cached
+  bool cacheable = Vm[0]>0.0 && Vp[0]>0.0 && std::isfinite(curvature);
+  for(int i=0; i<5; i++)
+    cacheable = cacheable && std::isfinite(Vm[i]) && std::isfinite(Vp[i]);
+  last_hit = false;
+  if(!cacheable)
+    return solver->ComputeRiemannSolution(dir, Vm, idm, Vp, idp, Vs, id, Vsm, Vsp, curvature);
+
+  Key key;
+  for(int i=0; i<3; i++)
+    key[i] = QuantizeAbsolute(dir[i], 1.0);
+  QuantizeState(Vm, &key[3]);
+  QuantizeState(Vp, &key[8]);
+  key[13] = QuantizeRelative(curvature);
+  key[14] = ((long long)idm<<32) | (long long)(unsigned int)idp;
+
+  auto it = cache.find(key);
+  if(it != cache.end()) {
+    hits++;
+    last_hit = true;
+    Solution &sol(it->second);
+    for(int i=0; i<5; i++) {
+      Vs[i]  = sol.Vs[i];
+      Vsm[i] = sol.Vsm[i];
+      Vsp[i] = sol.Vsp[i];
+    }
+    id = sol.id;
+    return 0;
+  }
+
+  misses++;
+  int err = solver->ComputeRiemannSolution(dir, Vm, idm, Vp, idp, Vs, id, Vsm, Vsp, curvature);
+  if(err)
+    return err; //failed solutions are not stored
+
+  if((int)cache.size() >= max_size) {
+    evictions += cache.size();
+    cache.clear();
+  }
+
+  Solution &sol(cache[key]);
+  for(int i=0; i<5; i++) {
+    sol.Vs[i]  = Vs[i];
+    sol.Vsm[i] = Vsm[i];
+    sol.Vsp[i] = Vsp[i];
+  }
+  sol.id = id;
+
+  return 0;
+}
+
+//-----------------------------------------------------
+
+void
+ExactRiemannSolverCached::ReportStatistics(MPI_Comm &comm)
+{
+  long long counts[3] = {hits, misses, evictions};
+  MPI_Allreduce(MPI_IN_PLACE, counts, 3, MPI_LONG_LONG, MPI_SUM, comm);
+
+  double rate = counts[0]+counts[1]>0 ? 100.0*counts[0]/(counts[0]+counts[1]) : 0.0;
+  print(comm, "- Riemann solution cache: %lld hits, %lld misses (hit rate: %.1f%%), %lld evictions.\n",
+        counts[0], counts[1], rate, counts[2]);
+
+  m2c_timer.AddCount("RiemannCacheHits", hits);
+  m2c_timer.AddCount("RiemannCacheMisses", misses);
+  m2c_timer.AddCount("RiemannCacheEvictions", evictions);
+}
+
+//-----------------------------------------------------
+//! Keeps ~log2(1/tol) bits of the mantissa. Bits 0-39: |mantissa|, bit 40: sign, bits 41-52: exponent
+long long
+ExactRiemannSolverCached::QuantizeRelative(double x)
+{
+  if(x==0.0)
+    return 0;
+  int ex;
+  double m = frexp(x, &ex); //0.5 <= |m| < 1, -1073 <= ex <= 1024
+  long long mant = llround(fabs(m)*inv_tol);
+  assert(mant < (1LL<<40)); //guaranteed by tol >= 1e-12
+  return ((long long)(ex+2048)<<41) | (m<0.0 ? (1LL<<40) : 0LL) | mant;
+}
+
+//-----------------------------------------------------
+
+long long
+ExactRiemannSolverCached::QuantizeAbsolute(double x, double scale)
+{
+  double r = x*inv_tol/scale;
+  if(!(fabs(r)<1.0e15)) //scale is (nearly) zero, or x is huge
+    return QuantizeRelative(x) ^ (1LL<<62);
+  return llround(r);
+}
+
+//-----------------------------------------------------
+
+void
+ExactRiemannSolverCached::QuantizeState(double *V, long long *q)
+{
+  double uscale = sqrt(fabs(V[4])/V[0]); //a velocity scale
+  q[0] = QuantizeRelative(V[0]);
+  q[1] = QuantizeAbsolute(V[1], uscale);
+  q[2] = QuantizeAbsolute(V[2], uscale);
+  q[3] = QuantizeAbsolute(V[3], uscale);
+  q[4] = QuantizeRelative(V[4]);
+}
+
+//-----------------------------------------------------
@@ -0,0 +1,94 @@
+/************************************************************************
+ * Copyright © 2020 The Multiphysics Modeling and Computation (M2C) Lab
+ * <kevin.wgy@gmail.com> <kevinw3@vt.edu>
+ ************************************************************************/
+
+#ifndef _EXACT_RIEMANN_SOLVER_CACHED_H_
+#define _EXACT_RIEMANN_SOLVER_CACHED_H_
+
+#include <ExactRiemannSolverBase.h>
+#include <unordered_map>
+#include <array>
+#include <mpi.h>
+
+/*****************************************************************************************
+ * ExactRiemannSolverCached wraps another exact Riemann solver (which it owns), and memoizes
+ * the solutions of two-material Riemann problems. The inputs (normal, Vm, idm, Vp, idp,
+ * curvature) are quantized with a relative tolerance (ExactRiemannSolverData::cache_tolerance):
+ * densities, pressures, and curvature relative to themselves, velocities relative to
+ * sqrt(|p|/rho) of the same state, and the normal in absolute terms. Problems with the
+ * same quantized inputs share the same (stored) solution. Only successful solutions are
+ * stored. When the cache reaches the maximum size, it is cleared.
+ * One-sided Riemann problems are passed to the wrapped solver directly.
+ * Note: Not thread-safe (like the wrapped solver).
+ *****************************************************************************************/
+
+class ExactRiemannSolverCached : public ExactRiemannSolverBase {
+
+  ExactRiemannSolverBase *solver; //!< the actual solver
+
+  //! quantized inputs: dir (3), Vm (5), Vp (5), curvature (1), and idm, idp (packed into one)
+  typedef std::array<long long, 15> Key;
+
+  struct KeyHash {
+    std::size_t operator()(const Key &key) const {
+      std::size_t h = 0;
+      for(auto&& q : key)
+        h ^= std::hash<long long>()(q) + 0x9e3779b97f4a7c15ULL + (h<<6) + (h>>2);
+      return h;
+    }
+  };
+
+  struct Solution {
+    double Vs[5], Vsm[5], Vsp[5];
+    int id;
+  };
+
+  std::unordered_map<Key, Solution, KeyHash> cache;
+
+  double tol, inv_tol;
+  int max_size;
+
+  //! statistics
+  long long hits, misses, evictions;
+  bool last_hit; //!< whether the latest (two-sided) problem was found in the cache
+
+public:
+
+  ExactRiemannSolverCached(std::vector<VarFcnBase*> &vf_, ExactRiemannSolverData &iod_riemann_,
+                           ExactRiemannSolverBase *solver_);
+  ~ExactRiemannSolverCached();
+
+  double GetSurfaceTensionCoefficient() {return solver->GetSurfaceTensionCoefficient();}
+
+  //! 0 for a cache hit
+  int GetNumberOfIterations() {return last_hit ? 0 : solver->GetNumberOfIterations();}
+
+  int ComputeRiemannSolution(double *dir/*unit normal*/, double *Vm, int idm /*"left" state*/,
+                             double *Vp, int idp /*"right" state*/,
+                             double *Vs, int &id /*solution at xi = 0 (i.e. x=0) */,
+                             double *Vsm /*left 'star' solution*/,
+                             double *Vsp /*right 'star' solution*/,
+                             double curvature = 0.0);
+
+  void PrintStarRelations(double rhol, double ul, double pl, int idl,
+                          double rhor, double ur, double pr, int idr,
+                          double pmin, double pmax, double dp) {
+    solver->PrintStarRelations(rhol, ul, pl, idl, rhor, ur, pr, idr, pmin, pmax, dp);}
+
+  int ComputeOneSidedRiemannSolution(double *dir, double *Vm, int idm, double *Ustar,
+                                     double *Vs, int &id, double *Vsm) {
+    return solver->ComputeOneSidedRiemannSolution(dir, Vm, idm, Ustar, Vs, id, Vsm);}
+
+  //! Collective. Prints the hit rate and adds the counters to m2c_timer (shown in the timing report)
+  void ReportStatistics(MPI_Comm &comm);
+
+private:
+
+  long long QuantizeRelative(double x);
+  long long QuantizeAbsolute(double x, double scale);
+  void QuantizeState(double *V, long long *q);
+
+};
+
+#endif
@@ -4,6 +4,7 @@
  ************************************************************************/
 
 #include<ExactRiemannSolverInterfaceJump.h>
+#include<Timer.h>
 #include<array>
 #include<utility> //std::pair
 #include<bits/stdc++.h> //std::swap
@@ -39,6 +40,8 @@ ExactRiemannSolverInterfaceJump::ComputeRiemannSolution(double *dir,
     double *Vsp /*right 'star' solution*/,
     double curvature)
 {
+  ScopedTimer scoped_timer("RiemannSolve");
+
 
   ComputePressureJump(idr, curvature);
 
@@ -51,12 +54,11 @@ ExactRiemannSolverInterfaceJump::ComputeRiemannSolution(double *dir,
   double pr    = Vp[4];
   //fprintf(stdout,"1DRiemann: left = %e %e %e (%d) : right = %e %e %e (%d)\n", rhol, ul, pl, idl, rhor, ur, pr, idr);
 
+  last_iters = 0;
   integrationPath1.clear();
   integrationPath3.clear();
-  std::vector<double> vectL{pl, rhol, ul};
-  std::vector<double> vectR{pr, rhor, ur};
-  integrationPath1.push_back(vectL);
-  integrationPath3.push_back(vectR); 
+  integrationPath1.push_back(pl, rhol, ul);
+  integrationPath3.push_back(pr, rhor, ur);
 
 #if PRINT_RIEMANN_SOLUTION == 1
   std::cout << "Left State (rho, u, p): " << rhol << ", " << ul << ", " << pl << "." << std::endl;
@@ -281,6 +283,8 @@ try_again:
   }
 
 
+  last_iters = iter;
+
   // -------------------------------
   // Step 3: Find state at xi = x = 0 (for output)
   // -------------------------------
@@ -739,8 +743,8 @@ ExactRiemannSolverInterfaceJump::FinalizeSolution(double *dir, double *Vm, doubl
 
 #if PRINT_RIEMANN_SOLUTION == 1
   // the 2-wave
-  sol1d.push_back(vector<double>{u2 - std::max(1e-6, 0.001*fabs(u2)), rhol2, u2, p2, (double)idl});
-  sol1d.push_back(vector<double>{u2, rhor2, u2, p2+delta_p, (double)idr});
+  sol1d.push_back(std::array<double,5>{u2 - std::max(1e-6, 0.001*fabs(u2)), rhol2, u2, p2, (double)idl});
+  sol1d.push_back(std::array<double,5>{u2, rhor2, u2, p2+delta_p, (double)idr});
 #endif
 
   Vs[0] = Vs[1] = Vs[2] = Vs[3] = Vs[4] = 0.0;
@@ -867,12 +871,12 @@ ExactRiemannSolverInterfaceJump::FinalizeSolution(double *dir, double *Vm, doubl
 
 #if PRINT_RIEMANN_SOLUTION == 1
   std::sort(sol1d.begin(), sol1d.end(), 
-      [](vector<double> v1, vector<double> v2){return v1[0]<v2[0];});
+      [](const std::array<double,5> &v1, const std::array<double,5> &v2){return v1[0]<v2[0];});
   int last = sol1d.size()-1;
   double xi_span = sol1d[last][0] - sol1d[0][0];
-  sol1d.insert(sol1d.begin(), vector<double>{sol1d[0][0]-xi_span, sol1d[0][1], sol1d[0][2], sol1d[0][3], sol1d[0][4]});
+  sol1d.insert(sol1d.begin(), std::array<double,5>{sol1d[0][0]-xi_span, sol1d[0][1], sol1d[0][2], sol1d[0][3], sol1d[0][4]});
   last++;
-  sol1d.push_back(vector<double>{sol1d[last][0]+xi_span, sol1d[last][1], sol1d[last][2], sol1d[last][3], sol1d[last][4]});
+  sol1d.push_back(std::array<double,5>{sol1d[last][0]+xi_span, sol1d[last][1], sol1d[last][2], sol1d[last][3], sol1d[last][4]});
 
   FILE* solFile = fopen("RiemannSolution.txt", "w");
   print(solFile, "## One-Dimensional Riemann Problem.\n");
@@ -90,22 +90,25 @@ FloodFill::FillBasedOnEdgeObstructions(SpaceVariable3D& Obs, int non_obstruction
   // 2. Flood fill
   std::queue<Int3> Q;
   Int3 seed(ii0_in, jj0_in, kk0_in);
+  int seed_id = 0; //nodes before this one (in k-j-i order) have been decided
+  int nx_in = iimax_in - ii0_in, ny_in = jjmax_in - jj0_in;
   while(nColored < Color.NumNodesIncludingInternalGhosts()) {
 
     mycolor++; //color starts at 1
 
-    // find an undecided node as seed
-    for(int k=kk0_in; k<kkmax_in; k++)
-      for(int j=jj0_in; j<jjmax_in; j++)
-        for(int i=ii0_in; i<iimax_in; i++) {
-          if(color[k][j][i] != UNDECIDED)
-            continue; 
-          seed[0] = i;
-          seed[1] = j;
-          seed[2] = k;
-          goto FOUND_SEED;
-        }
-    FOUND_SEED:
+    // find an undecided node as seed (continuing from the previous seed, so the search is linear overall)
+    for(; seed_id < nx_in*ny_in*(kkmax_in-kk0_in); seed_id++) {
+      int i = ii0_in + seed_id%nx_in;
+      int j = jj0_in + (seed_id/nx_in)%ny_in;
+      int k = kk0_in + seed_id/(nx_in*ny_in);
+      if(color[k][j][i] != UNDECIDED)
+        continue; 
+      seed[0] = i;
+      seed[1] = j;
+      seed[2] = k;
+      break;
+    }
+
     //assert(seed != Int3(iimax_in-1,jjmax_in-1,kkmax_in-1)); //everyone else are decided. this is the last one...
     Q.push(seed);
 
@@ -211,167 +214,70 @@ FloodFill::FillBasedOnEdgeObstructions(SpaceVariable3D& Obs, int non_obstruction
 */
 
   // ----------------------
-  // II.2. Proc. 0 collects data from everyone
+  // II.2. Everyone gets the equivalences (compact label pairs) from everyone
   // ----------------------
-  int worker = 0; //ID of the processor that does this job
-  int my_data_count = 4*equiv.size();
-  vector<int> my_data(my_data_count,0);
-  int counter = 0;
-  for(auto it = equiv.begin(); it != equiv.end(); it++) {
-    my_data[counter++] = mpi_rank;
-    my_data[counter++] = (*it)[0];
-    my_data[counter++] = (*it)[1];
-    my_data[counter++] = (*it)[2];
-  }
+  int my_info[2] = {(int)equiv.size(), mycolor};
+  vector<int> all_info(2*mpi_size, 0);
+  MPI_Allgather(my_info, 2, MPI_INT, all_info.data(), 2, MPI_INT, comm);
 
-  // talk
-  vector<int> counts;
-  if(mpi_rank == worker) { //I am the receiver
-    counts.resize(mpi_size,-1);
-    MPI_Gather(&my_data_count, 1, MPI_INT, counts.data(), 1, MPI_INT, worker, comm);
-  } else //I am a sender
-    MPI_Gather(&my_data_count, 1, MPI_INT, NULL, 1, MPI_INT, worker, comm);
-
-  // work
-  vector<int> displacements;
-  counter = 0;
-  if(mpi_rank == worker) {
-    displacements.resize(mpi_size,-1); 
-    for(int i=0; i<(int)displacements.size(); i++) {
-      displacements[i] = counter;
-      counter += counts[i];
-    }
+  vector<int> counts(mpi_size), displacements(mpi_size);
+  vector<int> color_offset(mpi_size+1, 0); //global (pre-merge) id of local color c on proc p: color_offset[p]+c-1
+  int counter = 0;
+  for(int p=0; p<mpi_size; p++) {
+    counts[p]          = 3*all_info[2*p];
+    displacements[p]   = counter;
+    counter           += counts[p];
+    color_offset[p+1]  = color_offset[p] + all_info[2*p+1];
   }
 
-  // talk again
-  vector<int> all_data;
-  if(mpi_rank == worker) { //receiver
-    all_data.resize(counter);
-    MPI_Gatherv(my_data.data(), my_data_count, MPI_INT, all_data.data(), counts.data(), displacements.data(), MPI_INT, worker, comm);
-/*
-    for(int i=0; i<counter/4; i++)
-      fprintf(stdout,"[%d] %d = [%d] %d.\n", all_data[4*i], all_data[4*i+1], all_data[4*i+2], all_data[4*i+3]);
-*/
-  } else {//sender
-    MPI_Gatherv(my_data.data(), my_data_count, MPI_INT, NULL, NULL, NULL, MPI_INT, worker, comm);
+  vector<int> my_data(3*equiv.size(), 0);
+  int my_counter = 0;
+  for(auto it = equiv.begin(); it != equiv.end(); it++) {
+    my_data[my_counter++] = (*it)[0];
+    my_data[my_counter++] = (*it)[1];
+    my_data[my_counter++] = (*it)[2];
   }
 
+  vector<int> all_data(counter);
+  MPI_Allgatherv(my_data.data(), my_data.size(), MPI_INT, all_data.data(), counts.data(), displacements.data(),
+                 MPI_INT, comm);
 
   // ----------------------
-  // II.3. Proc. 0 unionizes colors
+  // II.3. Everyone merges the equivalent colors (union-find), in one pass over the pairs
   // ----------------------
-  vector<set<pair<int, int> > > loc2glob;  //loc2glob[i]: i-th proc.;  loc2glob[i][j]: j-th color-pair (old->new)
-  int current_color(-1);
-  if(mpi_rank == worker) {
-    
-    loc2glob.resize(mpi_size);
-
-    int num_pairs = counter/4;
-    vector<bool> unionized(num_pairs, false);
-
-    current_color = 0;
-
-    set<pair<int,int> > glob2loc;
-
-    for(int i=0; i<num_pairs; i++) {
-
-      if(unionized[i])
-        continue;
-
-      current_color++; //color starts at 1, not 0, which is for occluded
-
-      glob2loc.clear(); //a new color
-
-      glob2loc.insert(std::make_pair(all_data[4*i], all_data[4*i+1]));
-      glob2loc.insert(std::make_pair(all_data[4*i+2], all_data[4*i+3]));
-
-      loc2glob[all_data[4*i]].insert(make_pair(all_data[4*i+1], current_color));
-      loc2glob[all_data[4*i+2]].insert(make_pair(all_data[4*i+3], current_color));
-      unionized[i] = true;
-      bool new_member = true; //has a new pair that has "current_color"
-
-      while(new_member==true) {
-
-        new_member = false;
-
-        for(int j=0; j<num_pairs; j++) {
-        
-          if(unionized[j])
-            continue;
-
-          pair<int,int> p1(all_data[4*j],   all_data[4*j+1]); //p1 and p2 should have the same final color
-          pair<int,int> p2(all_data[4*j+2], all_data[4*j+3]);
-
-          if(glob2loc.find(p1) != glob2loc.end()) {
-            glob2loc.insert(p2);
-            loc2glob[p2.first].insert(make_pair(p2.second, current_color));
-            unionized[j] = true;
-            new_member = true;
-          } else if(glob2loc.find(p2) != glob2loc.end()) {
-            glob2loc.insert(p1);
-            loc2glob[p1.first].insert(make_pair(p1.second, current_color));
-            unionized[j] = true;
-            new_member = true;
-          }
-        }
-      }
-    } 
-/*
-    for(int i=0; i<mpi_size; i++)
-      for(auto it = loc2glob[i].begin(); it != loc2glob[i].end(); it++)
-        fprintf(stdout,"[%d] loc %d --> glob %d.\n", i, it->first, it->second);
-*/
-  }
+  vector<int> parent(color_offset[mpi_size]);
+  for(int i=0; i<(int)parent.size(); i++)
+    parent[i] = i;
+
+  for(int p=0; p<mpi_size; p++)
+    for(int n=displacements[p]; n<displacements[p]+counts[p]; n+=3) {
+      int a = FindRoot(parent, color_offset[p] + all_data[n] - 1);
+      int b = FindRoot(parent, color_offset[all_data[n+1]] + all_data[n+2] - 1);
+      if(a != b)
+        parent[std::max(a,b)] = std::min(a,b);
+    }
 
   // ----------------------
-  // II.4. Everyone gets the final colors
+  // II.4. Assign the final colors. Each group of equivalent colors gets a new color (1, 2, ...), in the 
+  //       order in which it first appears in the pairs (i.e. the same as the previous, serial merging algorithm).
   // ----------------------
-  // talk again to figure out package sizes
-  if(mpi_rank == worker) { 
-
-    for(int i=0; i<mpi_size; i++)
-      counts[i] = 2*loc2glob[i].size();
-
-    MPI_Scatter(counts.data(), 1, MPI_INT, &my_data_count, 1, MPI_INT, worker, comm);
-  } else 
-    MPI_Scatter(NULL, 1, MPI_INT, &my_data_count, 1, MPI_INT, worker, comm);
-
- 
-  assert(my_data_count/2 == mycolor);
-
-  // worker prepares packages
-  if(mpi_rank == worker) {
-    counter = 0;
-    for(int i=0; i<mpi_size; i++) {
-      displacements[i] = counter;
-
-      for(auto it = loc2glob[i].begin(); it != loc2glob[i].end(); it++) {
-        all_data[counter++] = it->first;
-        all_data[counter++] = it->second;
-      }
+  vector<int> root2new(parent.size(), -1);
+  int current_color = 0;
+  for(int p=0; p<mpi_size; p++)
+    for(int n=displacements[p]; n<displacements[p]+counts[p]; n+=3) {
+      int a = FindRoot(parent, color_offset[p] + all_data[n] - 1);
+      if(root2new[a] < 0)
+        root2new[a] = ++current_color;
     }
-  }
-
-  // talk again --> each subdomain gets the final colors
-  if(mpi_rank == worker) //sender
-    MPI_Scatterv(all_data.data(), counts.data(), displacements.data(), MPI_INT, my_data.data(), my_data_count, MPI_INT, worker, comm);
-  else //receiver
-    MPI_Scatterv(NULL, NULL, NULL, MPI_INT, my_data.data(), my_data_count, MPI_INT, worker, comm);
-
 
   // ----------------------
   // II.5. Everyone applies the final colors
   // ----------------------
   vector<int> old2new(mycolor+1, -1);
   old2new[0] = 0; //occluded --> 0
-  int old_color(-1), new_color(-1);
-  for(int i=0; i<my_data_count/2; i++) {
-    old_color = my_data[2*i];
-    new_color = my_data[2*i+1];
-    assert(old_color>0 && old_color<=mycolor);
-    assert(old2new[old_color]==-1); //no conflicts.
-    old2new[old_color] = new_color;
-    //fprintf(stdout,"[%d] old color %d --> new color %d.\n", mpi_rank, old_color, new_color);
+  for(int c=1; c<=mycolor; c++) {
+    old2new[c] = root2new[FindRoot(parent, color_offset[mpi_rank] + c - 1)];
+    assert(old2new[c]>0); //every local color appears in equiv
   } 
     
   for(int k=k0; k<kmax; k++)
@@ -382,16 +288,23 @@ FloodFill::FillBasedOnEdgeObstructions(SpaceVariable3D& Obs, int non_obstruction
   Color.RestoreDataPointerAndInsert();
 
 
-  // ----------------------
-  // III. Finalization
-  // ----------------------
-  // final talk --> everyone should know (and return) the total number of non-zero colors
-  MPI_Bcast(&current_color, 1, MPI_INT, worker, comm);
-
+  // everyone knows the total number of non-zero colors
   return current_color;
 
 }
 
+//-----------------------------------------------------------------------------------
+
+int
+FloodFill::FindRoot(vector<int> &parent, int i)
+{
+  while(parent[i] != i) {
+    parent[i] = parent[parent[i]]; //path halving
+    i = parent[i];
+  }
+  return i;
+}
+
 
 //-----------------------------------------------------------------------------------
 
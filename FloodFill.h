@@ -44,8 +44,10 @@ public:
   int FillBasedOnEdgeObstructions(SpaceVariable3D& Obs, int non_obstruction_flag,
                                   std::set<Int3>& occluded_nodes, SpaceVariable3D& Color);
 
+private:
 
-
+  //! union-find: root of element i (with path halving)
+  static int FindRoot(std::vector<int> &parent, int i);
 
 };
 
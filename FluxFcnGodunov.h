@@ -8,9 +8,12 @@
 
 #include <FluxFcnBase.h>
 #include <ExactRiemannSolverBase.h>
+#include <Utils.h> //get_max_threads, get_thread_num
 
 /****************************************************************************************
  * The Godunov flux, based on solving the exact Riemann problem
+ * Note: The exact Riemann solver keeps intermediate results in member variables. So,
+ *       each thread has its own solver.
  ***************************************************************************************/
 
 class FluxFcnGodunov : public FluxFcnBase {
@@ -18,7 +21,7 @@ class FluxFcnGodunov : public FluxFcnBase {
 public:
 
   FluxFcnGodunov(std::vector<VarFcnBase*> &varFcn, IoData &iod) 
-      : FluxFcnBase(varFcn), riemann(varFcn,iod.exact_riemann) { } 
+      : FluxFcnBase(varFcn), riemann(get_max_threads(), ExactRiemannSolverBase(varFcn,iod.exact_riemann)) { } 
     
   ~FluxFcnGodunov() {}
 
@@ -27,7 +30,7 @@ public:
 
 private:
 
-  ExactRiemannSolverBase riemann;
+  std::vector<ExactRiemannSolverBase> riemann; //!< one per thread
 
 };
 
@@ -44,7 +47,7 @@ void FluxFcnGodunov::ComputeNumericalFluxAtCellInterface(int dir, double *Vm, do
   Vec3D normal(0.0,0.0,0.0);
   normal[dir] = 1.0;
 
-  riemann.ComputeRiemannSolution(normal, Vm, id, Vp, id, Vmid, midid, Vsm, Vsp);
+  riemann[get_thread_num()].ComputeRiemannSolution(normal, Vm, id, Vp, id, Vmid, midid, Vsm, Vsp);
  
   if(dir==0) 
     EvaluateFluxFunction_F(Vmid, id, flux);
@@ -0,0 +1,211 @@
+/************************************************************************
+ * Copyright © 2020 The Multiphysics Modeling and Computation (M2C) Lab
+ * <kevin.wgy@gmail.com> <kevinw3@vt.edu>
+ ************************************************************************/
+
+#include<FusedLevelSetAdvector.h>
+#include<Vector5D.h>
+#include<Utils.h>
+#include<cassert>
+
+//-----------------------------------------------------
+
+FusedLevelSetAdvector::FusedLevelSetAdvector(MPI_Comm &comm_, DataManagers3D &dm_all_,
+                                             SpaceVariable3D &coordinates_, SpaceVariable3D &delta_xyz_,
+                                             int N_)
+                     : comm(comm_), coordinates(coordinates_), N(N_),
+                       grad_minus(comm_, dm_all_, coordinates_, delta_xyz_, -1),
+                       grad_plus(comm_, dm_all_, coordinates_, delta_xyz_, 1)
+{
+  assert(N>0);
+
+  CreatePackedDM(dm_all_.ghosted1_1dof, dm_ghosted1_Ndof);
+  CreatePackedDM(dm_all_.ghosted2_1dof, dm_ghosted2_Ndof);
+
+  PhiG2 = new SpaceVariable3D(comm, &dm_ghosted2_Ndof);
+  Phil  = new SpaceVariable3D(comm, &dm_ghosted1_Ndof);
+  Phir  = new SpaceVariable3D(comm, &dm_ghosted1_Ndof);
+  Phib  = new SpaceVariable3D(comm, &dm_ghosted1_Ndof);
+  Phit  = new SpaceVariable3D(comm, &dm_ghosted1_Ndof);
+  Phik  = new SpaceVariable3D(comm, &dm_ghosted1_Ndof);
+  Phif  = new SpaceVariable3D(comm, &dm_ghosted1_Ndof);
+}
+
+//-----------------------------------------------------
+
+FusedLevelSetAdvector::~FusedLevelSetAdvector()
+{
+  //Destroy() should have been called
+  if(PhiG2) delete PhiG2;
+  if(Phil)  delete Phil;
+  if(Phir)  delete Phir;
+  if(Phib)  delete Phib;
+  if(Phit)  delete Phit;
+  if(Phik)  delete Phik;
+  if(Phif)  delete Phif;
+}
+
+//-----------------------------------------------------
+
+void
+FusedLevelSetAdvector::Destroy()
+{
+  SpaceVariable3D* vars[7] = {PhiG2, Phil, Phir, Phib, Phit, Phik, Phif};
+  for(auto&& v : vars) {
+    v->Destroy();
+    delete v;
+  }
+  PhiG2 = Phil = Phir = Phib = Phit = Phik = Phif = NULL;
+
+  grad_minus.Destroy();
+  grad_plus.Destroy();
+
+  DMDestroy(&dm_ghosted1_Ndof);
+  DMDestroy(&dm_ghosted2_Ndof);
+}
+
+//-----------------------------------------------------
+
+void
+FusedLevelSetAdvector::CreatePackedDM(DM &dm0, DM &dm)
+{
+  // Same partition and stencil width as dm0, but N dofs
+  int NX, NY, NZ, nProcX, nProcY, nProcZ, sw;
+  DMDAGetInfo(dm0, NULL, &NX, &NY, &NZ, &nProcX, &nProcY, &nProcZ, NULL, &sw, NULL, NULL, NULL, NULL);
+  const PetscInt *lx, *ly, *lz;
+  DMDAGetOwnershipRanges(dm0, &lx, &ly, &lz);
+
+  DMDACreate3d(comm, DM_BOUNDARY_GHOSTED, DM_BOUNDARY_GHOSTED, DM_BOUNDARY_GHOSTED,
+               DMDA_STENCIL_BOX,
+               NX, NY, NZ,
+               nProcX, nProcY, nProcZ,
+               N, sw,
+               lx, ly, lz,
+               &dm);
+  DMSetUp(dm); //not calling DMSetFromOptions, which may change the partition
+}
+
+//-----------------------------------------------------
+
+bool
+FusedLevelSetAdvector::Applicable(vector<LevelSetOperator*> &lso)
+{
+#ifdef LEVELSET_TEST
+  return false; //the velocity field is prescribed by each LevelSetOperator
+#endif
+
+  if(lso.empty())
+    return false;
+
+  for(auto&& ls : lso) {
+    LevelSetSchemeData &iod_ls(ls->GetLevelSetSchemeData());
+    if(iod_ls.solver != LevelSetSchemeData::FINITE_DIFFERENCE ||
+       iod_ls.fd != LevelSetSchemeData::UPWIND_CENTRAL_3 || ls->NarrowBand())
+      return false;
+  }
+  return true;
+}
+
+//-----------------------------------------------------
+
+void
+FusedLevelSetAdvector::ComputeResiduals(SpaceVariable3D &V, vector<SpaceVariable3D*> &Phi,
+                                        vector<SpaceVariable3D*> &R)
+{
+  assert((int)Phi.size()==N && (int)R.size()==N);
+
+  int i0, j0, k0, imax, jmax, kmax, ii0, jj0, kk0, iimax, jjmax, kkmax;
+  coordinates.GetCornerIndices(&i0, &j0, &k0, &imax, &jmax, &kmax);
+  coordinates.GetGhostedCornerIndices(&ii0, &jj0, &kk0, &iimax, &jjmax, &kkmax);
+
+  vector<double***> phi(N), res(N);
+  for(int n=0; n<N; n++) {
+    phi[n] = Phi[n]->GetDataPointer();
+    res[n] = R[n]->GetDataPointer(false); //only the interior is written
+  }
+
+  //***************************************************************
+  // Step 1: Pack Phi and calculate its partial derivatives
+  //***************************************************************
+  double*** s = PhiG2->GetDataPointer(false);
+#pragma omp parallel for collapse(2)
+  for(int k=kk0; k<kkmax; k++)
+    for(int j=jj0; j<jjmax; j++)
+      for(int i=ii0; i<iimax; i++)
+        for(int n=0; n<N; n++)
+          s[k][j][i*N+n] = phi[n][k][j][i];
+  PhiG2->RestoreDataPointerAndInsert(); //one exchange for all the level sets
+
+  vector<int> dofs(N);
+  for(int n=0; n<N; n++)
+    dofs[n] = n;
+
+  grad_minus.CalculateFirstDerivativeAtNodes(0/*x*/, *PhiG2, dofs, *Phil, dofs);
+  grad_plus.CalculateFirstDerivativeAtNodes(0/*x*/, *PhiG2, dofs, *Phir, dofs);
+  grad_minus.CalculateFirstDerivativeAtNodes(1/*y*/, *PhiG2, dofs, *Phib, dofs);
+  grad_plus.CalculateFirstDerivativeAtNodes(1/*y*/, *PhiG2, dofs, *Phit, dofs);
+  grad_minus.CalculateFirstDerivativeAtNodes(2/*z*/, *PhiG2, dofs, *Phik, dofs);
+  grad_plus.CalculateFirstDerivativeAtNodes(2/*z*/, *PhiG2, dofs, *Phif, dofs);
+
+  //***************************************************************
+  // Step 2: One sweep over V, computing all the residuals
+  //         (same as LevelSetOperator::ComputeResidualFDM_FullDomain)
+  //***************************************************************
+  int NX, NY, NZ;
+  coordinates.GetGlobalSize(&NX, &NY, &NZ);
+
+  Vec5D*** v = (Vec5D***) V.GetDataPointer();
+  double*** phil = Phil->GetDataPointer(); //d(Phi)/dx, left-biased
+  double*** phir = Phir->GetDataPointer(); //d(Phi)/dx, right-biased
+  double*** phib = Phib->GetDataPointer();
+  double*** phit = Phit->GetDataPointer();
+  double*** phik = Phik->GetDataPointer();
+  double*** phif = Phif->GetDataPointer();
+  Vec3D*** coords = (Vec3D***)coordinates.GetDataPointer();
+
+#pragma omp parallel for collapse(2)
+  for(int k=k0; k<kmax; k++)
+    for(int j=j0; j<jmax; j++)
+      for(int i=i0; i<imax; i++) {
+
+        double ux = v[k][j][i][1], uy = v[k][j][i][2], uz = v[k][j][i][3];
+
+        // one-sided differences are used next to the boundary (depend only on the node)
+        bool xm = i-2>=-1, xp = i+2<=NX, ym = j-2>=-1, yp = j+2<=NY, zm = k-2>=-1, zp = k+2<=NZ;
+        double dxm = xm ? 0.0 : coords[k][j][i][0]-coords[k][j][i-1][0];
+        double dxp = xp ? 0.0 : coords[k][j][i+1][0]-coords[k][j][i][0];
+        double dym = ym ? 0.0 : coords[k][j][i][1]-coords[k][j-1][i][1];
+        double dyp = yp ? 0.0 : coords[k][j+1][i][1]-coords[k][j][i][1];
+        double dzm = zm ? 0.0 : coords[k][j][i][2]-coords[k-1][j][i][2];
+        double dzp = zp ? 0.0 : coords[k+1][j][i][2]-coords[k][j][i][2];
+
+        for(int n=0; n<N; n++) {
+          double*** ph = phi[n];
+          int p = i*N+n;
+          double a = xm ? phil[k][j][p] : (ph[k][j][i]-ph[k][j][i-1])/dxm;
+          double b = xp ? phir[k][j][p] : (ph[k][j][i+1]-ph[k][j][i])/dxp;
+          double c = ym ? phib[k][j][p] : (ph[k][j][i]-ph[k][j-1][i])/dym;
+          double d = yp ? phit[k][j][p] : (ph[k][j+1][i]-ph[k][j][i])/dyp;
+          double e = zm ? phik[k][j][p] : (ph[k][j][i]-ph[k-1][j][i])/dzm;
+          double f = zp ? phif[k][j][p] : (ph[k+1][j][i]-ph[k][j][i])/dzp;
+
+          res[n][k][j][i] = -((ux>=0 ? a*ux : b*ux) + (uy>=0 ? c*uy : d*uy) + (uz>=0 ? e*uz : f*uz));
+        }
+      }
+
+  Phil->RestoreDataPointerToLocalVector();
+  Phir->RestoreDataPointerToLocalVector();
+  Phib->RestoreDataPointerToLocalVector();
+  Phit->RestoreDataPointerToLocalVector();
+  Phik->RestoreDataPointerToLocalVector();
+  Phif->RestoreDataPointerToLocalVector();
+  coordinates.RestoreDataPointerToLocalVector();
+
+  V.RestoreDataPointerToLocalVector();
+  for(int n=0; n<N; n++) {
+    Phi[n]->RestoreDataPointerToLocalVector();
+    R[n]->RestoreDataPointerAndMarkGhostsStale(); //ghost layer updated when (and if) needed
+  }
+}
+
+//-----------------------------------------------------
@@ -0,0 +1,61 @@
+/************************************************************************
+ * Copyright © 2020 The Multiphysics Modeling and Computation (M2C) Lab
+ * <kevin.wgy@gmail.com> <kevinw3@vt.edu>
+ ************************************************************************/
+
+#ifndef _FUSED_LEVELSET_ADVECTOR_H_
+#define _FUSED_LEVELSET_ADVECTOR_H_
+
+#include <LevelSetOperator.h>
+#include <GradientCalculatorFD3.h>
+
+/*****************************************************************************
+ * class FusedLevelSetAdvector computes the residuals of N level set equations
+ * (full-domain, finite difference) together. Phi[0], ..., Phi[N-1] are packed
+ * into one N-dof variable, so the internal ghost layers are exchanged once
+ * (instead of once per level set), the upwind derivatives are computed with
+ * one set of FD coefficients, and the velocity field V is swept once to form
+ * all the N residuals. The results are identical to those obtained by calling
+ * LevelSetOperator::ComputeResidual for each level set.
+ * Note: The packed variables use DMs with the same partition as DataManagers3D.
+ ****************************************************************************/
+
+class FusedLevelSetAdvector
+{
+  MPI_Comm &comm;
+
+  SpaceVariable3D &coordinates;
+
+  int N; //!< number of level sets
+
+  //! DMs for N-dof variables (stencil width 1 and 2)
+  DM dm_ghosted1_Ndof, dm_ghosted2_Ndof;
+
+  //! Left- and right-biased FD (shared by all the level sets)
+  GradientCalculatorFD3 grad_minus, grad_plus;
+
+  //! Packed Phi (2 ghost layers) and its left/right-biased derivatives
+  SpaceVariable3D *PhiG2;
+  SpaceVariable3D *Phil, *Phir, *Phib, *Phit, *Phik, *Phif;
+
+public:
+
+  FusedLevelSetAdvector(MPI_Comm &comm_, DataManagers3D &dm_all_, SpaceVariable3D &coordinates_,
+                        SpaceVariable3D &delta_xyz_, int N_);
+  ~FusedLevelSetAdvector();
+
+  //! Whether the level sets can be advanced together (all full-domain, finite difference)
+  static bool Applicable(vector<LevelSetOperator*> &lso);
+
+  //! R[n] = -V*grad(Phi[n]), n = 0, ..., N-1 (domain interior). The ghost layers of R[n] are marked stale.
+  void ComputeResiduals(SpaceVariable3D &V, vector<SpaceVariable3D*> &Phi, vector<SpaceVariable3D*> &R);
+
+  void Destroy();
+
+private:
+
+  void CreatePackedDM(DM &dm0, DM &dm);
+
+};
+
+#endif
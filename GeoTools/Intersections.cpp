@@ -227,6 +227,58 @@ LineSegmentIntersectsTriangle(Vec3D O, int dir, //!< dir = 0 (x-axis), 1 (y-axis
     return true;
 }
 
+// ------------------------------------------------------------------------------------------------------------
+// Same arithmetic as AxisIntersectsTriangle, applied to a block of triangles
+int
+LineSegmentIntersectsTriangles(Vec3D& O, int dir, double len, TriangleBlock& tris,
+                               int* hit, double* d, double* u, double* v)
+{
+  assert(len>0);
+  assert(dir>=0 && dir<=2);
+
+  int a = dir==0 ? 1 : 0; //the other two axes
+  int b = dir==2 ? 1 : 2;
+
+  double *p1 = tris.E1[a], *p2 = tris.E1[b], *pd = tris.E1[dir];
+  double *q1 = tris.E2[a], *q2 = tris.E2[b], *qd = tris.E2[dir];
+  double *v1 = tris.V0[a], *v2 = tris.V0[b], *vd = tris.V0[dir];
+  double o1 = O[a], o2 = O[b], od = O[dir];
+  const double eps = INTERSECTIONS_EPSILON;
+
+  int nHits = 0;
+#pragma omp simd reduction(+:nHits)
+  for(int t=0; t<tris.size; t++) {
+    double denom = p1[t]*q2[t] - p2[t]*q1[t];
+    double f  = denom!=0 ? 1.0/denom : 0.0; //denom = 0: parallel to the triangle
+    double r1 = o1 - v1[t], r2 = o2 - v2[t], rd = od - vd[t];
+    double uu = f*(r1*q2[t] - r2*q1[t]);
+    double vv = f*(r2*p1[t] - r1*p2[t]);
+    double tt = pd[t]*uu + qd[t]*vv - rd;
+    int h = (denom!=0) & (uu >= -eps) & (uu <= 1.0+eps) & (vv >= -eps) & (uu + vv <= 1.0+eps) &
+            (tt > -eps) & (tt <= len+eps);
+    hit[t] = h;
+    d[t]   = tt;
+    u[t]   = uu;
+    v[t]   = vv;
+    nHits += h;
+  }
+
+  return nHits;
+}
+
+// ------------------------------------------------------------------------------------------------------------
+
+void
+DistancesToTrianglePlanes(Vec3D& x, TriangleBlock& tris, double* dist)
+{
+  double *a0 = tris.V0[0], *a1 = tris.V0[1], *a2 = tris.V0[2];
+  double *n0 = tris.N[0],  *n1 = tris.N[1],  *n2 = tris.N[2];
+  double x0 = x[0], x1 = x[1], x2 = x[2];
+#pragma omp simd
+  for(int t=0; t<tris.size; t++)
+    dist[t] = (x0-a0[t])*n0[t] + (x1-a1[t])*n1[t] + (x2-a2[t])*n2[t];
+}
+
 // ------------------------------------------------------------------------------------------------------------
 
 bool
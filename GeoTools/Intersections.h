@@ -45,6 +45,37 @@ bool LineSegmentIntersectsPlane(Vec3D X0, Vec3D X1, //!< vertices of line segmen
                                 Vec3D* xp = NULL, //!< optional output: intersection point
                                 bool N_normalized = false); //!< input: whether dir is normalized
 
+/** A block of (up to "capacity") triangles stored in the structure-of-arrays layout, so that a point or a
+ *  line segment can be tested against all of them in one vectorizable (SIMD) loop. Allocated on the stack. */
+struct TriangleBlock {
+  static const int capacity = 32;
+  int size;
+  double V0[3][capacity]; //!< first vertex
+  double E1[3][capacity], E2[3][capacity]; //!< V1-V0 and V2-V0
+  double N[3][capacity]; //!< unit normal (only needed by DistancesToTrianglePlanes)
+
+  TriangleBlock() : size(0) {}
+
+  inline void Add(Vec3D& v0, Vec3D& v1, Vec3D& v2, Vec3D* normal = NULL) {
+    for(int i=0; i<3; i++) {
+      V0[i][size] = v0[i];
+      E1[i][size] = v1[i] - v0[i];
+      E2[i][size] = v2[i] - v0[i];
+      N[i][size]  = normal ? (*normal)[i] : 0.0;
+    }
+    size++;
+  }
+};
+
+/** Batched version of the axis-aligned LineSegmentIntersectsTriangle: tests one line segment against all the
+ *  triangles in a block. For each triangle t, hit[t] = 1 (intersection) or 0. If hit[t] = 1, d[t] is the distance
+ *  from O to the intersection, and (1-u[t]-v[t], u[t], v[t]) are its barycentric coords. Returns number of hits.*/
+int LineSegmentIntersectsTriangles(Vec3D& O, int dir, double len, TriangleBlock& tris,
+                                   int* hit, double* d, double* u, double* v);
+
+//! Signed distances from a point to the planes of the triangles in a block (requires normals)
+void DistancesToTrianglePlanes(Vec3D& x, TriangleBlock& tris, double* dist);
+
 /** Checks whether a plane cuts an axis-aligned box. If yes, find edge-plane intersections.
  *  "intersections" are ordered such that the the points form the intersection polygon.
  *  Returns the number of intersection points. */
@@ -0,0 +1,213 @@
+/************************************************************************
+ * Copyright © 2020 The Multiphysics Modeling and Computation (M2C) Lab
+ * <kevin.wgy@gmail.com> <kevinw3@vt.edu>
+ ************************************************************************/
+
+#include<GhostExchangeGroup.h>
+#include<Utils.h>
+#include<cassert>
+
+//---------------------------------------------------------
+
+GhostExchangeGroup::GhostExchangeGroup(MPI_Comm &comm_) : comm(comm_), buffer(NULL)
+{ }
+
+//---------------------------------------------------------
+
+GhostExchangeGroup::~GhostExchangeGroup()
+{
+  for(auto&& pv : packed_var)
+    if(pv.second)
+      delete pv.second; //Destroy() should have been called
+}
+
+//---------------------------------------------------------
+
+void
+GhostExchangeGroup::Destroy()
+{
+  if(buffer)
+    EndExchange();
+
+  for(auto&& pv : packed_var) {
+    pv.second->Destroy();
+    delete pv.second;
+    pv.second = NULL;
+  }
+  packed_var.clear();
+
+  for(auto&& pdm : packed_dm)
+    DMDestroy(&pdm.second);
+  packed_dm.clear();
+}
+
+//---------------------------------------------------------
+
+void
+GhostExchangeGroup::Clear()
+{
+  if(buffer)
+    EndExchange();
+  vars.clear();
+}
+
+//---------------------------------------------------------
+
+void
+GhostExchangeGroup::Add(SpaceVariable3D &V)
+{
+  if(!vars.empty() && vars[0]->ghost_width != V.ghost_width) {
+    print_error(comm, "*** Error: Unable to exchange variables with different stencil widths (%d vs. %d) "
+                "together.\n", vars[0]->ghost_width, V.ghost_width);
+    exit_mpi();
+  }
+  vars.push_back(&V);
+}
+
+//---------------------------------------------------------
+
+void
+GhostExchangeGroup::Add(std::vector<SpaceVariable3D*> &V)
+{
+  for(auto&& v : V)
+    Add(*v);
+}
+
+//---------------------------------------------------------
+
+SpaceVariable3D*
+GhostExchangeGroup::GetPackedVariable(SpaceVariable3D &V0, int total_dof)
+{
+  std::pair<int,int> key(V0.ghost_width, total_dof);
+
+  auto it = packed_var.find(key);
+  if(it != packed_var.end())
+    return it->second;
+
+  // Create a DM with the same partition as V0, but a different dof
+  int NX, NY, NZ, nProcX, nProcY, nProcZ, sw;
+  DMDAGetInfo(*V0.dm, NULL, &NX, &NY, &NZ, &nProcX, &nProcY, &nProcZ, NULL, &sw, NULL, NULL, NULL, NULL);
+  const PetscInt *lx, *ly, *lz;
+  DMDAGetOwnershipRanges(*V0.dm, &lx, &ly, &lz);
+
+  DM &dm = packed_dm[key];
+  DMDACreate3d(comm, DM_BOUNDARY_GHOSTED, DM_BOUNDARY_GHOSTED, DM_BOUNDARY_GHOSTED,
+               DMDA_STENCIL_BOX,
+               NX, NY, NZ,
+               nProcX, nProcY, nProcZ,
+               total_dof, sw,
+               lx, ly, lz,
+               &dm);
+  DMSetUp(dm); //not calling DMSetFromOptions, which may change the partition
+
+  SpaceVariable3D* var = new SpaceVariable3D(comm, &dm);
+  packed_var[key] = var;
+  return var;
+}
+
+//---------------------------------------------------------
+
+void
+GhostExchangeGroup::BeginExchange()
+{
+  if(buffer) //the previous exchange has not been completed
+    EndExchange();
+
+  active.clear();
+  int total_dof = 0;
+  for(auto&& v : vars) {
+    if(!v->dm || !v->GhostsAreStale())
+      continue;
+    if(v->ghost_update_in_progress) { //started by itself. Let it finish.
+      v->EndGhostUpdate();
+      continue;
+    }
+    active.push_back(v);
+    total_dof += v->dof;
+  }
+
+  if(active.empty())
+    return;
+
+  if(active.size()==1) { //nothing to aggregate
+    active[0]->BeginGhostUpdate();
+    return;
+  }
+
+  buffer = GetPackedVariable(*active[0], total_dof);
+
+  int i0, j0, k0, imax, jmax, kmax;
+  buffer->GetCornerIndices(&i0, &j0, &k0, &imax, &jmax, &kmax);
+
+  // Pack the subdomain interiors
+  double*** b = buffer->GetDataPointer(false);
+  int offset = 0;
+  for(auto&& v : active) {
+    int dof = v->dof;
+    double*** a = v->GetDataPointer(false);
+    for(int k=k0; k<kmax; k++)
+      for(int j=j0; j<jmax; j++)
+        for(int i=i0; i<imax; i++)
+          for(int p=0; p<dof; p++)
+            b[k][j][i*total_dof+offset+p] = a[k][j][i*dof+p];
+    v->RestoreDataPointerToLocalVector();
+
+    // the interior may have been modified after the variable was marked stale (local, no communication)
+    DMLocalToGlobal(*v->dm, v->localVec, INSERT_VALUES, v->globalVec);
+
+    offset += dof;
+  }
+  buffer->RestoreDataPointerAndMarkGhostsStale();
+  buffer->BeginGhostUpdate();
+}
+
+//---------------------------------------------------------
+
+void
+GhostExchangeGroup::EndExchange()
+{
+  if(active.empty())
+    return;
+
+  if(!buffer) {
+    assert(active.size()==1);
+    active[0]->EndGhostUpdate();
+    active.clear();
+    return;
+  }
+
+  buffer->EndGhostUpdate();
+
+  int total_dof = buffer->dof;
+  int i0, j0, k0, imax, jmax, kmax;
+  int ii0, jj0, kk0, iimax, jjmax, kkmax; //internal ghosts only
+  buffer->GetCornerIndices(&i0, &j0, &k0, &imax, &jmax, &kmax);
+  buffer->GetInternalGhostedCornerIndices(&ii0, &jj0, &kk0, &iimax, &jjmax, &kkmax);
+
+  // Unpack the internal ghost layer
+  double*** b = buffer->GetDataPointer(false);
+  int offset = 0;
+  for(auto&& v : active) {
+    int dof = v->dof;
+    double*** a = v->GetDataPointer(false);
+    for(int k=kk0; k<kkmax; k++)
+      for(int j=jj0; j<jjmax; j++)
+        for(int i=ii0; i<iimax; i++) {
+          if(i==i0 && j>=j0 && j<jmax && k>=k0 && k<kmax) {
+            i = imax-1; //skip the interior
+            continue;
+          }
+          for(int p=0; p<dof; p++)
+            a[k][j][i*dof+p] = b[k][j][i*total_dof+offset+p];
+        }
+    v->RestoreDataPointerToLocalVector();
+    v->ghosts_stale = false;
+    offset += dof;
+  }
+  buffer->RestoreDataPointerToLocalVector();
+
+  buffer = NULL;
+  active.clear();
+}
+
+//---------------------------------------------------------
@@ -0,0 +1,66 @@
+/************************************************************************
+ * Copyright © 2020 The Multiphysics Modeling and Computation (M2C) Lab
+ * <kevin.wgy@gmail.com> <kevinw3@vt.edu>
+ ************************************************************************/
+
+#ifndef _GHOST_EXCHANGE_GROUP_H_
+#define _GHOST_EXCHANGE_GROUP_H_
+
+#include<SpaceVariable.h>
+#include<map>
+
+/*********************************************************************
+ * class GhostExchangeGroup updates the internal ghost layers of a group
+ * of SpaceVariable3D's (e.g., V, Phi[0], Phi[1], ..., Xi) together.
+ * The subdomain interiors of these variables are packed into a single
+ * vector (with dof = sum of the dofs), which is exchanged in one round.
+ * So, each processor sends one (larger) message per neighbor, instead
+ * of one message per variable per neighbor.
+ * Notes:
+ *   - Only variables whose ghost layers are "stale" (see SpaceVariable3D::
+ *     RestoreDataPointerAndMarkGhostsStale) are exchanged. Others are skipped.
+ *   - All the variables must have the same stencil width (i.e. ghosted1 or
+ *     ghosted2). They are created on DataManagers3D, so they share the same
+ *     domain partition.
+ *   - The packed vectors (and their DMs) are created on first use and kept
+ *     for later calls with the same total dof.
+ *********************************************************************
+*/
+
+class GhostExchangeGroup
+{
+  MPI_Comm& comm;
+
+  std::vector<SpaceVariable3D*> vars; //!< registered variables
+
+  std::vector<SpaceVariable3D*> active; //!< variables being exchanged (between Begin and End)
+  SpaceVariable3D* buffer; //!< the packed variable being exchanged (between Begin and End)
+
+  //! key: (stencil width, total dof)
+  std::map<std::pair<int,int>, DM> packed_dm;
+  std::map<std::pair<int,int>, SpaceVariable3D*> packed_var;
+
+public:
+
+  GhostExchangeGroup(MPI_Comm &comm_);
+  ~GhostExchangeGroup();
+
+  void Clear(); //!< unregisters all the variables (does not destroy the packed vectors)
+  void Add(SpaceVariable3D &V); //!< registers a variable
+  void Add(std::vector<SpaceVariable3D*> &V); //!< registers a list of variables
+
+  //! Split-phase exchange (collective). Between Begin and End, the registered variables must not be
+  //! modified or accessed with GetDataPointer() (w/ sync_ghosts = true).
+  void BeginExchange();
+  void EndExchange();
+  void Exchange() {BeginExchange(); EndExchange();}
+
+  void Destroy(); //!< must be called before PetscFinalize
+
+private:
+
+  SpaceVariable3D* GetPackedVariable(SpaceVariable3D &V0, int total_dof);
+
+};
+
+#endif
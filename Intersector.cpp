@@ -30,8 +30,8 @@ Intersector::Intersector(MPI_Comm &comm_, DataManagers3D &dms_, EmbeddedSurfaceD
              TMP(comm_, &(dms_.ghosted1_1dof)),
              TMP2(comm_, &(dms_.ghosted1_1dof)),
              CandidatesIndex_1(comm_, &(dms_.ghosted1_1dof)),
-             CandidatesIndex_n(comm_, &(dms_.ghosted1_1dof)),
              ClosestPointIndex(comm_, &(dms_.ghosted1_1dof)),
+             ClosestTriangleCache(comm_, &(dms_.ghosted1_1dof)),
              XForward(comm_, &(dms_.ghosted1_3dof)),
              XBackward(comm_, &(dms_.ghosted1_3dof)),
              Phi(comm_, &(dms_.ghosted1_1dof)),
@@ -41,8 +41,8 @@ Intersector::Intersector(MPI_Comm &comm_, DataManagers3D &dms_, EmbeddedSurfaceD
 {
 
   CandidatesIndex_1.SetConstantValue(-1, true);
-  CandidatesIndex_n.SetConstantValue(-1, true);
   ClosestPointIndex.SetConstantValue(-1, true);
+  ClosestTriangleCache.SetConstantValue(-1, true);
   XForward.SetConstantValue(-1, true);
   XBackward.SetConstantValue(-1, true);
   Color.SetConstantValue(-1, true);
@@ -64,8 +64,9 @@ Intersector::Intersector(MPI_Comm &comm_, DataManagers3D &dms_, EmbeddedSurfaceD
   intersections.reserve(capacity);
   candidates_1.reserve(capacity*2);
   scope_1.reserve(surface.elems.size());
-  candidates_n.reserve(capacity*2);
   scope_n.reserve(surface.elems.size());
+  scope_mark.assign(surface.elems.size(), 0);
+  scope_stamp = 0;
 
   //sanity checks on the triangulated surface
   if(surface.degenerate) {
@@ -109,8 +110,8 @@ Intersector::Destroy()
   TMP.Destroy();
   TMP2.Destroy();
   CandidatesIndex_1.Destroy();
-  CandidatesIndex_n.Destroy();
   ClosestPointIndex.Destroy();
+  ClosestTriangleCache.Destroy();
   XForward.Destroy();
   XBackward.Destroy();
   Phi.Destroy();
@@ -166,7 +167,7 @@ Intersector::TrackSurfaceFullCourse(bool &hasInlet_, bool &hasInlet2_, bool &has
   assert(phi_layers>=1);
 
   // This (smaller) one is for edge-surface intersections
-  BuildSubdomainScopeAndKDTree(subD_bbmin_1, subD_bbmax_1, scope_1, &tree_1);
+  BuildSubdomainScopeAndTree(subD_bbmin_1, subD_bbmax_1, scope_1, &tree_1);
 
   FindIntersections(); //using scope_1 and tree_1
 
@@ -177,7 +178,7 @@ Intersector::TrackSurfaceFullCourse(bool &hasInlet_, bool &hasInlet2_, bool &has
     BuildNodalAndSubdomainBoundingBoxes(phi_layers, BBmin_n, BBmax_n, subD_bbmin_n, subD_bbmax_n); //n layers
     nLayer = phi_layers;
   }
-  BuildSubdomainScopeAndKDTree(subD_bbmin_n, subD_bbmax_n, scope_n, &tree_n);
+  BuildSubdomainScopeAndTree(subD_bbmin_n, subD_bbmax_n, scope_n, &tree_n);
   double dist_max = CalculateUnsignedDistanceNearSurface(phi_layers);
 
   hasInlet_  = hasInlet;
@@ -215,7 +216,7 @@ Intersector::RecomputeFullCourse(vector<Vec3D> &Xprev, int phi_layers)
 {
   assert(phi_layers>=1);
 
-  BuildSubdomainScopeAndKDTree(subD_bbmin_1, subD_bbmax_1, scope_1, &tree_1);
+  BuildSubdomainScopeAndTree(subD_bbmin_1, subD_bbmax_1, scope_1, &tree_1);
   FindIntersections();
   FindSweptNodes(Xprev);
   RefillAfterSurfaceUpdate();
@@ -224,7 +225,7 @@ Intersector::RecomputeFullCourse(vector<Vec3D> &Xprev, int phi_layers)
     BuildNodalAndSubdomainBoundingBoxes(phi_layers, BBmin_n, BBmax_n, subD_bbmin_n, subD_bbmax_n); //n layers
     nLayer = phi_layers;
   }
-  BuildSubdomainScopeAndKDTree(subD_bbmin_n, subD_bbmax_n, scope_n, &tree_n);
+  BuildSubdomainScopeAndTree(subD_bbmin_n, subD_bbmax_n, scope_n, &tree_n);
   double dist_max = CalculateUnsignedDistanceNearSurface(phi_layers);
 
   return dist_max;
@@ -232,6 +233,114 @@ Intersector::RecomputeFullCourse(vector<Vec3D> &Xprev, int phi_layers)
 
 //-------------------------------------------------------------------------
 
+double
+Intersector::RecomputeIncrementally(vector<Vec3D> &Xprev, int phi_layers)
+{
+  assert(phi_layers>=1);
+
+  if(nLayer != phi_layers) //need to rebuild the nodal bounding boxes anyway
+    return RecomputeFullCourse(Xprev, phi_layers);
+
+  // Find the region affected by the moving triangles (same on all the processor cores)
+  Int3 ijk_min_1(0,0,0), ijk_max_1(0,0,0), ijk_min_n(0,0,0), ijk_max_n(0,0,0); //empty by default
+  Vec3D bbmin, bbmax;
+  if(GetSweptBoundingBox(Xprev, bbmin, bbmax)) {
+    FindNodesAffectedByBox(bbmin, bbmax, 1, ijk_min_1, ijk_max_1);
+    FindNodesAffectedByBox(bbmin, bbmax, nLayer, ijk_min_n, ijk_max_n);
+
+    // if the region is large, the incremental update would not save much
+    double affected = (double)(ijk_max_n[0]-ijk_min_n[0])*(ijk_max_n[1]-ijk_min_n[1])*(ijk_max_n[2]-ijk_min_n[2]);
+    if(affected > 0.5*(double)NX*NY*NZ)
+      return RecomputeFullCourse(Xprev, phi_layers);
+  }
+
+  BuildSubdomainScopeAndTree(subD_bbmin_1, subD_bbmax_1, scope_1, &tree_1);
+  FindIntersections(&ijk_min_1, &ijk_max_1);
+  FindSweptNodes(Xprev, &ijk_min_1, &ijk_max_1); //swept nodes must be in the affected region
+  RefillAfterSurfaceUpdate(); //only involves swept nodes
+
+  BuildSubdomainScopeAndTree(subD_bbmin_n, subD_bbmax_n, scope_n, &tree_n);
+  double dist_max = CalculateUnsignedDistanceNearSurface(phi_layers, &ijk_min_n, &ijk_max_n);
+
+  return dist_max;
+}
+
+//-------------------------------------------------------------------------
+
+bool
+Intersector::GetSweptBoundingBox(vector<Vec3D> &X0, Vec3D &bbmin, Vec3D &bbmax)
+{
+  vector<Vec3D>& Xs(surface.X);
+  vector<Int3>&  Es(surface.elems);
+  assert(X0.size() == Xs.size());
+
+  bbmin = DBL_MAX;
+  bbmax = -DBL_MAX;
+
+  bool moved = false;
+  for(auto&& nodes : Es) {
+    bool tri_moved = false;
+    for(int p=0; p<3; p++) {
+      Vec3D &x(Xs[nodes[p]]), &x0(X0[nodes[p]]);
+      if(x[0] != x0[0] || x[1] != x0[1] || x[2] != x0[2]) {
+        tri_moved = true;
+        break;
+      }
+    }
+    if(!tri_moved)
+      continue;
+
+    moved = true;
+    for(int p=0; p<3; p++)
+      for(int d=0; d<3; d++) { //the swept volume is contained in the b.b. of the two positions of the triangle
+        bbmin[d] = std::min(bbmin[d], std::min(X0[nodes[p]][d], Xs[nodes[p]][d]));
+        bbmax[d] = std::max(bbmax[d], std::max(X0[nodes[p]][d], Xs[nodes[p]][d]));
+      }
+  }
+
+  return moved;
+}
+
+//-------------------------------------------------------------------------
+
+void
+Intersector::FindNodesAffectedByBox(Vec3D &bbmin, Vec3D &bbmax, int nL, Int3 &ijk_min, Int3 &ijk_max)
+{
+  // tolerance: no smaller than those used in BuildNodalAndSubdomainBoundingBoxes and FindIntersections
+  vector<double>* xyz_glob[3]  = {&global_mesh.x_glob, &global_mesh.y_glob, &global_mesh.z_glob};
+  vector<double>* dxyz_glob[3] = {&global_mesh.dx_glob, &global_mesh.dy_glob, &global_mesh.dz_glob};
+
+  for(int d=0; d<3; d++) {
+    double dmax = *std::max_element(dxyz_glob[d]->begin(), dxyz_glob[d]->end());
+    double delta = std::max(0.1*dmax + 1.1*half_thickness, 1.5*half_thickness);
+
+    vector<double> &x(*xyz_glob[d]);
+    int lo = std::lower_bound(x.begin(), x.end(), bbmin[d] - delta) - x.begin(); //first node inside
+    int hi = std::upper_bound(x.begin(), x.end(), bbmax[d] + delta) - x.begin(); //first node beyond
+    // the b.b. of a node spans nL layers of neighbors in each direction
+    ijk_min[d] = std::max(lo - nL, 0);
+    ijk_max[d] = std::min(hi + nL, (int)x.size());
+  }
+}
+
+//-------------------------------------------------------------------------
+
+void
+Intersector::GetLocalRegion(Int3 *ijk_min, Int3 *ijk_max, Int3 &lo, Int3 &hi)
+{
+  lo = Int3(ii0_in, jj0_in, kk0_in);
+  hi = Int3(iimax_in, jjmax_in, kkmax_in);
+  if(ijk_min) {
+    assert(ijk_max);
+    for(int d=0; d<3; d++) {
+      lo[d] = std::max(lo[d], (*ijk_min)[d]);
+      hi[d] = std::min(hi[d], (*ijk_max)[d]);
+    }
+  }
+}
+
+//-------------------------------------------------------------------------
+
 void
 Intersector::BuildNodalAndSubdomainBoundingBoxes(int nL, SpaceVariable3D &BBmin, SpaceVariable3D &BBmax,
                                                  Vec3D &subD_bbmin, Vec3D &subD_bbmax)
@@ -281,13 +390,18 @@ Intersector::BuildNodalAndSubdomainBoundingBoxes(int nL, SpaceVariable3D &BBmin,
 //-------------------------------------------------------------------------
 
 void
-Intersector::BuildSubdomainScopeAndKDTree(const Vec3D &subD_bbmin, const Vec3D &subD_bbmax, 
-                                          vector<MyTriangle> &scope, KDTree<MyTriangle, 3> **tree)//updating the tree itself
+Intersector::BuildSubdomainScopeAndTree(const Vec3D &subD_bbmin, const Vec3D &subD_bbmax, 
+                                        vector<MyTriangle> &scope, BVH<MyTriangle, 3> **tree)//updating the tree itself
 {
-  scope.clear();
-
   vector<Vec3D>& Xs(surface.X);
   vector<Int3>&  Es(surface.elems);
+
+  if(scope_mark.size() != Es.size())
+    scope_mark.assign(Es.size(), scope_stamp);
+  scope_stamp++;
+
+  // find the triangles in the new scope
+  int new_size = 0;
   for(auto it = Es.begin(); it != Es.end(); it++) {
     MyTriangle tri(it - Es.begin(), Xs[(*it)[0]], Xs[(*it)[1]], Xs[(*it)[2]]);
     bool inside = true;
@@ -297,8 +411,37 @@ Intersector::BuildSubdomainScopeAndKDTree(const Vec3D &subD_bbmin, const Vec3D &
         break;
       }
     }
-    if(inside) 
-      scope.push_back(tri); //creating a copy of "tri" and store it in scope
+    if(inside) {
+      scope_mark[it - Es.begin()] = scope_stamp;
+      new_size++;
+    }
+  }
+
+  // check whether the scope has changed
+  bool same_scope = (*tree != NULL) && (new_size == (int)scope.size());
+  if(same_scope) {
+    for(auto&& tri : scope)
+      if(scope_mark[tri.trId()] != scope_stamp) {
+        same_scope = false;
+        break;
+      }
+  }
+
+  if(same_scope) {
+    // update the triangles in place (their order is set by the tree) and refit the tree
+    for(auto&& tri : scope) {
+      Int3 &nodes(Es[tri.trId()]);
+      tri = MyTriangle(tri.trId(), Xs[nodes[0]], Xs[nodes[1]], Xs[nodes[2]]);
+    }
+    double quality = (*tree)->Refit(); //SAH cost relative to that of the original tree
+    if(quality < 1.5) //otherwise, rebuild the tree
+      return;
+  }
+  else {
+    scope.clear();
+    for(int e=0; e<(int)Es.size(); e++)
+      if(scope_mark[e] == scope_stamp)
+        scope.push_back(MyTriangle(e, Xs[Es[e][0]], Xs[Es[e][1]], Xs[Es[e][2]]));
   }
 
 //  fprintf(stdout,"scope size: %d.\n", (int)scope.size());
@@ -308,7 +451,7 @@ Intersector::BuildSubdomainScopeAndKDTree(const Vec3D &subD_bbmin, const Vec3D &
     delete *tree;
 
   if(scope.size()!=0)
-    *tree = new KDTree<MyTriangle,3>(scope.size(), scope.data());
+    *tree = new BVH<MyTriangle,3>(scope.size(), scope.data());
   else
     *tree = NULL;
 }
@@ -316,12 +459,14 @@ Intersector::BuildSubdomainScopeAndKDTree(const Vec3D &subD_bbmin, const Vec3D &
 //-------------------------------------------------------------------------
 
 void
-Intersector::FindNodalCandidates(SpaceVariable3D &BBmin, SpaceVariable3D &BBmax, KDTree<MyTriangle, 3> *tree,
+Intersector::FindNodalCandidates(SpaceVariable3D &BBmin, SpaceVariable3D &BBmax, BVH<MyTriangle, 3> *tree,
                                  SpaceVariable3D &CandidatesIndex, 
-                                 vector<pair<Int3, vector<MyTriangle> > > &candidates)
+                                 vector<pair<Int3, vector<MyTriangle> > > &candidates,
+                                 Int3 *ijk_min, Int3 *ijk_max)
 {
 
-  candidates.clear();
+  if(!ijk_min)
+    candidates.clear();
 
   int nMaxCand = 1000; //will increase if necessary
 
@@ -332,9 +477,11 @@ Intersector::FindNodalCandidates(SpaceVariable3D &BBmin, SpaceVariable3D &BBmax,
   vector<MyTriangle> tmp(nMaxCand);
   
   // Work on all nodes inside the physical domain, including internal ghost layer
-  for(int k=kk0_in; k<kkmax_in; k++)
-    for(int j=jj0_in; j<jjmax_in; j++)
-      for(int i=ii0_in; i<iimax_in; i++) {
+  Int3 lo, hi;
+  GetLocalRegion(ijk_min, ijk_max, lo, hi);
+  for(int k=lo[2]; k<hi[2]; k++)
+    for(int j=lo[1]; j<hi[1]; j++)
+      for(int i=lo[0]; i<hi[0]; i++) {
 
         // find candidates
         int nFound = tree ? FindCandidatesInBox(tree, bbmin[k][j][i], bbmax[k][j][i], tmp, nMaxCand) : 0;
@@ -353,6 +500,21 @@ Intersector::FindNodalCandidates(SpaceVariable3D &BBmin, SpaceVariable3D &BBmax,
 
       }
 
+  if(ijk_min) { //remove outdated entries (i.e. no longer pointed to by CandidatesIndex)
+    int n = 0;
+    for(int m=0; m<(int)candidates.size(); m++) {
+      Int3 ijk = candidates[m].first;
+      if(candid[ijk[2]][ijk[1]][ijk[0]] != m)
+        continue;
+      if(n != m) {
+        candidates[n] = std::move(candidates[m]);
+        candid[ijk[2]][ijk[1]][ijk[0]] = n;
+      }
+      n++;
+    }
+    candidates.resize(n);
+  }
+
   BBmin.RestoreDataPointerToLocalVector();
   BBmax.RestoreDataPointerToLocalVector();
   CandidatesIndex.RestoreDataPointerToLocalVector(); //can NOT communicate, because "candidates" do not.
@@ -362,11 +524,14 @@ Intersector::FindNodalCandidates(SpaceVariable3D &BBmin, SpaceVariable3D &BBmax,
 //-------------------------------------------------------------------------
 
 void
-Intersector::FindIntersections() //also finds occluded and first layer nodes
+Intersector::FindIntersections(Int3 *ijk_min, Int3 *ijk_max) //also finds occluded and first layer nodes
 {
 
   // Find nodal candidates, layer = 1
-  FindNodalCandidates(BBmin_1, BBmax_1, tree_1, CandidatesIndex_1, candidates_1);
+  FindNodalCandidates(BBmin_1, BBmax_1, tree_1, CandidatesIndex_1, candidates_1, ijk_min, ijk_max);
+
+  Int3 lo, hi; //nodes to be updated
+  GetLocalRegion(ijk_min, ijk_max, lo, hi);
 
 
   Vec3D*** coords  = (Vec3D***) coordinates.GetDataPointer();
@@ -379,7 +544,8 @@ Intersector::FindIntersections() //also finds occluded and first layer nodes
   double*** layer  = TMP2.GetDataPointer(); //"layer" of each node: 0(occluded), 1, or -1 (unknown)
 
   //Clear previous values
-  intersections.clear();
+  if(!ijk_min)
+    intersections.clear(); //otherwise, outdated ones are removed at the end
 
   previously_occluded_but_not_now.clear();
 
@@ -410,23 +576,26 @@ Intersector::FindIntersections() //also finds occluded and first layer nodes
   // ----------------------------------------------------------------------------
   // Find occluded nodes and intersections. Build occluded and firstLayer 
   // ----------------------------------------------------------------------------
-  firstLayer.clear();
   // We only deal with edges whose vertices are both in the real domain
-  for(int k=kk0_in; k<kkmax_in; k++)
-    for(int j=jj0_in; j<jjmax_in; j++)
-      for(int i=ii0_in; i<iimax_in; i++) {
+  for(int k=lo[2]; k<hi[2]; k++)
+    for(int j=lo[1]; j<hi[1]; j++)
+      for(int i=lo[0]; i<hi[0]; i++) {
   
         // start with a meaningless triangle id
         occid[k][j][i] = -1;
 
         layer[k][j][i] = -1;
 
-        if(!tree_1) //this subdomain is entirely away from surface, just set color, occid, and layer to default values
+        if(!tree_1) { //this subdomain is entirely away from surface, just set color, occid, and layer to default values
+          xf[k][j][i] = xb[k][j][i] = -1;
           continue; 
+        }
 
         if(k<kmax && j<jmax && i<imax && //candid has a valid value @ i,j,k
-           candid[k][j][i] < 0)  //no nodal candidates, intersection impossible, occlusion also impossible
+           candid[k][j][i] < 0) { //no nodal candidates, intersection impossible, occlusion also impossible
+          xf[k][j][i] = xb[k][j][i] = -1;
           continue;
+        }
  
 
         //--------------------------------------------
@@ -550,6 +719,21 @@ Intersector::FindIntersections() //also finds occluded and first layer nodes
 
       }
 
+  if(ijk_min) {
+    // Edges that connect a node in the region to a node outside are not affected by the motion. If they are
+    // processed by the outside node, their intersections are kept, but the "layer" of the inside node must be set.
+    for(int k=lo[2]; k<hi[2]; k++)
+      for(int j=lo[1]; j<hi[1]; j++)
+        for(int i=lo[0]; i<hi[0]; i++) {
+          if(layer[k][j][i] != -1)
+            continue;
+          if((i+1==hi[0] && i+1<iimax_in && xf[k][j][i+1][0]>=0) ||
+             (j+1==hi[1] && j+1<jjmax_in && xf[k][j+1][i][1]>=0) ||
+             (k+1==hi[2] && k+1<kkmax_in && xf[k+1][j][i][2]>=0))
+            layer[k][j][i] = 1;
+        }
+  }
+
   // Exchange Color and TMP so internal ghost nodes are accounted for
   CandidatesIndex_1.RestoreDataPointerToLocalVector();
   Color.RestoreDataPointerAndInsert();
@@ -562,9 +746,9 @@ Intersector::FindIntersections() //also finds occluded and first layer nodes
   // Make sure all edges connected to occluded nodes have intersections
   // ----------------------------------------------------------------------------
   bool ijk_occluded;
-  for(int k=kk0_in; k<kkmax_in; k++)
-    for(int j=jj0_in; j<jjmax_in; j++)
-      for(int i=ii0_in; i<iimax_in; i++) {
+  for(int k=lo[2]; k<hi[2]; k++)
+    for(int j=lo[1]; j<hi[1]; j++)
+      for(int i=lo[0]; i<hi[0]; i++) {
  
         ijk_occluded = (occid[k][j][i]>=0);
         if(i-1>=ii0_in) { //left edge within physical domain
@@ -761,6 +945,24 @@ Intersector::FindIntersections() //also finds occluded and first layer nodes
 
   TMP.RestoreDataPointerToLocalVector();
 
+  if(ijk_min) { //remove outdated intersections (i.e. not registered in XForward or XBackward)
+    int n = 0;
+    for(int m=0; m<(int)intersections.size(); m++) {
+      IntersectionPoint &p(intersections[m]);
+      Int3 ijk = p.n0; //the edge is stored at its right/top/front vertex
+      ijk[p.dir]++;
+      Vec3D &f(xf[ijk[2]][ijk[1]][ijk[0]]), &b(xb[ijk[2]][ijk[1]][ijk[0]]);
+      if(f[p.dir] != m && b[p.dir] != m)
+        continue;
+      if(f[p.dir] == m) f[p.dir] = n;
+      if(b[p.dir] == m) b[p.dir] = n;
+      if(n != m)
+        intersections[n] = p;
+      n++;
+    }
+    intersections.resize(n);
+  }
+
   XForward.RestoreDataPointerToLocalVector(); //Cannot exchange data, because "intersections" does not communicate
   XBackward.RestoreDataPointerToLocalVector(); //Cannot exchange data, because "intersections" does not communicate
 
@@ -776,14 +978,23 @@ Intersector::FindIntersections() //also finds occluded and first layer nodes
   // ----------------------------------------------------------------------------
   // Build the sets of occluded and firstLayer nodes. Include internal ghost nodes
   // ----------------------------------------------------------------------------
-  occluded.clear();
-  firstLayer.clear();
+  if(ijk_min) {
+    auto inside = [&](const Int3 &ijk) {
+      return ijk[0]>=lo[0] && ijk[0]<hi[0] && ijk[1]>=lo[1] && ijk[1]<hi[1] && ijk[2]>=lo[2] && ijk[2]<hi[2];};
+    for(auto it = occluded.begin(); it != occluded.end();)
+      it = inside(*it) ? occluded.erase(it) : std::next(it);
+    for(auto it = firstLayer.begin(); it != firstLayer.end();)
+      it = inside(*it) ? firstLayer.erase(it) : std::next(it);
+  } else {
+    occluded.clear();
+    firstLayer.clear();
+  }
 
   layer  = TMP2.GetDataPointer(); //"layer" of each node: 0(occluded), 1, or -1 (unknown)
 
-  for(int k=kk0_in; k<kkmax_in; k++)
-    for(int j=jj0_in; j<jjmax_in; j++)
-      for(int i=ii0_in; i<iimax_in; i++) {
+  for(int k=lo[2]; k<hi[2]; k++)
+    for(int j=lo[1]; j<hi[1]; j++)
+      for(int i=lo[0]; i<hi[0]; i++) {
         if(layer[k][j][i]==0) {
           occluded.insert(Int3(i,j,k));         
           firstLayer.insert(Int3(i,j,k));
@@ -806,7 +1017,7 @@ Intersector::FindIntersections() //also finds occluded and first layer nodes
 //-------------------------------------------------------------------------
 
 int
-Intersector::FindCandidatesInBox(KDTree<MyTriangle, 3>* mytree, Vec3D bbmin, Vec3D bbmax, 
+Intersector::FindCandidatesInBox(BVH<MyTriangle, 3>* mytree, Vec3D bbmin, Vec3D bbmax, 
                                  vector<MyTriangle> &tmp, int& maxCand)
 {
   int found = mytree->findCandidatesInBox(bbmin, bbmax, tmp.data(), maxCand);
@@ -829,13 +1040,32 @@ Intersector::IsPointOccludedByTriangles(Vec3D &x0, MyTriangle* tri, int nTri, do
   vector<Vec3D>&  Ns(surface.elemNorm);
   vector<double>& As(surface.elemArea); 
 
-  for(int i=0; i<nTri; i++) {
-    int id = tri[i].trId();
-    Int3& nodes(Es[id]);
-    if(GeoTools::IsPointInsideTriangle(x0, Xs[nodes[0]], Xs[nodes[1]], Xs[nodes[2]], my_half_thickness,
-                                       &As[id], &Ns[id], xi)) {
-      tid = id;
-      return true;
+  // Triangles are processed in blocks. Distances to their planes are computed together (SIMD), which
+  // rules out most of them. The full check is done only for the remaining ones, in the original order.
+  GeoTools::TriangleBlock block;
+  double plane_dist[GeoTools::TriangleBlock::capacity];
+
+  for(int first=0; first<nTri; first+=GeoTools::TriangleBlock::capacity) {
+
+    int last = std::min(first + GeoTools::TriangleBlock::capacity, nTri);
+    block.size = 0;
+    for(int i=first; i<last; i++) {
+      int id = tri[i].trId();
+      Int3& nodes(Es[id]);
+      block.Add(Xs[nodes[0]], Xs[nodes[1]], Xs[nodes[2]], &Ns[id]);
+    }
+    GeoTools::DistancesToTrianglePlanes(x0, block, plane_dist);
+
+    for(int i=first; i<last; i++) {
+      if(fabs(plane_dist[i-first])>my_half_thickness)
+        continue; //same as the first check in IsPointInsideTriangle
+      int id = tri[i].trId();
+      Int3& nodes(Es[id]);
+      if(GeoTools::IsPointInsideTriangle(x0, Xs[nodes[0]], Xs[nodes[1]], Xs[nodes[2]], my_half_thickness,
+                                         &As[id], &Ns[id], xi)) {
+        tid = id;
+        return true;
+      }
     }
   }
 
@@ -1199,7 +1429,7 @@ Intersector::RefillAfterSurfaceUpdate()
 //-------------------------------------------------------------------------
  
 void
-Intersector::FindSweptNodes(std::vector<Vec3D> &X0)
+Intersector::FindSweptNodes(std::vector<Vec3D> &X0, Int3 *ijk_min, Int3 *ijk_max)
 {
   
   vector<double> &x_glob(global_mesh.x_glob);
@@ -1217,6 +1447,9 @@ Intersector::FindSweptNodes(std::vector<Vec3D> &X0)
 
   double collision_time;
 
+  Int3 lo, hi;
+  GetLocalRegion(ijk_min, ijk_max, lo, hi);
+
   int i,j,k;
   for(auto it = firstLayer.begin(); it != firstLayer.end(); it++) {
     if(occluded.find(*it) != occluded.end())
@@ -1226,6 +1459,9 @@ Intersector::FindSweptNodes(std::vector<Vec3D> &X0)
     j = (*it)[1];
     k = (*it)[2];
 
+    if(i<lo[0] || i>=hi[0] || j<lo[1] || j>=hi[1] || k<lo[2] || k>=hi[2])
+      continue; //not affected by the motion of the surface
+
     assert(candid[k][j][i]>=0);
     vector<MyTriangle> &cands(candidates_1[candid[k][j][i]].second);
     assert(cands.size()>0);
@@ -1259,14 +1495,15 @@ Intersector::FindSweptNodes(std::vector<Vec3D> &X0)
 //-------------------------------------------------------------------------
 
 double
-Intersector::CalculateUnsignedDistanceNearSurface(int nL)
+Intersector::CalculateUnsignedDistanceNearSurface(int nL, Int3 *ijk_min, Int3 *ijk_max)
 {
 
   assert(nLayer = nL);
 
   double max_dist = -DBL_MAX;
 
-  FindNodalCandidates(BBmin_n, BBmax_n, tree_n, CandidatesIndex_n, candidates_n);
+  Int3 lo, hi; //nodes to be updated
+  GetLocalRegion(ijk_min, ijk_max, lo, hi);
 
   vector<double> &x_glob(global_mesh.x_glob);
   vector<double> &y_glob(global_mesh.y_glob);
@@ -1274,19 +1511,22 @@ Intersector::CalculateUnsignedDistanceNearSurface(int nL)
 
   Phi_nLayer = nLayer;
 
-  double*** candid = CandidatesIndex_n.GetDataPointer();
+  Vec3D*** bbmin   = (Vec3D***) BBmin_n.GetDataPointer();
+  Vec3D*** bbmax   = (Vec3D***) BBmax_n.GetDataPointer();
   double*** phi    = Phi.GetDataPointer();
   double*** cpi    = ClosestPointIndex.GetDataPointer();
+  double*** ctri   = ClosestTriangleCache.GetDataPointer();
   
   // set const. value to phi, by default
   double default_distance = domain_diagonal;
-  for(int k=kk0_in; k<kkmax_in; k++)
-    for(int j=jj0_in; j<jjmax_in; j++)
-      for(int i=ii0_in; i<iimax_in; i++) {
+  for(int k=lo[2]; k<hi[2]; k++)
+    for(int j=lo[1]; j<hi[1]; j++)
+      for(int i=lo[0]; i<hi[0]; i++) {
         phi[k][j][i] = default_distance;
         cpi[k][j][i] = -1;
       }
-  closest_points.clear();
+  if(!ijk_min)
+    closest_points.clear(); //otherwise, outdated ones are removed at the end
 
   assert(nLayer>=1);
 
@@ -1295,7 +1535,85 @@ Intersector::CalculateUnsignedDistanceNearSurface(int nL)
   vector<Int3>&   Es(surface.elems);
   vector<Vec3D>&  Ns(surface.elemNorm);
   vector<double>& As(surface.elemArea); 
-  std::set<Int3> this_layer = firstLayer;
+  std::set<Int3> this_layer;
+
+  GeoTools::TriangleBlock block;
+  double plane_dist[GeoTools::TriangleBlock::capacity];
+  double xi[3];
+
+  //! updates (dist, cp) if triangle "id" is closer to x
+  auto project = [&](Vec3D &x, int id, double &dist, ClosestPoint &cp) {
+    Int3 &nodes(Es[id]);
+    double new_dist = GeoTools::ProjectPointToTriangle(x, Xs[nodes[0]], Xs[nodes[1]], Xs[nodes[2]], xi,
+                                                       &(As[id]), &(Ns[id]), false);
+    if(new_dist<dist) {
+      dist = new_dist;
+      cp.tid = id;
+      cp.dist = new_dist;
+      for(int s=0; s<3; s++)
+        cp.xi[s] = xi[s];
+    }
+  };
+
+  //! finds the closest among the candidates. The distances to the planes of the triangles (lower bounds)
+  //! are computed block by block (SIMD). Triangles farther than the current closest one are skipped.
+  auto find_closest = [&](Vec3D &x, MyTriangle *cands, int nCands, double &dist, ClosestPoint &cp) {
+    for(int first=0; first<nCands; first+=GeoTools::TriangleBlock::capacity) {
+      int last = std::min(first + GeoTools::TriangleBlock::capacity, nCands);
+      block.size = 0;
+      for(int tri=first; tri<last; tri++) {
+        int id = cands[tri].trId();
+        Int3 &nodes(Es[id]);
+        block.Add(Xs[nodes[0]], Xs[nodes[1]], Xs[nodes[2]], &Ns[id]);
+      }
+      GeoTools::DistancesToTrianglePlanes(x, block, plane_dist);
+      for(int tri=first; tri<last; tri++)
+        if(fabs(plane_dist[tri-first]) <= dist) //otherwise, cannot be closer
+          project(x, cands[tri].trId(), dist, cp);
+    }
+  };
+
+  int nMaxCand = 1000; //will increase if necessary
+  vector<MyTriangle> cands(nMaxCand);
+  double box_tol = 1.0e-10*domain_diagonal; //round-off
+
+  //! searches the candidates in the node's b.b. from scratch (no warm start). Returns the distance.
+  auto cold_search = [&](Vec3D &x, Vec3D &bmin, Vec3D &bmax, ClosestPoint *cp) {
+    double dist = DBL_MAX;
+    ClosestPoint cp0(-1,DBL_MAX,xi);
+    int nFound = tree_n ? FindCandidatesInBox(tree_n, bmin, bmax, cands, nMaxCand) : 0;
+    assert(nFound>0);
+    find_closest(x, cands.data(), nFound, dist, cp ? *cp : cp0);
+    return dist;
+  };
+
+  // In the case of a partial update, nodes in the region may be reached from first layer nodes outside of it
+  // (within nLayer-1 layers). These nodes are traversed, but their Phi is not recomputed.
+  Int3 ext_lo(lo), ext_hi(hi);
+  std::set<Int3> visited;
+  if(ijk_min) {
+    for(int d=0; d<3; d++) {
+      ext_lo[d] = std::max(lo[d] - (nLayer-1), d==0 ? ii0_in : d==1 ? jj0_in : kk0_in);
+      ext_hi[d] = std::min(hi[d] + (nLayer-1), d==0 ? iimax_in : d==1 ? jjmax_in : kkmax_in);
+    }
+    for(auto&& ijk : firstLayer)
+      if(ijk[0]>=ext_lo[0] && ijk[0]<ext_hi[0] && ijk[1]>=ext_lo[1] && ijk[1]<ext_hi[1] &&
+         ijk[2]>=ext_lo[2] && ijk[2]<ext_hi[2])
+        this_layer.insert(ijk);
+    visited = this_layer;
+  } else
+    this_layer = firstLayer;
+
+  auto in_region = [&](int i, int j, int k) {
+    return i>=lo[0] && i<hi[0] && j>=lo[1] && j<hi[1] && k>=lo[2] && k<hi[2];};
+
+  //! returns whether (i,j,k) should be added to the next layer
+  auto not_yet_visited = [&](int i, int j, int k, double bar) {
+    if(!ijk_min)
+      return phi[k][j][i] >= bar;
+    if(i<ext_lo[0] || i>=ext_hi[0] || j<ext_lo[1] || j>=ext_hi[1] || k<ext_lo[2] || k>=ext_hi[2])
+      return false;
+    return visited.insert(Int3(i,j,k)).second;};
 
   for(int layer=1; layer<=nLayer; layer++) {
 
@@ -1303,37 +1621,60 @@ Intersector::CalculateUnsignedDistanceNearSurface(int nL)
 
     int i,j,k;
     double bar = 0.99*default_distance;
-    double xi[3];
     for(auto it = this_layer.begin(); it != this_layer.end(); it++) {
 
       i = (*it)[0];
       j = (*it)[1];
       k = (*it)[2];
 
-      assert(candid[k][j][i]>=0);
-      vector<MyTriangle> &cands(candidates_n[candid[k][j][i]].second);
-      assert(cands.size()>0);
+      if(ijk_min && !in_region(i,j,k)) { //Phi is up-to-date
+        if(layer<nLayer) {
+          if(i-1>=ii0_in  && not_yet_visited(i-1,j,k,bar)) next_layer.insert(Int3(i-1,j,k));
+          if(i+1<iimax_in && not_yet_visited(i+1,j,k,bar)) next_layer.insert(Int3(i+1,j,k));
+          if(j-1>=jj0_in  && not_yet_visited(i,j-1,k,bar)) next_layer.insert(Int3(i,j-1,k));
+          if(j+1<jjmax_in && not_yet_visited(i,j+1,k,bar)) next_layer.insert(Int3(i,j+1,k));
+          if(k-1>=kk0_in  && not_yet_visited(i,j,k-1,bar)) next_layer.insert(Int3(i,j,k-1));
+          if(k+1<kkmax_in && not_yet_visited(i,j,k+1,bar)) next_layer.insert(Int3(i,j,k+1));
+        }
+        continue;
+      }
 
-      double dist = DBL_MAX, new_dist;
+      double dist = DBL_MAX;
       ClosestPoint cp(-1,DBL_MAX,xi); //initialize to garbage
 
-      int id;
-      for(int tri=0; tri<(int)cands.size(); tri++) {
-        id = cands[tri].trId();
-        Int3 &nodes(Es[id]);
-        Vec3D coords(x_glob[i], y_glob[j], z_glob[k]); //inside physical domain (safe)
-        
-        new_dist = GeoTools::ProjectPointToTriangle(coords, Xs[nodes[0]], Xs[nodes[1]], Xs[nodes[2]], xi,
-                                                    &(As[id]), &(Ns[id]), false);
-        if(new_dist<dist) {
-          dist = new_dist;
-          cp.tid = id;
-          cp.dist = new_dist;
-          for(int s=0; s<3; s++)
-            cp.xi[s] = xi[s];
-        }
+      Vec3D coords(x_glob[i], y_glob[j], z_glob[k]); //inside physical domain (safe)
+
+      // Warm start: The closest triangle usually does not change (much) between time steps. The previous
+      // closest triangle and its one-ring neighbors give a (tight) upper bound of the distance. The result
+      // does not depend on it (i.e. same as a cold start, e.g., after a restart).
+      int tid0 = ctri[k][j][i];
+      if(tid0>=0 && tid0<(int)Es.size())
+        for(auto&& tri : surface.elem2elem[tid0]) //includes tid0 itself
+          project(coords, tri, dist, cp);
+
+      // Any triangle within distance r of the node intersects the node's b.b. (and is in scope_n)
+      double r = DBL_MAX;
+      for(int d=0; d<3; d++)
+        r = std::min(r, std::min(coords[d] - bbmin[k][j][i][d], bbmax[k][j][i][d] - coords[d]));
+
+      if(dist<=r) {
+        // The closest triangle is no farther than "dist". Only the (usually much smaller) box of half-width
+        // "dist" needs to be searched, which gives the same result as searching the node's b.b.
+        Vec3D qmin(coords), qmax(coords);
+        qmin -= dist + box_tol;
+        qmax += dist + box_tol;
+        int nFound = FindCandidatesInBox(tree_n, qmin, qmax, cands, nMaxCand);
+        assert(nFound>0);
+        find_closest(coords, cands.data(), nFound, dist, cp);
+
+        // verification (debug mode only)
+        assert(fabs(cold_search(coords, bbmin[k][j][i], bbmax[k][j][i], NULL) - dist) <= box_tol);
       }
+      else //the warm-start triangles may not be candidates of this node --> discarded
+        dist = cold_search(coords, bbmin[k][j][i], bbmax[k][j][i], &cp);
+
       phi[k][j][i] = dist;
+      ctri[k][j][i] = cp.tid;
       closest_points.push_back(std::make_pair(*it, cp));
       cpi[k][j][i] = closest_points.size() - 1;
 
@@ -1349,22 +1690,40 @@ Intersector::CalculateUnsignedDistanceNearSurface(int nL)
       //insert neighbors to the next layer
       if(layer<nLayer) {
         assert(dist < bar);
-        if(i-1>=ii0_in  && phi[k][j][i-1] >= bar) next_layer.insert(Int3(i-1,j,k));
-        if(i+1<iimax_in && phi[k][j][i+1] >= bar) next_layer.insert(Int3(i+1,j,k));
-        if(j-1>=jj0_in  && phi[k][j-1][i] >= bar) next_layer.insert(Int3(i,j-1,k));
-        if(j+1<jjmax_in && phi[k][j+1][i] >= bar) next_layer.insert(Int3(i,j+1,k));
-        if(k-1>=kk0_in  && phi[k-1][j][i] >= bar) next_layer.insert(Int3(i,j,k-1));
-        if(k+1<kkmax_in && phi[k+1][j][i] >= bar) next_layer.insert(Int3(i,j,k+1));
+        if(i-1>=ii0_in  && not_yet_visited(i-1,j,k,bar)) next_layer.insert(Int3(i-1,j,k));
+        if(i+1<iimax_in && not_yet_visited(i+1,j,k,bar)) next_layer.insert(Int3(i+1,j,k));
+        if(j-1>=jj0_in  && not_yet_visited(i,j-1,k,bar)) next_layer.insert(Int3(i,j-1,k));
+        if(j+1<jjmax_in && not_yet_visited(i,j+1,k,bar)) next_layer.insert(Int3(i,j+1,k));
+        if(k-1>=kk0_in  && not_yet_visited(i,j,k-1,bar)) next_layer.insert(Int3(i,j,k-1));
+        if(k+1<kkmax_in && not_yet_visited(i,j,k+1,bar)) next_layer.insert(Int3(i,j,k+1));
       }
     }
 
     this_layer = next_layer;
   }
 
+  if(ijk_min) { //remove outdated closest points, and find max_dist among all the nodes
+    int n = 0;
+    for(int m=0; m<(int)closest_points.size(); m++) {
+      Int3 ijk = closest_points[m].first;
+      if(cpi[ijk[2]][ijk[1]][ijk[0]] != m)
+        continue;
+      if(n != m) {
+        closest_points[n] = closest_points[m];
+        cpi[ijk[2]][ijk[1]][ijk[0]] = n;
+      }
+      max_dist = std::max(max_dist, closest_points[n].second.dist);
+      n++;
+    }
+    closest_points.erase(closest_points.begin()+n, closest_points.end());
+  }
+
   MPI_Allreduce(MPI_IN_PLACE, &max_dist, 1, MPI_DOUBLE, MPI_MAX, comm);
 
-  CandidatesIndex_n.RestoreDataPointerToLocalVector();
+  BBmin_n.RestoreDataPointerToLocalVector();
+  BBmax_n.RestoreDataPointerToLocalVector();
   ClosestPointIndex.RestoreDataPointerToLocalVector(); //cannot communicate, because "closest_points" do not.
+  ClosestTriangleCache.RestoreDataPointerToLocalVector();
   Phi.RestoreDataPointerAndInsert(); 
 
   return max_dist;
@@ -1431,7 +1790,7 @@ Intersector::FindColorBoundary(int this_color, std::vector<int> &status)
       local_scope.push_back(e);
   }
 
-  KDTree<MyTriangle,3> global_tree(global_scope.size(), global_scope.data());
+  BVH<MyTriangle,3> global_tree(global_scope.size(), global_scope.data());
  
 
   // Step 3. Check both sides 
@@ -1548,15 +1907,30 @@ Intersector::FindEdgeIntersectionsWithTriangles(Vec3D &x0, int i, int j, int k,
 
   vector<pair<double, IntersectionPoint> > X; //pairs distance with intersection point info
 
-  double dist;
-  Vec3D xi; //barycentric coords of the projection point
-  for(int iTri=0; iTri<nTri; iTri++) {
-    int id = tri[iTri].trId();
-    Int3& nodes(Es[id]);
-    bool found = GeoTools::LineSegmentIntersectsTriangle(x0, dir, len, Xs[nodes[0]], Xs[nodes[1]], Xs[nodes[2]],
-                                                         &dist, NULL, &xi);
-    if(found) //store the result
-      X.push_back(std::make_pair(dist, IntersectionPoint(i,j,k,dir,dist,id,xi)));
+  // The edge is tested against blocks of triangles (SIMD)
+  GeoTools::TriangleBlock block;
+  int hit[GeoTools::TriangleBlock::capacity];
+  double dist[GeoTools::TriangleBlock::capacity];
+  double u[GeoTools::TriangleBlock::capacity], v[GeoTools::TriangleBlock::capacity];
+
+  for(int first=0; first<nTri; first+=GeoTools::TriangleBlock::capacity) {
+
+    int last = std::min(first + GeoTools::TriangleBlock::capacity, nTri);
+    block.size = 0;
+    for(int iTri=first; iTri<last; iTri++) {
+      Int3& nodes(Es[tri[iTri].trId()]);
+      block.Add(Xs[nodes[0]], Xs[nodes[1]], Xs[nodes[2]]);
+    }
+
+    if(GeoTools::LineSegmentIntersectsTriangles(x0, dir, len, block, hit, dist, u, v) == 0)
+      continue;
+
+    for(int t=0; t<block.size; t++) {
+      if(!hit[t])
+        continue;
+      Vec3D xi(1.0-u[t]-v[t], u[t], v[t]); //barycentric coords of the intersection point
+      X.push_back(std::make_pair(dist[t], IntersectionPoint(i,j,k,dir,dist[t],tri[first+t].trId(),xi)));
+    }
   }
 
   if(X.empty())
@@ -1589,7 +1963,7 @@ Intersector::Intersects(Vec3D &X0, Vec3D &X1)
 
   assert(nLayer>=1);
 
-  // Step 1: Find candidates using the KDTree
+  // Step 1: Find candidates using the BVH
   Vec3D bmin(std::min(X0[0],X1[0]), std::min(X0[1],X1[1]), std::min(X0[2],X1[2]));
   Vec3D bmax(std::max(X0[0],X1[0]), std::max(X0[1],X1[1]), std::max(X0[2],X1[2]));
   bmin -= half_thickness;
@@ -8,6 +8,7 @@
 
 #include<IoData.h>
 #include<KDTree.h>
+#include<BoundingVolumeHierarchy.h>
 #include<TriangulatedSurface.h>
 #include<FloodFill.h>
 #include<EmbeddedBoundaryDataSet.h>
@@ -91,18 +92,22 @@ class Intersector {
   Vec3D subD_bbmin_1, subD_bbmax_1; //!< bounding box of the subdomain (n layers, n TBD)
 
   std::vector<MyTriangle> scope_1; //!< triangles relevant to the current subdomain (no tol for the BB of triangles)
-  KDTree<MyTriangle, 3> *tree_1; //!< a KDTree that organizes the triangles in scope (does not store its own copy)
+  BVH<MyTriangle, 3> *tree_1; //!< a BVH that organizes the triangles in scope (does not store its own copy)
 
 
   //! Infrastructure #2. N(>1) layer of neighbors
   SpaceVariable3D BBmin_n, BBmax_n; 
   Vec3D subD_bbmin_n, subD_bbmax_n;
   std::vector<MyTriangle> scope_n;
-  KDTree<MyTriangle, 3> *tree_n;
+  BVH<MyTriangle, 3> *tree_n;
   int nLayer; //!< number of layers of neighbors included in the b.b. In most cases, should = Phi_nLayer
 
+  //! For detecting changes of scope (size: surface.elems.size()). Element e is in the new scope iff scope_mark[e]==scope_stamp
+  std::vector<int> scope_mark;
+  int scope_stamp;
 
-  SpaceVariable3D TMP, TMP2; //!< For temporary use.
+
+  SpaceVariable3D TMP, TMP2; //!< Occluding triangle id and "layer" of each node. Kept for incremental updates.
 
   /************************
    * Results
@@ -111,8 +116,6 @@ class Intersector {
   SpaceVariable3D CandidatesIndex_1; //!< index in the vector "candidates" (-1 means no candidates)
   std::vector<std::pair<Int3, std::vector<MyTriangle> > > candidates_1;
 
-  SpaceVariable3D CandidatesIndex_n;
-  std::vector<std::pair<Int3, std::vector<MyTriangle> > > candidates_n;
 
 
 
@@ -138,6 +141,9 @@ class Intersector {
   //! Closest point on triangle (for near-field nodes inside subdomain, including internal ghosts nodes)
   SpaceVariable3D ClosestPointIndex; //!< index in the vector closest_points. (-1 means not available)
   std::vector<std::pair<Int3, ClosestPoint> > closest_points;
+  //! Closest triangle found for each node in the latest calculation (-1: none). Kept across time steps (warm start).
+  //! Only used to speed up the search; Phi and closest_points do not depend on it (so it is not saved for restart).
+  SpaceVariable3D ClosestTriangleCache;
 
   //! "intersections" stores edge-surface intersections where at least one vertex of the edge is inside the subdomain
   std::vector<IntersectionPoint> intersections; /**< NOTE: Not all these intersections are registered in XForward \n
@@ -183,6 +189,10 @@ public:
 
   double RecomputeFullCourse(std::vector<Vec3D> &X0, int phi_layers); 
 
+  /** Same results as RecomputeFullCourse, but only re-evaluates nodes and edges in the region affected by the
+   *  triangles that have moved (i.e. their swept volumes). Results elsewhere (including colors) are reused.*/
+  double RecomputeIncrementally(std::vector<Vec3D> &X0, int phi_layers);
+
 
 /** Below is like the a la carte menu. Try to use the pre-defined "combos" above as much as you can. 
  *  The functions below are not all independent with each other!*/
@@ -191,22 +201,29 @@ public:
   void BuildNodalAndSubdomainBoundingBoxes(int nL, SpaceVariable3D &BBmin, SpaceVariable3D &BBmax,
                                            Vec3D &subD_bbmin, Vec3D &subD_bbmax); //!< build bounding boxes
 
-  void BuildSubdomainScopeAndKDTree(const Vec3D &subD_bbmin, const Vec3D &subD_bbmax,
-                                    std::vector<MyTriangle> &scope, KDTree<MyTriangle, 3> **tree); //!< Requires bounding box
+  /** Requires bounding box. If the triangles in scope are the same as before, the existing tree is refitted
+   *  to the new triangle positions, and only rebuilt if its quality (SAH cost) has degraded too much.*/
+  void BuildSubdomainScopeAndTree(const Vec3D &subD_bbmin, const Vec3D &subD_bbmax,
+                                  std::vector<MyTriangle> &scope, BVH<MyTriangle, 3> **tree);
 
   //! Many functions below assume that bounding boxes, scope, and tree have already been constructed.
 
-  //! find nearby triangles for each node based on bounding boxes and KDTree
-  void FindNodalCandidates(SpaceVariable3D &BBmin, SpaceVariable3D &BBmax, KDTree<MyTriangle, 3> *tree,
+  /** Below, if ijk_min and ijk_max (exclusive) are specified, only nodes in this region are updated. Results at
+   *  other nodes are assumed to be up-to-date.*/
+
+  //! find nearby triangles for each node based on bounding boxes and BVH
+  void FindNodalCandidates(SpaceVariable3D &BBmin, SpaceVariable3D &BBmax, BVH<MyTriangle, 3> *tree,
                            SpaceVariable3D &CandidatesIndex,
-                           std::vector<std::pair<Int3, std::vector<MyTriangle> > > &candidates); 
+                           std::vector<std::pair<Int3, std::vector<MyTriangle> > > &candidates,
+                           Int3 *ijk_min = NULL, Int3 *ijk_max = NULL); 
 
-  void FindIntersections(); //!< find occluded nodes, intersections, and first layer nodes
+  //! find occluded nodes, intersections, and first layer nodes
+  void FindIntersections(Int3 *ijk_min = NULL, Int3 *ijk_max = NULL);
 
   bool FloodFillColors(); /**< determine the generalized color function ("Color").\n 
                                Returns whether some nodes are occluded.\n"*/
   //! Fill "swept". The inputs are firstLayer nodes and surface nodal coords in the previous time step
-  void FindSweptNodes(std::vector<Vec3D> &X0); //!< candidates only need to account for 1 layer
+  void FindSweptNodes(std::vector<Vec3D> &X0, Int3 *ijk_min = NULL, Int3 *ijk_max = NULL); //!< candidates only need to account for 1 layer
 
   /** When the structure has moved SLIGHTLY, this "refill" function should be called, not the one above. This function only recomputes
    *  the "Color" of swept nodes. It is faster, and also maintains the same "colors". Calling the original "FloodFill" function may 
@@ -214,7 +231,7 @@ public:
    *  Note: This function must be called AFTER calling "findSweptNodes"*/
   void RefillAfterSurfaceUpdate();
 
-  double CalculateUnsignedDistanceNearSurface(int nL); //!< Calculate "Phi" for small "nL"
+  double CalculateUnsignedDistanceNearSurface(int nL, Int3 *ijk_min = NULL, Int3 *ijk_max = NULL); //!< Calculate "Phi" for small "nL"
 
   //! Find the elements of the embedded surface that constitute the boundary of a "color". For each element in\n
   //! in this set, determine which side(s) of it faces the interior of this color. "status" has the size of\n
@@ -243,7 +260,16 @@ private:
   //! Utility functions
   //
   //! Use a tree to find candidates. maxCand may change, tmp may be reallocated (if size is insufficient)
-  int FindCandidatesInBox(KDTree<MyTriangle, 3>* mytree, Vec3D bbmin, Vec3D bbmax, std::vector<MyTriangle> &tmp, int& maxCand);
+  int FindCandidatesInBox(BVH<MyTriangle, 3>* mytree, Vec3D bbmin, Vec3D bbmax, std::vector<MyTriangle> &tmp, int& maxCand);
+
+  //! Bounding box of the volume swept by the triangles that moved from X0 to X. Returns false if nothing moved
+  bool GetSweptBoundingBox(std::vector<Vec3D> &X0, Vec3D &bbmin, Vec3D &bbmax);
+
+  //! Global index range [ijk_min, ijk_max) of nodes whose bounding boxes (nL layers) may overlap [bbmin, bbmax]
+  void FindNodesAffectedByBox(Vec3D &bbmin, Vec3D &bbmax, int nL, Int3 &ijk_min, Int3 &ijk_max);
+
+  //! Intersection of [ijk_min, ijk_max) (NULL: everything) with the physical domain part of this subdomain
+  void GetLocalRegion(Int3 *ijk_min, Int3 *ijk_max, Int3 &lo, Int3 &hi);
 
   //! Check if a point is occluded by a set of triangles (thickened)
   bool IsPointOccludedByTriangles(Vec3D &coords, MyTriangle* tri, int nTri, double my_half_thickness,
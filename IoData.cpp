@@ -1060,7 +1060,7 @@ MaterialModelData::MaterialModelData()
 Assigner *MaterialModelData::getAssigner()
 {
 
-  ClassAssigner *ca = new ClassAssigner("normal", 17, nullAssigner);
+  ClassAssigner *ca = new ClassAssigner("normal", 18, nullAssigner);
 
   new ClassToken<MaterialModelData>(ca, "EquationOfState", this,
                                  reinterpret_cast<int MaterialModelData::*>(&MaterialModelData::eos), 8,
@@ -1094,6 +1094,8 @@ Assigner *MaterialModelData::getAssigner()
   heat_diffusion.setup("HeatDiffusionModel", ca);
   
   hyperelasticity.setup("HyperelasticityModel", ca);
+
+  eos_table.setup("RuntimeTabulation", ca);
   
   return ca;
 
@@ -1172,6 +1174,35 @@ void HeatDiffusionModelData::setup(const char *name, ClassAssigner *father) {
 
 //------------------------------------------------------------------------------
 
+EOSRuntimeTableData::EOSRuntimeTableData()
+{
+  type = NONE;
+  rho0 = rhomax = 0.0;
+  e0 = emax = 0.0;
+  Nrho = Ne = 0;
+}
+
+//------------------------------------------------------------------------------
+
+void EOSRuntimeTableData::setup(const char *name, ClassAssigner *father) {
+
+  ClassAssigner *ca = new ClassAssigner(name, 7, father);
+
+  new ClassToken<EOSRuntimeTableData>(ca, "Type", this,
+           reinterpret_cast<int EOSRuntimeTableData::*>(&EOSRuntimeTableData::type), 2,
+           "None",     EOSRuntimeTableData::NONE,
+           "Bilinear", EOSRuntimeTableData::BILINEAR);
+
+  new ClassDouble<EOSRuntimeTableData>(ca, "DensityMin", this, &EOSRuntimeTableData::rho0);
+  new ClassDouble<EOSRuntimeTableData>(ca, "DensityMax", this, &EOSRuntimeTableData::rhomax);
+  new ClassDouble<EOSRuntimeTableData>(ca, "InternalEnergyPerUnitMassMin", this, &EOSRuntimeTableData::e0);
+  new ClassDouble<EOSRuntimeTableData>(ca, "InternalEnergyPerUnitMassMax", this, &EOSRuntimeTableData::emax);
+  new ClassInt<EOSRuntimeTableData>(ca, "NumberOfPointsDensity", this, &EOSRuntimeTableData::Nrho);
+  new ClassInt<EOSRuntimeTableData>(ca, "NumberOfPointsInternalEnergy", this, &EOSRuntimeTableData::Ne);
+} 
+
+//------------------------------------------------------------------------------
+
 MaterialTransitionData::MaterialTransitionData()
 {
   from_id = -1;
@@ -1348,6 +1379,8 @@ SchemeData::SchemeData()
   flux = HLLC;
 
   delta = 0.2; //the coefficient in Harten's entropy fix (for Roe flux)
+
+  layout = ARRAY_OF_STRUCTURES;
 }
 
 //------------------------------------------------------------------------------
@@ -1356,7 +1389,7 @@ void SchemeData::setup(const char *name, ClassAssigner *father)
 {
 
   ClassAssigner* ca;
-  ca = new ClassAssigner(name, 4, father);
+  ca = new ClassAssigner(name, 5, father);
 
   new ClassToken<SchemeData>
     (ca, "Flux", this,
@@ -1365,6 +1398,11 @@ void SchemeData::setup(const char *name, ClassAssigner *father)
 
   new ClassDouble<SchemeData>(ca, "EntropyFixCoefficient", this, &SchemeData::delta);
 
+  new ClassToken<SchemeData>
+    (ca, "DataLayout", this,
+     reinterpret_cast<int SchemeData::*>(&SchemeData::layout), 2,
+     "ArrayOfStructures", 0, "StructureOfArrays", 1);
+
   rec.setup("Reconstruction", ca);
 
   smooth.setup("Smoothing", ca);
@@ -1402,13 +1440,15 @@ LevelSetReinitializationData::LevelSetReinitializationData()
   cfl = 0.8;
   convergence_tolerance = 2.0e-4;
   firstLayerTreatment = FIXED;
+  solver = PSEUDO_TIME;
+  error_threshold = -1.0;
 }
 
 //------------------------------------------------------------------------------
 
 void LevelSetReinitializationData::setup(const char *name, ClassAssigner *father)
 {
-  ClassAssigner *ca = new ClassAssigner(name, 6, father);
+  ClassAssigner *ca = new ClassAssigner(name, 8, father);
 
   new ClassInt<LevelSetReinitializationData>(ca, "Frequency", this, 
           &LevelSetReinitializationData::frequency);
@@ -1430,6 +1470,13 @@ void LevelSetReinitializationData::setup(const char *name, ClassAssigner *father
      "Fixed", 0, "ConstrainedMethod1", 1, "ConstrainedMethod2", 2,
      "IterativelyConstrainedMethod1", 3, "IterativelyConstrainedMethod2", 4);
 
+  new ClassToken<LevelSetReinitializationData>(ca, "Solver", this,
+     reinterpret_cast<int LevelSetReinitializationData::*>(&LevelSetReinitializationData::solver), 2,
+     "PseudoTimeIntegration", 0, "FastSweeping", 1);
+
+  new ClassDouble<LevelSetReinitializationData>(ca, "GradientErrorThreshold", this,
+          &LevelSetReinitializationData::error_threshold);
+
 }
 
 //------------------------------------------------------------------------------
@@ -1555,7 +1602,7 @@ Assigner *LevelSetSchemeData::getAssigner()
 
 SchemesData::SchemesData() 
 {
-
+  fuse_levelsets = NO;
 }
 
 //------------------------------------------------------------------------------
@@ -1563,7 +1610,7 @@ SchemesData::SchemesData()
 void SchemesData::setup(const char *name, ClassAssigner *father)
 {
 
-  ClassAssigner *ca = new ClassAssigner(name, 4, father);
+  ClassAssigner *ca = new ClassAssigner(name, 5, father);
 
   ns.setup("NavierStokes", ca);
 
@@ -1573,6 +1620,10 @@ void SchemesData::setup(const char *name, ClassAssigner *father)
 
   pm.setup("PrescribedMotion", ca);
 
+  new ClassToken<SchemesData>(ca, "FuseLevelSets", this,
+     reinterpret_cast<int SchemesData::*>(&SchemesData::fuse_levelsets), 2,
+     "No", 0, "Yes", 1);
+
 }
 
 //------------------------------------------------------------------------------
@@ -1590,6 +1641,13 @@ ExactRiemannSolverData::ExactRiemannSolverData()
   failure_threshold = 0.2;
   pressure_at_failure = 1.0e-8;
 
+  solution_cache = NO;
+  cache_tolerance = 1.0e-6;
+  cache_size = 100000;
+
+  approximate_solver = NONE;
+  approximation_threshold = 1.0e-2;
+
   // Experimental
   surface_tension = NO;
   surface_tension_coefficient = 0.;
@@ -1601,7 +1659,7 @@ ExactRiemannSolverData::ExactRiemannSolverData()
 void ExactRiemannSolverData::setup(const char *name, ClassAssigner *father)
 {
 
-  ClassAssigner *ca = new ClassAssigner(name, 13, father);
+  ClassAssigner *ca = new ClassAssigner(name, 18, father);
 
   new ClassInt<ExactRiemannSolverData>(ca, "MaxIts", this, 
                                        &ExactRiemannSolverData::maxIts_main);
@@ -1633,6 +1691,25 @@ void ExactRiemannSolverData::setup(const char *name, ClassAssigner *father)
   new ClassDouble<ExactRiemannSolverData>(ca, "PrescribedPressureUponFailure", this,
                                           &ExactRiemannSolverData::pressure_at_failure);
 
+  new ClassToken<ExactRiemannSolverData>(ca, "SolutionCache", this,
+                                         reinterpret_cast<int ExactRiemannSolverData::*>
+                                         (&ExactRiemannSolverData::solution_cache), 2,
+                                         "No", 0, "Yes", 1);
+
+  new ClassDouble<ExactRiemannSolverData>(ca, "CacheTolerance", this,
+                                          &ExactRiemannSolverData::cache_tolerance);
+
+  new ClassInt<ExactRiemannSolverData>(ca, "CacheSize", this,
+                                       &ExactRiemannSolverData::cache_size);
+
+  new ClassToken<ExactRiemannSolverData>(ca, "ApproximateSolver", this,
+                                         reinterpret_cast<int ExactRiemannSolverData::*>
+                                         (&ExactRiemannSolverData::approximate_solver), 2,
+                                         "None", 0, "Acoustic", 1);
+
+  new ClassDouble<ExactRiemannSolverData>(ca, "ApproximationThreshold", this,
+                                          &ExactRiemannSolverData::approximation_threshold);
+
   // Experimental 
   
   new ClassToken<ExactRiemannSolverData>(ca, "SurfaceTension", this,
@@ -2943,6 +3020,8 @@ OutputData::OutputData()
 
   mesh_partition = "";
 
+  timing_report = "";
+
   verbose = LOW;
 }
 
@@ -2950,7 +3029,7 @@ OutputData::OutputData()
 
 void OutputData::setup(const char *name, ClassAssigner *father)
 {
-  ClassAssigner *ca = new ClassAssigner(name, 28+MAXLS+MAXSPECIES, father);
+  ClassAssigner *ca = new ClassAssigner(name, 29+MAXLS+MAXSPECIES, father);
 
   new ClassStr<OutputData>(ca, "Prefix", this, &OutputData::prefix);
   new ClassStr<OutputData>(ca, "Solution", this, &OutputData::solution_filename_base);
@@ -3050,6 +3129,8 @@ void OutputData::setup(const char *name, ClassAssigner *father)
 
   new ClassStr<OutputData>(ca, "MeshPartition", this, &OutputData::mesh_partition);
 
+  new ClassStr<OutputData>(ca, "TimingReport", this, &OutputData::timing_report);
+
   new ClassToken<OutputData>(ca, "VerboseScreenOutput", this,
                              reinterpret_cast<int OutputData::*>(&OutputData::verbose), 3,
                              "Low", 0, "Medium", 1, "High", 2);
@@ -3068,6 +3149,40 @@ void OutputData::setup(const char *name, ClassAssigner *father)
 
 //------------------------------------------------------------------------------
 
+RestartData::RestartData()
+{
+  filename_base = "";
+  input_file = "";
+
+  frequency = 0;
+  frequency_dt = -1.0;
+  frequency_clocktime = -1.0;
+
+  clocktime_limit = -1.0;
+}
+
+//------------------------------------------------------------------------------
+
+void RestartData::setup(const char *name, ClassAssigner *father)
+{
+  ClassAssigner *ca = new ClassAssigner(name, 6, father);
+
+  new ClassStr<RestartData>(ca, "FileName", this, &RestartData::filename_base);
+
+  new ClassStr<RestartData>(ca, "InputFile", this, &RestartData::input_file);
+
+  new ClassInt<RestartData>(ca, "Frequency", this, &RestartData::frequency);
+
+  new ClassDouble<RestartData>(ca, "TimeInterval", this, &RestartData::frequency_dt);
+
+  new ClassDouble<RestartData>(ca, "ClockTimeInterval", this, &RestartData::frequency_clocktime);
+
+  new ClassDouble<RestartData>(ca, "ClockTimeLimit", this, &RestartData::clocktime_limit);
+
+}
+
+//------------------------------------------------------------------------------
+
 ProbeNode::ProbeNode() {
   locationX = locationY = locationZ = -1.0e20;
 }
@@ -3315,6 +3430,8 @@ EmbeddedSurfaceData::EmbeddedSurfaceData()
 
   surface_thickness = 1.0e-8;
 
+  tracking = FULL;
+
   // force calculation
   gauss_points_lofting = 0.0;
   internal_pressure = 0.0;
@@ -3338,7 +3455,7 @@ EmbeddedSurfaceData::EmbeddedSurfaceData()
 Assigner *EmbeddedSurfaceData::getAssigner()
 {
 
-  ClassAssigner *ca = new ClassAssigner("normal", 14, nullAssigner);
+  ClassAssigner *ca = new ClassAssigner("normal", 15, nullAssigner);
 
   new ClassToken<EmbeddedSurfaceData> (ca, "SurfaceProvidedByAnotherSolver", this,
      reinterpret_cast<int EmbeddedSurfaceData::*>(&EmbeddedSurfaceData::provided_by_another_solver), 2,
@@ -3347,6 +3464,10 @@ Assigner *EmbeddedSurfaceData::getAssigner()
   new ClassDouble<EmbeddedSurfaceData>(ca, "SurfaceThickness", this, 
                                       &EmbeddedSurfaceData::surface_thickness);
 
+  new ClassToken<EmbeddedSurfaceData> (ca, "SurfaceTracking", this,
+     reinterpret_cast<int EmbeddedSurfaceData::*>(&EmbeddedSurfaceData::tracking), 2,
+     "Full", 0, "Incremental", 1);
+
   new ClassStr<EmbeddedSurfaceData>(ca, "MeshFile", this, &EmbeddedSurfaceData::filename);
 
 
@@ -3933,6 +4054,8 @@ void IoData::setupCmdFileVariables()
 
   output.setup("Output");
 
+  restart.setup("Restart");
+
   special_tools.setup("SpecialTools");
 
   terminal_visualization.setup("TerminalVisualization");
@@ -526,6 +526,25 @@ struct HeatDiffusionModelData {
 
 };
 
+//------------------------------------------------------------------------------
+//! Run-time tabulation of the EOS on a uniform (rho, e) grid. Within the table, p, dp/drho, Gamma,
+//! and T are interpolated (bilinear), and e(rho,p) and rho(p,e) are obtained by inverting the
+//! interpolant. Outside the table, the exact EOS is used.
+struct EOSRuntimeTableData {
+
+  enum Type {NONE = 0, BILINEAR = 1} type;
+
+  double rho0, rhomax; //!< range of density
+  double e0, emax; //!< range of internal energy per unit mass
+  int Nrho, Ne; //!< number of grid points in each direction
+
+  EOSRuntimeTableData();
+  ~EOSRuntimeTableData() {}
+
+  void setup(const char *, ClassAssigner * = 0);
+
+};
+
 //------------------------------------------------------------------------------
 
 struct HyperelasticityModelData {
@@ -578,6 +597,8 @@ struct MaterialModelData {
 
   HyperelasticityModelData hyperelasticity;
 
+  EOSRuntimeTableData eos_table; //!< optional, replaces expensive EOS evaluations by table look-ups
+
   MaterialModelData();
   ~MaterialModelData() {}
   Assigner *getAssigner();
@@ -695,6 +716,11 @@ struct SchemeData {
  
   double delta; //! The coeffient in Harten's entropy fix.
 
+  //! Memory layout of the 5-dof state variables in element-wise kernels (e.g., conservative <-> primitive).
+  //! STRUCTURE_OF_ARRAYS is experimental: it copies the full field in and out of SoA buffers at every
+  //! conversion and has not been shown to be faster. Keep the default unless benchmarking.
+  enum DataLayout {ARRAY_OF_STRUCTURES = 0, STRUCTURE_OF_ARRAYS = 1} layout;
+
   ReconstructionData rec;
 
   SmoothingData smooth;
@@ -740,6 +766,17 @@ struct LevelSetReinitializationData {
                             ITERATIVE_CONSTRAINED1 = 3, ITERATIVE_CONSTRAINED2 = 4} //HCR-1&2,Hartmann 2010
            firstLayerTreatment;
 
+  //! Pseudo-time integration of the reinitialization equation, or fast sweeping (Gauss-Seidel iterations
+  //! of the Eikonal equation, Zhao 2005). In the latter case, MaxIts is the max. number of sweeping rounds.
+  enum Solver {PSEUDO_TIME = 0, FAST_SWEEPING = 1} solver;
+
+  //! If positive, reinitialization is triggered by the quality of the level set function, rather than
+  //! done at every Frequency/TimeInterval: max| |grad(phi)|-1 | near the interface is checked at the
+  //! specified Frequency/TimeInterval (one of them is required), and reinitialization is performed only
+  //! if it exceeds this threshold (or, for the narrow-band method, if the interface has drifted close
+  //! to the edge of the band). The number of iterations is scaled by the measured error.
+  double error_threshold;
+
   LevelSetReinitializationData();
   ~LevelSetReinitializationData() {}
 
@@ -810,6 +847,11 @@ struct SchemesData {
 
   ObjectMap<PrescribedMotionData> pm;
 
+  //! Advance all the level sets together (one residual sweep over V, shared FD coefficients, packed
+  //! ghost exchanges). Only applicable when every level set uses the full-domain finite difference
+  //! scheme; otherwise the level sets are advanced one by one.
+  enum YesNo {NO = 0, YES = 1} fuse_levelsets;
+
   SchemesData();
   ~SchemesData() {}
 
@@ -837,10 +879,21 @@ struct ExactRiemannSolverData {
                               //!< find a bracketing interval and the best approximation obtained is poor.
                               //!< this is the last resort. Usually it can be set to a very low but physical pressure
 
+  //! Optional cache of bimaterial Riemann solutions. The inputs (Vm, idm, Vp, idp, normal, curvature)
+  //! are quantized with the relative tolerance below, and problems with the same quantized inputs
+  //! share the same solution. The cache is cleared when it reaches the maximum size.
+  enum YesNo {NO = 0, YES = 1} solution_cache;
+  double cache_tolerance;
+  int cache_size; //!< max. number of stored solutions (per processor)
+
+  //! Optional approximate (acoustic) solver for two-sided problems, with fall-back to the exact solver
+  //! when the wave strength |p*-p|/(rho*c^2) exceeds the threshold below (see ExactRiemannSolverApproximate)
+  enum ApproximateSolver {NONE = 0, ACOUSTIC = 1} approximate_solver;
+  double approximation_threshold;
 
   // ---------------------------------------------------------------------------------------------
   //! Experimental (Wentao): Extended Exact Riemann solver w/ pressure jump due to surface tension
-  enum YesNo {NO = 0, YES = 1} surface_tension; //!< whether surface tension is modeled
+  YesNo surface_tension; //!< whether surface tension is modeled
   double surface_tension_coefficient; //!< used when surface tension is considered
   int surface_tension_materialid; //!< the material that pressure jump is *added* to
   // ---------------------------------------------------------------------------------------------
@@ -1522,6 +1575,8 @@ struct OutputData {
 
   const char *mesh_partition; //!< file for nodal coordinates
 
+  const char *timing_report; //!< JSON file for timers and counters (written at the end of the run)
+
   OutputData();
   ~OutputData() {}
 
@@ -1530,6 +1585,26 @@ struct OutputData {
 
 //------------------------------------------------------------------------------
 
+struct RestartData {
+
+  const char *filename_base; //!< checkpoint files: <Output.Prefix><filename_base>.*; empty: not written
+
+  const char *input_file; //!< path and base name of the checkpoint to restart from; empty: not a restart
+
+  int frequency; //!< checkpoints are also written at the end of the run (or when clocktime_limit is reached)
+  double frequency_dt; //!< -1 by default. To activate it, set it to a positive number
+  double frequency_clocktime; //!< clock time (sec.) between two checkpoints. -1 by default
+
+  double clocktime_limit; //!< write a checkpoint and stop after this clock time (sec.). -1 by default
+
+  RestartData();
+  ~RestartData() {}
+
+  void setup(const char *, ClassAssigner * = 0);
+};
+
+//------------------------------------------------------------------------------
+
 struct LagrangianMeshOutputData {
 
   int frequency;
@@ -1569,6 +1644,9 @@ struct EmbeddedSurfaceData {
 
   double surface_thickness;
 
+  //! surface tracking after each update (INCREMENTAL: only re-evaluates the region affected by moving triangles)
+  enum TrackingMode {FULL = 0, INCREMENTAL = 1} tracking;
+
   //! tools
   const char *dynamics_calculator;
   const char *force_calculator;
@@ -1797,6 +1875,8 @@ public:
 
   OutputData output;
 
+  RestartData restart;
+
   SpecialToolsData special_tools;
 
   TerminalVisualizationData terminal_visualization;
@@ -5,6 +5,7 @@
 
 #include<LagrangianOutput.h>
 #include<cstring>
+#include<cstdlib> //atoi
 #include<cassert>
 #include<fstream>
 #include<iomanip> //std::setw
@@ -163,14 +164,7 @@ LagrangianOutput::OutputResults(double t, double dt, int time_step, std::vector<
 
     // write second solution vector is provided
     if(F2_ptr) {
-      // insert "_2" to file name
-      string f2_name = iod_lag.sol;
-      int loc;
-      for(loc=0; loc<(int)f2_name.size(); loc++)
-        if(f2_name[loc] == '.')
-          break; 
-      f2_name.insert(loc,"_2");
-      f2_name = string(iod_lag.prefix) + f2_name;
+      string f2_name = GetSecondSolutionFileName();
 
       if(sol2_file == NULL) { //create new file and write header
         sol2_file = fopen(f2_name.c_str(), "w");
@@ -205,6 +199,111 @@ END_OF_OUTPUT:
 
 }
 
+//------------------------------------------------------------------------------
+
+string
+LagrangianOutput::GetSecondSolutionFileName()
+{
+  // insert "_2" to file name
+  string f2_name = iod_lag.sol;
+  int loc;
+  for(loc=0; loc<(int)f2_name.size(); loc++)
+    if(f2_name[loc] == '.')
+      break; 
+  f2_name.insert(loc,"_2");
+  return string(iod_lag.prefix) + f2_name;
+}
+
+//------------------------------------------------------------------------------
+
+void
+LagrangianOutput::WriteRestartData(std::ostream &out)
+{
+  out.write(reinterpret_cast<const char*>(&iFrame), sizeof(int));
+  out.write(reinterpret_cast<const char*>(&last_snapshot_time), sizeof(double));
+}
+
+//------------------------------------------------------------------------------
+
+void
+LagrangianOutput::ReadRestartData(std::istream &in, double t0)
+{
+  in.read(reinterpret_cast<char*>(&iFrame), sizeof(int));
+  in.read(reinterpret_cast<char*>(&last_snapshot_time), sizeof(double));
+
+  if(iod_lag.frequency_dt<=0.0 && iod_lag.frequency<=0)
+    return; //no output
+
+  // A frame written at the checkpoint is written again at the start of the restarted run (force_write)
+  if(last_snapshot_time == t0 && iFrame>0)
+    iFrame--;
+
+  int mpi_rank = -1;
+  MPI_Comm_rank(comm, &mpi_rank);
+
+  // Keep the frames written before the checkpoint, and append to the files (i.e. skip the header)
+  if(mpi_rank == 0) {
+    char outname[512];
+    if(strcmp(iod_lag.disp,"")) {
+      sprintf(outname, "%s%s", iod_lag.prefix, iod_lag.disp);
+      if(TruncateFile(outname, iFrame)) {
+        disp_file = fopen(outname, "a"); //marks the file as created (see OutputResults)
+        if(disp_file) fclose(disp_file);
+      }
+    }
+    if(strcmp(iod_lag.sol,"")) {
+      sprintf(outname, "%s%s", iod_lag.prefix, iod_lag.sol);
+      if(TruncateFile(outname, iFrame)) {
+        sol_file = fopen(outname, "a");
+        if(sol_file) fclose(sol_file);
+      }
+      string f2_name = GetSecondSolutionFileName();
+      if(TruncateFile(f2_name, iFrame)) {
+        sol2_file = fopen(f2_name.c_str(), "a");
+        if(sol2_file) fclose(sol2_file);
+      }
+    }
+  }
+
+  MPI_Barrier(comm);
+}
+
+//------------------------------------------------------------------------------
+// This function should be called only by Proc #0
+bool
+LagrangianOutput::TruncateFile(const string &fname, int nFrames)
+{
+  std::ifstream old_file(fname.c_str());
+  if(!old_file)
+    return false;
+
+  // xpost: two lines of header (the second one is the number of nodes N), then N+1 lines per frame
+  vector<string> lines;
+  string line;
+  int N = -1;
+  while(std::getline(old_file, line)) {
+    lines.push_back(line);
+    if(lines.size()==2)
+      N = std::atoi(line.c_str());
+    if(N>=0 && (int)lines.size() >= 2 + nFrames*(N+1))
+      break;
+  }
+  old_file.close();
+
+  if(N<0) //no valid header. Start a new file.
+    return false;
+
+  if((int)lines.size() < 2 + nFrames*(N+1))
+    fprintf(stdout, "\033[0;35mWarning: Found fewer than %d frames in %s.\033[0m\n", nFrames, fname.c_str());
+
+  std::ofstream new_file(fname.c_str(), std::ios::out | std::ios::trunc);
+  for(auto&& l : lines)
+    new_file << l << "\n";
+  new_file.close();
+
+  return true;
+}
+
 //------------------------------------------------------------------------------
 // This function should be called only by Proc #0
 void
@@ -40,11 +40,19 @@ public:
   void OutputTriangulatedMesh(std::vector<Vec3D>& X0, std::vector<Int3>& elems);
   void OutputResults(double t, double dt, int time_step, std::vector<Vec3D>& X0, std::vector<Vec3D>& X, 
                      std::vector<Vec3D>& F, std::vector<Vec3D>* F2_ptr, bool force_write); 
+
+  //! Checkpoint/restart: frame counter and the time of the last snapshot
+  void WriteRestartData(std::ostream &out);
+  void ReadRestartData(std::istream &in, double t0); //!< also removes frames written after the checkpoint (t0)
                 
 private:
 
   void AppendResultToFile(FILE* file, double time, int N, int dim, double* S);
 
+  std::string GetSecondSolutionFileName(); //!< iod_lag.sol with "_2" inserted (incl. prefix)
+
+  bool TruncateFile(const std::string &fname, int nFrames); //!< keeps the header and the first nFrames frames
+
 };
 
 #endif
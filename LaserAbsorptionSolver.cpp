@@ -4,6 +4,7 @@
  ************************************************************************/
 
 #include<LaserAbsorptionSolver.h>
+#include<Timer.h>
 #include<GeoTools.h>
 #include<GlobalMeshInfo.h>
 #include<algorithm> //std::sort
@@ -1980,6 +1981,8 @@ void
 LaserAbsorptionSolver::ComputeLaserRadiance(SpaceVariable3D &V_, SpaceVariable3D &ID_, SpaceVariable3D &L_,
                                             const double t, int time_step)
 {
+  ScopedTimer scoped_timer("LaserSolve");
+
 
   if(time_step % (iod.laser.solver_skipping_steps + 1) != 0) {
     if(verbose >= OutputData::HIGH)
@@ -1994,7 +1997,8 @@ LaserAbsorptionSolver::ComputeLaserRadiance(SpaceVariable3D &V_, SpaceVariable3D
     power_current = GetSourcePower(t);
     if(power_current < 1.0e-18/*eps*/) {
       if(!L_is_already_set_to_zero0) {
-        L_.SetConstantValue(0.0, false); //use "false" to trigger "Restore...Insert" because L_ may be printed to file.
+        L_.SetConstantValue(0.0, false); //updates the global vector (L_ may be printed to file); ghosts are
+                                         //marked stale and refreshed on first read.
         L_is_already_set_to_zero0 = true;
       }
       L_initialized = false; 
@@ -22,6 +22,7 @@ using std::pair;
 using std::unique_ptr;
 
 extern double domain_diagonal;
+extern int verbose;
 //-----------------------------------------------------
 
 LevelSetOperator::LevelSetOperator(MPI_Comm &comm_, DataManagers3D &dm_all_, IoData &iod_,
@@ -98,6 +99,12 @@ LevelSetOperator::LevelSetOperator(MPI_Comm &comm_, DataManagers3D &dm_all_, IoD
   else
     narrow_band = false;
 
+  if(iod_ls.reinit.error_threshold>0.0 && iod_ls.reinit.frequency<=0 && iod_ls.reinit.frequency_dt<=0) {
+    print_error("*** Error: Level set reinitialization based on GradientErrorThreshold requires Frequency "
+                "or TimeInterval (at which the quality of phi is checked).\n");
+    exit_mpi();
+  }
+
   if(iod_ls.reinit.frequency>0 || iod_ls.reinit.frequency_dt>0)
     reinit = new LevelSetReinitializer(comm, dm_all_, iod_ls, coordinates, delta_xyz,
                                        ghost_nodes_inner, ghost_nodes_outer);
@@ -159,8 +166,8 @@ LevelSetOperator::AXPlusBY(double a, SpaceVariable3D &X, double b, SpaceVariable
 
   int dof = X.NumDOF();
 
-  double*** x = X.GetDataPointer();
-  double*** y = Y.GetDataPointer();
+  double*** x = X.GetDataPointer(workOnGhost);
+  double*** y = Y.GetDataPointer(workOnGhost);
 
   if(!narrow_band) {
 
@@ -190,7 +197,10 @@ LevelSetOperator::AXPlusBY(double a, SpaceVariable3D &X, double b, SpaceVariable
 
   }
 
-  X.RestoreDataPointerAndInsert();
+  if(workOnGhost)
+    X.RestoreDataPointerAndInsert();
+  else
+    X.RestoreDataPointerAndMarkGhostsStale(); //ghost layer updated when (and if) needed
   Y.RestoreDataPointerToLocalVector();
 }
 
@@ -501,7 +511,7 @@ void LevelSetOperator::ApplyBoundaryConditions(SpaceVariable3D &Phi)
 
   }
 
-  Phi.RestoreDataPointerAndInsert();
+  Phi.RestoreDataPointerToLocalVector(); //only the external ghost layer is modified (not communicated)
 
   coordinates.RestoreDataPointerToLocalVector();
 
@@ -647,7 +657,7 @@ void LevelSetOperator::ApplyBoundaryConditionsNPhi(SpaceVariable3D &NPhi)
 
   }
 
-  NPhi.RestoreDataPointerAndInsert();
+  NPhi.RestoreDataPointerToLocalVector(); //only the external ghost layer is modified (not communicated)
 
   coordinates.RestoreDataPointerToLocalVector();
 
@@ -755,7 +765,7 @@ void LevelSetOperator::ApplyBoundaryConditionsKappaPhi(SpaceVariable3D &KappaPhi
 
   }
 
-  KappaPhi.RestoreDataPointerAndInsert();
+  KappaPhi.RestoreDataPointerToLocalVector(); //only the external ghost layer is modified (not communicated)
 
   coordinates.RestoreDataPointerToLocalVector();
 
@@ -805,6 +815,7 @@ void LevelSetOperator::ComputeResidualFDM_FullDomain(SpaceVariable3D &V, SpaceVa
   vector<int> ind0{0};
    
   double*** s = scalarG2.GetDataPointer();
+#pragma omp parallel for collapse(2)
   for(int k=kk0; k<kkmax; k++)
     for(int j=jj0; j<jjmax; j++)
       for(int i=ii0; i<iimax; i++)
@@ -834,6 +845,7 @@ void LevelSetOperator::ComputeResidualFDM_FullDomain(SpaceVariable3D &V, SpaceVa
   Vec3D*** coords = (Vec3D***)coordinates.GetDataPointer();
 
   double a, b, c, d, e, f;
+#pragma omp parallel for collapse(2) private(a, b, c, d, e, f)
   for(int k=k0; k<kmax; k++)
     for(int j=j0; j<jmax; j++)
       for(int i=i0; i<imax; i++) {
@@ -919,9 +931,10 @@ void LevelSetOperator::ComputeResidualFDM_NarrowBand(SpaceVariable3D &V, SpaceVa
   Vec3D*** coords = (Vec3D***)coordinates.GetDataPointer();
 
   double dm, dp; 
-  for(auto it = active_nodes.begin(); it != active_nodes.end(); it++) {
+#pragma omp parallel for private(dm, dp)
+  for(int n=0; n<(int)active_nodes.size(); n++) {
 
-    int i((*it)[0]), j((*it)[1]), k((*it)[2]);
+    int i(active_nodes[n][0]), j(active_nodes[n][1]), k(active_nodes[n][2]);
 
     if(!coordinates.IsHere(i,j,k,false))
       continue; // only work on nodes in the subdomain interior
@@ -995,6 +1008,7 @@ void LevelSetOperator::Reconstruct(SpaceVariable3D &V, SpaceVariable3D &Phi)
    
   // Reconstruction: x-velocity
   double*** s = (double***) scalar.GetDataPointer();
+#pragma omp parallel for collapse(2)
   for(int k=kk0; k<kkmax; k++)
     for(int j=jj0; j<jjmax; j++)
       for(int i=ii0; i<iimax; i++)
@@ -1004,6 +1018,7 @@ void LevelSetOperator::Reconstruct(SpaceVariable3D &V, SpaceVariable3D &Phi)
 
   // Reconstruction: y-velocity
   s = (double***) scalar.GetDataPointer();
+#pragma omp parallel for collapse(2)
   for(int k=kk0; k<kkmax; k++)
     for(int j=jj0; j<jjmax; j++)
       for(int i=ii0; i<iimax; i++)
@@ -1013,6 +1028,7 @@ void LevelSetOperator::Reconstruct(SpaceVariable3D &V, SpaceVariable3D &Phi)
 
   // Reconstruction: z-velocity
   s = (double***) scalar.GetDataPointer();
+#pragma omp parallel for collapse(2)
   for(int k=kk0; k<kkmax; k++)
     for(int j=jj0; j<jjmax; j++)
       for(int i=ii0; i<iimax; i++)
@@ -1088,6 +1104,7 @@ void LevelSetOperator::ComputeAdvectionFlux(SpaceVariable3D &R)
   double*** res    = R.GetDataPointer(); //residual, on the right-hand-side of the ODE
 
   //initialize R to 0
+#pragma omp parallel for collapse(2)
   for(int k=kk0; k<kkmax; k++)
     for(int j=jj0; j<jjmax; j++)
       for(int i=ii0; i<iimax; i++)
@@ -1097,8 +1114,12 @@ void LevelSetOperator::ComputeAdvectionFlux(SpaceVariable3D &R)
 
   // Loop through the domain interior, and the right and top ghost layers. For each cell, calculate the
   // numerical flux across the left and lower cell boundaries/interfaces
-  for(int k=k0; k<kkmax; k++) {
-    for(int j=j0; j<jjmax; j++) {
+  // (Multi-threading: same as in SpaceOperator::ComputeAdvectionFluxes, rows (k,j) are split into four
+  // groups by the parities of k and j, so that threads do not update the same cell.)
+  for(int color=0; color<4; color++) {
+#pragma omp parallel for collapse(2) private(localflux)
+  for(int k=k0+color/2; k<kkmax; k+=2) {
+    for(int j=j0+color%2; j<jjmax; j+=2) {
       for(int i=i0; i<iimax; i++) {
 
         //calculate F_{i-1/2,jk}
@@ -1128,6 +1149,7 @@ void LevelSetOperator::ComputeAdvectionFlux(SpaceVariable3D &R)
       }
     }
   }
+  } //end of color
 
   // Restore space variables
   delta_xyz.RestoreDataPointerToLocalVector();
@@ -1287,6 +1309,7 @@ void LevelSetOperator::AddSourceTerm(SpaceVariable3D &Phi, SpaceVariable3D &R)
   double*** w_z = (double***) dwdz.GetDataPointer();
   double*** res = (double***) R.GetDataPointer();
 
+#pragma omp parallel for collapse(2)
   for(int k=k0; k<kmax; k++)
     for(int j=j0; j<jmax; j++) 
       for(int i=i0; i<imax; i++)
@@ -1351,6 +1374,29 @@ bool LevelSetOperator::Reinitialize(double time, double dt, int time_step, Space
                     iod_ls.reinit.frequency, -100.0, must_do))
     return false; //nothing to do (not the right time)
 
+  if(iod_ls.reinit.error_threshold>0.0 && !must_do) { //check the quality of phi (only at the checkpoints)
+    double error = 0.0;
+    int drift = 0;
+    MonitorInterfaceQuality(Phi, error, drift);
+
+    bool band_edge = narrow_band && drift >= iod_ls.bandwidth - 1;
+    if(error <= iod_ls.reinit.error_threshold && !band_edge) { //phi is still (close to) a signed distance function
+      // The band is not rebuilt anywhere else. Re-center it on the interface now, so that the interface
+      // cannot move out of the band before the next check.
+      if(narrow_band)
+        reinit->UpdateNarrowBandWithoutReinitialization(Phi, Level, UsefulG2, Active, useful_nodes, active_nodes);
+      return false;
+    }
+
+    if(verbose>=1)
+      print("- Reinitializing level set (material id: %d): max||grad(phi)|-1| = %e, band drift = %d.\n",
+            materialid, error, drift);
+
+    // fewer iterations for small errors (but not if the band must be rebuilt)
+    if(special_maxIts<=0 && !band_edge)
+      special_maxIts = std::max(1, (int)ceil(iod_ls.reinit.maxIts*error/(error + iod_ls.reinit.error_threshold)));
+  }
+
   if(narrow_band) {
 //    print("- Reinitializing the level set function (material id: %d), bandwidth = %d.\n", materialid, iod_ls.bandwidth);
     reinit->ReinitializeInBand(Phi, Level, UsefulG2, Active, useful_nodes, active_nodes, special_maxIts);
@@ -1505,6 +1551,82 @@ LevelSetOperator::ComputeNormalDirection(SpaceVariable3D &Phi, SpaceVariable3D &
 
 //-----------------------------------------------------
 
+void
+LevelSetOperator::MonitorInterfaceQuality(SpaceVariable3D &Phi, double &grad_error, int &drift)
+{
+  double*** phi    = Phi.GetDataPointer();
+  Vec3D*** coords  = (Vec3D***)coordinates.GetDataPointer();
+  Vec3D*** dxyz    = (Vec3D***)delta_xyz.GetDataPointer();
+  double*** useful = narrow_band ? UsefulG2.GetDataPointer() : NULL;
+  double*** level  = narrow_band ? Level.GetDataPointer() : NULL;
+
+  //! d(phi)/dx_d: central difference (same as ComputeNormalDirection), one-sided at the edge of the band
+  auto derivative = [&](int i, int j, int k, int d) {
+    int o[3] = {0,0,0};
+    o[d] = 1;
+    int im(i-o[0]), jm(j-o[1]), km(k-o[2]), ip(i+o[0]), jp(j+o[1]), kp(k+o[2]);
+    bool m = !useful || useful[km][jm][im];
+    bool p = !useful || useful[kp][jp][ip];
+    if(m && p)
+      return CentralDifferenceLocal(phi[km][jm][im], phi[k][j][i], phi[kp][jp][ip],
+                                    coords[km][jm][im][d], coords[k][j][i][d], coords[kp][jp][ip][d]);
+    if(p)
+      return (phi[kp][jp][ip] - phi[k][j][i])/(coords[kp][jp][ip][d] - coords[k][j][i][d]);
+    if(m)
+      return (phi[k][j][i] - phi[km][jm][im])/(coords[k][j][i][d] - coords[km][jm][im][d]);
+    return 0.0;
+  };
+
+  grad_error = 0.0;
+  auto check_gradient = [&](int i, int j, int k) {
+    if(!NearInterface(phi[k][j][i], dxyz[k][j][i]))
+      return;
+    Vec3D grad(derivative(i,j,k,0), derivative(i,j,k,1), derivative(i,j,k,2));
+    grad_error = std::max(grad_error, fabs(grad.norm()-1.0));
+  };
+
+  // band drift: the largest band level (from the last time the band was constructed) at which
+  // phi changes sign
+  drift = 0;
+  int neighbor[6][3] = {{-1,0,0}, {1,0,0}, {0,-1,0}, {0,1,0}, {0,0,-1}, {0,0,1}};
+
+  if(!narrow_band) {
+    for(int k=k0; k<kmax; k++)
+      for(int j=j0; j<jmax; j++)
+        for(int i=i0; i<imax; i++)
+          check_gradient(i,j,k);
+  } else {
+    for(auto&& ind : useful_nodes) {
+      int i(ind[0]), j(ind[1]), k(ind[2]);
+      if(!coordinates.IsHere(i,j,k,false))
+        continue; //only visit the interior of the subdomain
+      check_gradient(i,j,k);
+      if((int)level[k][j][i] <= drift)
+        continue;
+      for(auto&& nei : neighbor) {
+        int i2 = i+nei[0], j2 = j+nei[1], k2 = k+nei[2];
+        if(useful[k2][j2][i2] && phi[k][j][i]*phi[k2][j2][i2]<=0) {
+          drift = level[k][j][i];
+          break;
+        }
+      }
+    }
+    UsefulG2.RestoreDataPointerToLocalVector();
+    Level.RestoreDataPointerToLocalVector();
+  }
+
+  Phi.RestoreDataPointerToLocalVector();
+  coordinates.RestoreDataPointerToLocalVector();
+  delta_xyz.RestoreDataPointerToLocalVector();
+
+  double q[2] = {grad_error, (double)drift};
+  MPI_Allreduce(MPI_IN_PLACE, q, 2, MPI_DOUBLE, MPI_MAX, comm);
+  grad_error = q[0];
+  drift      = (int)q[1];
+}
+
+//-----------------------------------------------------
+
 void
 LevelSetOperator::ComputeNormalDirectionCentralDifferencing_FullDomain(SpaceVariable3D &Phi, SpaceVariable3D &NPhi)
 {
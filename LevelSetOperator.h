@@ -97,6 +97,9 @@ public:
 
   bool NarrowBand() {return narrow_band;}
 
+  //! nodes in the narrow band (NULL if the narrow-band method is not used)
+  vector<Int3>* GetPointerToUsefulNodes() {return narrow_band ? &useful_nodes : NULL;}
+
   bool HasReinitializer() {return reinit!=NULL;}
 
   LevelSetSchemeData& GetLevelSetSchemeData() {return iod_ls;}
@@ -129,6 +132,14 @@ private:
   void ComputeNormalDirectionCentralDifferencing_FullDomain(SpaceVariable3D &Phi, SpaceVariable3D &NPhi);
   void ComputeNormalDirectionCentralDifferencing_NarrowBand(SpaceVariable3D &Phi, SpaceVariable3D &NPhi);
 
+  //! Quality of phi (for reinitialization): max| |grad(phi)|-1 | near the interface, and (narrow-band)
+  //! the max. band level of the nodes where phi changes sign. One pass over the (band) nodes, no exchange.
+  void MonitorInterfaceQuality(SpaceVariable3D &Phi, double &grad_error, int &drift);
+
+  //! Whether a node is within ~3 cells of the interface
+  inline bool NearInterface(double phi, Vec3D &dxyz) {
+    return fabs(phi) < 3.0*std::min(dxyz[0], std::min(dxyz[1], dxyz[2]));}
+
   //! Finite difference method
   void ComputeResidualFDM(SpaceVariable3D &V, SpaceVariable3D &Phi, SpaceVariable3D &R);
   void ComputeResidualFDM_FullDomain(SpaceVariable3D &V, SpaceVariable3D &Phi, SpaceVariable3D &R);
@@ -4,8 +4,10 @@
  ************************************************************************/
 
 #include <LevelSetReinitializer.h>
+#include <Timer.h>
 #include <GradientCalculatorCentral.h>
 #include <cfloat> //DBL_MAX
+#include <algorithm>
 
 extern int verbose;
 extern double domain_diagonal;
@@ -37,6 +39,20 @@ LevelSetReinitializer::LevelSetReinitializer(MPI_Comm &comm_, DataManagers3D &dm
 
   cfl = iod_ls.reinit.cfl;
 
+  if(iod_ls.reinit.solver == LevelSetReinitializationData::FAST_SWEEPING) {
+    // HCR-1 and HCR-2 are coupled with the pseudo-time iterations. Use CR-1 and CR-2 instead.
+    if(iod_ls.reinit.firstLayerTreatment == LevelSetReinitializationData::ITERATIVE_CONSTRAINED1) {
+      print_warning("Warning: Fast sweeping reinitialization uses ConstrainedMethod1 for the first layer "
+                    "(material id: %d).\n", iod_ls.materialid);
+      iod_ls.reinit.firstLayerTreatment = LevelSetReinitializationData::CONSTRAINED1;
+    }
+    else if(iod_ls.reinit.firstLayerTreatment == LevelSetReinitializationData::ITERATIVE_CONSTRAINED2) {
+      print_warning("Warning: Fast sweeping reinitialization uses ConstrainedMethod2 for the first layer "
+                    "(material id: %d).\n", iod_ls.materialid);
+      iod_ls.reinit.firstLayerTreatment = LevelSetReinitializationData::CONSTRAINED2;
+    }
+  }
+
 /*
   min_dxyz = std::min(delta_xyz.CalculateGlobalMin(0,false), 
                       std::min(delta_xyz.CalculateGlobalMin(1,false), delta_xyz.CalculateGlobalMin(2,false)));
@@ -74,6 +90,8 @@ LevelSetReinitializer::Destroy()
 void
 LevelSetReinitializer::ReinitializeFullDomain(SpaceVariable3D &Phi, int special_maxIts)
 {
+  ScopedTimer scoped_timer("LevelSetReinit");
+
   // Step 1: Prep: Tag first layer nodes & store the sign function
   vector<FirstLayerNode> firstLayer;
   bool detected = TagFirstLayerNodes(Phi, firstLayer); //also calculates the associated coefficients
@@ -81,7 +99,8 @@ LevelSetReinitializer::ReinitializeFullDomain(SpaceVariable3D &Phi, int special_
 
   print("- Reinitializing the level set function (material id: %d).\n", iod_ls.materialid);
 
-  EvaluateSignFunctionFullDomain(Phi, 1.0/*smoothing coefficient*/);
+  if(iod_ls.reinit.solver != LevelSetReinitializationData::FAST_SWEEPING)
+    EvaluateSignFunctionFullDomain(Phi, 1.0/*smoothing coefficient*/);
 
   // Step 2: Reinitialize first layer nodes (no iterations needed)
   if(/*iod_ls.reinit.firstLayerTreatment == LevelSetReinitializationData::UNCONSTRAINED||*/
@@ -92,6 +111,11 @@ LevelSetReinitializer::ReinitializeFullDomain(SpaceVariable3D &Phi, int special_
     ApplyBoundaryConditions(Phi);
   }
 
+  if(iod_ls.reinit.solver == LevelSetReinitializationData::FAST_SWEEPING) {
+    FastSweep(Phi, (special_maxIts>0) ? special_maxIts : iod_ls.reinit.maxIts);
+    return;
+  }
+
   // Step 3: Main loop -- 3rd-order Runge-Kutta w/ spatially varying dt
 
   //Store Phi (set Phibk = Phi) for failsafe
@@ -182,6 +206,8 @@ LevelSetReinitializer::ReinitializeInBand(SpaceVariable3D &Phi, SpaceVariable3D
                            vector<Int3> &useful_nodes, vector<Int3> &active_nodes,
                            int special_maxIts)
 {
+  ScopedTimer scoped_timer("LevelSetReinit");
+
 
   // update phi_max and phi_min (only for use in updating new useful nodes)
   UpdatePhiMaxAndPhiMinInBand(Phi, useful_nodes);
@@ -196,7 +222,8 @@ LevelSetReinitializer::ReinitializeInBand(SpaceVariable3D &Phi, SpaceVariable3D
         iod_ls.materialid, iod_ls.bandwidth);
   
   UpdateNarrowBand(Phi, firstLayerIncGhost, Level, UsefulG2, Active, useful_nodes, active_nodes);
-  EvaluateSignFunctionInBand(Phi, useful_nodes, 1.0/*smoothing coefficient*/);
+  if(iod_ls.reinit.solver != LevelSetReinitializationData::FAST_SWEEPING)
+    EvaluateSignFunctionInBand(Phi, useful_nodes, 1.0/*smoothing coefficient*/);
 
   // Step 2: Reinitialize first layer nodes (no iterations needed)
   if(/*iod_ls.reinit.firstLayerTreatment == LevelSetReinitializationData::UNCONSTRAINED||*/
@@ -208,6 +235,10 @@ LevelSetReinitializer::ReinitializeInBand(SpaceVariable3D &Phi, SpaceVariable3D
     ApplyBoundaryConditions(Phi, &UsefulG2);
   }
 
+  if(iod_ls.reinit.solver == LevelSetReinitializationData::FAST_SWEEPING) {
+    FastSweep(Phi, (special_maxIts>0) ? special_maxIts : iod_ls.reinit.maxIts, &UsefulG2, &useful_nodes);
+    return;
+  }
 
   // Step 3: Main loop -- 3rd-order Runge-Kutta w/ spatially varying dt
   
@@ -1474,6 +1505,26 @@ LevelSetReinitializer::UpdatePhiMaxAndPhiMinInBand(SpaceVariable3D &Phi, vector<
 
 //--------------------------------------------------------------------------
 
+void
+LevelSetReinitializer::UpdateNarrowBandWithoutReinitialization(SpaceVariable3D &Phi, SpaceVariable3D &Level,
+                           SpaceVariable3D &UsefulG2, SpaceVariable3D &Active,
+                           vector<Int3> &useful_nodes, vector<Int3> &active_nodes)
+{
+  ScopedTimer scoped_timer("LevelSetReinit");
+
+  // update phi_max and phi_min (only for use in updating new useful nodes)
+  UpdatePhiMaxAndPhiMinInBand(Phi, useful_nodes);
+
+  vector<FirstLayerNode> firstLayer; //not used
+  vector<Int3> firstLayerIncGhost;
+  bool detected = TagFirstLayerNodesInBand(Phi, useful_nodes, firstLayer, firstLayerIncGhost);
+  if(!detected) return; //same as ReinitializeInBand
+
+  UpdateNarrowBand(Phi, firstLayerIncGhost, Level, UsefulG2, Active, useful_nodes, active_nodes);
+}
+
+//--------------------------------------------------------------------------
+
 void
 LevelSetReinitializer::ConstructNarrowBand(SpaceVariable3D &Phi, 
                            SpaceVariable3D &Level, SpaceVariable3D &UsefulG2, SpaceVariable3D &Active,
@@ -1961,6 +2012,197 @@ LevelSetReinitializer::AXPlusBYInBandPlusOne(double a, SpaceVariable3D &X, doubl
 
 //--------------------------------------------------------------------------
 
+void
+LevelSetReinitializer::FastSweep(SpaceVariable3D &Phi, int maxIts, SpaceVariable3D *UsefulG2,
+                                 vector<Int3> *useful_nodes)
+{
+  //****************************************************************************
+  // Fast sweeping method (Zhao, Math. Comp. 2005) for |grad(phi)| = 1, applied
+  // separately on the two sides of the interface. First-layer nodes (Tag != 0)
+  // are the boundary data, and are not changed. (They have been treated before
+  // calling this function.) All the other nodes are initialized to +/- "large",
+  // and updated by Gauss-Seidel iterations with 8 alternating orderings. Each
+  // subdomain sweeps its own nodes; the ghost layer is exchanged after each round
+  // of 8 sweeps, until the maximum relative change falls below the tolerance.
+  // Works for both full-domain and narrow-band level set methods. In the latter
+  // case, only useful nodes are updated, and only useful neighbors are used.
+  //****************************************************************************
+
+  int NX, NY, NZ;
+  Phi.GetGlobalSize(&NX, &NY, &NZ);
+
+  double large = 10.0*domain_diagonal;
+
+  // Step 1: Initialization
+  double*** phi    = Phi.GetDataPointer();
+  double*** tag    = Tag.GetDataPointer();
+  double*** useful = UsefulG2 ? UsefulG2->GetDataPointer() : NULL;
+
+  if(!useful_nodes) {
+    for(int k=kk0; k<kkmax; k++)
+      for(int j=jj0; j<jjmax; j++)
+        for(int i=ii0; i<iimax; i++)
+          if(tag[k][j][i]==0 && !Phi.OutsidePhysicalDomain(i,j,k))
+            phi[k][j][i] = phi[k][j][i]>=0 ? large : -large;
+  } else {
+    for(auto it = useful_nodes->begin(); it != useful_nodes->end(); it++) {
+      int i((*it)[0]), j((*it)[1]), k((*it)[2]);
+      if(tag[k][j][i]==0 && !Phi.OutsidePhysicalDomain(i,j,k))
+        phi[k][j][i] = phi[k][j][i]>=0 ? large : -large;
+    }
+  }
+
+  Phi.RestoreDataPointerAndInsert();
+
+
+  // Step 2: Sweeping orders for the narrow band. The useful nodes in the subdomain interior are sorted
+  //         in 4 orders. Traversing each of them forward and backward gives the 8 orderings.
+  vector<vector<Int3> > band_orders;
+  if(useful_nodes) {
+    vector<Int3> nodes;
+    nodes.reserve(useful_nodes->size());
+    for(auto it = useful_nodes->begin(); it != useful_nodes->end(); it++)
+      if(Phi.IsHere((*it)[0], (*it)[1], (*it)[2], false) && tag[(*it)[2]][(*it)[1]][(*it)[0]]==0)
+        nodes.push_back(*it);
+    band_orders.resize(4, nodes);
+    for(int s=0; s<4; s++) {
+      int si = (s&1) ? -1 : 1, sj = (s&2) ? -1 : 1;
+      std::sort(band_orders[s].begin(), band_orders[s].end(),
+                [si,sj](const Int3 &a, const Int3 &b) {
+                  if(a[2] != b[2]) return a[2] < b[2];
+                  if(a[1] != b[1]) return sj*a[1] < sj*b[1];
+                  return si*a[0] < si*b[0];});
+    }
+  }
+
+  Tag.RestoreDataPointerToLocalVector();
+
+
+  // Step 3: Main loop
+  double dphi_max = 0.0;
+  int iter;
+  for(iter = 0; iter < maxIts; iter++) {
+
+    if(useful_nodes)
+      AXPlusBYInBandPlusOne(0.0, Phi0, 1.0, Phi);
+    else
+      Phi0.AXPlusBY(0.0, 1.0, Phi);
+
+    phi    = Phi.GetDataPointer();
+    tag    = Tag.GetDataPointer();
+    Vec3D*** coords = (Vec3D***)coordinates.GetDataPointer();
+
+    if(!useful_nodes) {
+      for(int s=0; s<8; s++) {
+        int di = (s&1) ? -1 : 1, dj = (s&2) ? -1 : 1, dk = (s&4) ? -1 : 1;
+        for(int kk=0; kk<kmax-k0; kk++) {
+          int k = dk>0 ? k0+kk : kmax-1-kk;
+          for(int jj=0; jj<jmax-j0; jj++) {
+            int j = dj>0 ? j0+jj : jmax-1-jj;
+            for(int ii=0; ii<imax-i0; ii++) {
+              int i = di>0 ? i0+ii : imax-1-ii;
+              if(tag[k][j][i]==0)
+                UpdateNodeByFastSweeping(i, j, k, phi, coords, NULL, NX, NY, NZ);
+            }
+          }
+        }
+      }
+    } else {
+      for(auto&& order : band_orders) {
+        for(auto it = order.begin(); it != order.end(); it++)
+          UpdateNodeByFastSweeping((*it)[0], (*it)[1], (*it)[2], phi, coords, useful, NX, NY, NZ);
+        for(auto it = order.rbegin(); it != order.rend(); it++)
+          UpdateNodeByFastSweeping((*it)[0], (*it)[1], (*it)[2], phi, coords, useful, NX, NY, NZ);
+      }
+    }
+
+    Tag.RestoreDataPointerToLocalVector();
+    coordinates.RestoreDataPointerToLocalVector();
+    Phi.RestoreDataPointerAndInsert(); //exchange with neighbor subdomains
+
+    dphi_max = useful_nodes ? CalculateMaximumRelativeErrorInBand(Phi0, Phi, *useful_nodes)
+                            : CalculateMaximumRelativeErrorFullDomain(Phi0, Phi);
+    if(verbose>1)
+      print("  o Sweep %d: Relative Error = %e, Tol = %e.\n", iter, dphi_max,
+            iod_ls.reinit.convergence_tolerance);
+    if(dphi_max < iod_ls.reinit.convergence_tolerance) {
+      if(verbose==1)
+        print("  o Completed (%d sweeps): Rel. Error = %e, Tol = %e.\n", iter, dphi_max,
+              iod_ls.reinit.convergence_tolerance);
+      break;
+    }
+  }
+
+  if(UsefulG2)
+    UsefulG2->RestoreDataPointerToLocalVector();
+
+  if(iter==maxIts)
+    print_warning("  o Warning: L-S Reinitialization (fast sweeping) failed to converge. Rel.Error = %e, "
+                  "Tol = %e.\n", dphi_max, iod_ls.reinit.convergence_tolerance);
+
+  ApplyBoundaryConditions(Phi, UsefulG2);
+}
+
+//--------------------------------------------------------------------------
+
+void
+LevelSetReinitializer::UpdateNodeByFastSweeping(int i, int j, int k, double*** phi, Vec3D*** coords,
+                                                double*** useful, int NX, int NY, int NZ)
+{
+  // Upwind discretization of |grad(phi)| = 1 (Godunov): In each direction, take the smaller |phi| of
+  // the two neighbors. Neighbors outside the physical domain (or the band) are not used.
+  double a[3], h[3];
+  int n = 0;
+
+  int nb[3][2][3] = {{{i-1,j,k},{i+1,j,k}}, {{i,j-1,k},{i,j+1,k}}, {{i,j,k-1},{i,j,k+1}}};
+  int N[3] = {NX, NY, NZ};
+  for(int d=0; d<3; d++) {
+    double amin = DBL_MAX, hmin = 0.0;
+    for(int side=0; side<2; side++) {
+      int *q = nb[d][side];
+      if(q[d]<0 || q[d]>=N[d] || (useful && !useful[q[2]][q[1]][q[0]]))
+        continue;
+      double aq = fabs(phi[q[2]][q[1]][q[0]]);
+      if(aq<amin) {
+        amin = aq;
+        hmin = fabs(coords[q[2]][q[1]][q[0]][d] - coords[k][j][i][d]);
+      }
+    }
+    if(amin<DBL_MAX) {
+      a[n] = amin;
+      h[n] = hmin;
+      n++;
+    }
+  }
+  if(n==0)
+    return;
+
+  // sort by a (ascending)
+  for(int m=1; m<n; m++)
+    for(int l=m; l>0 && a[l]<a[l-1]; l--) {
+      std::swap(a[l], a[l-1]);
+      std::swap(h[l], h[l-1]);
+    }
+
+  // solve sum_m ((u-a_m)^+/h_m)^2 = 1, adding one direction at a time
+  double u = a[0] + h[0];
+  double A = 0.0, B = 0.0, C = -1.0;
+  for(int m=0; m<n; m++) {
+    if(m>0 && u<=a[m])
+      break;
+    double w = 1.0/(h[m]*h[m]);
+    A += w;
+    B += a[m]*w;
+    C += a[m]*a[m]*w;
+    u = (B + sqrt(std::max(B*B - A*C, 0.0)))/A;
+  }
+
+  if(u<fabs(phi[k][j][i]))
+    phi[k][j][i] = phi[k][j][i]>=0 ? u : -u;
+}
+
+//--------------------------------------------------------------------------
+
 double
 LevelSetReinitializer::CalculateMaximumRelativeErrorFullDomain(SpaceVariable3D &Phi0, SpaceVariable3D &Phi)
 {
@@ -13,7 +13,9 @@
 /*****************************************************************************
  * Class LevelSetReinitializer handles the reinitialization of the level set
  * function, which means restoring it to a signed distance function (i.e.
- * |grad(phi)| = 1). A pseudo-time integration is performed.
+ * |grad(phi)| = 1). A pseudo-time integration is performed, or (optionally)
+ * the Eikonal equation is solved by the fast sweeping method. In both cases,
+ * the first-layer nodes are treated in the same way (see FirstLayerNode).
  ****************************************************************************/
 class LevelSetReinitializer
 {
@@ -101,6 +103,12 @@ public:
                            SpaceVariable3D &Level, SpaceVariable3D &UsefulG2, SpaceVariable3D &Active,
                            vector<Int3> &useful_nodes, vector<Int3> &active_nodes);
 
+  //! Re-centers the narrow band on the current interface without reinitializing phi (i.e. Step 1 of
+  //! ReinitializeInBand). Only visits the nodes in (and next to) the current band.
+  void UpdateNarrowBandWithoutReinitialization(SpaceVariable3D &Phi, SpaceVariable3D &Level,
+                           SpaceVariable3D &UsefulG2, SpaceVariable3D &Active,
+                           vector<Int3> &useful_nodes, vector<Int3> &active_nodes);
+
 private:
 
   // Functions that work for both full-domain and narrow-band level set methods
@@ -120,6 +128,13 @@ private:
   void ComputeNormalDirectionBeyondFirstLayer(SpaceVariable3D &Phi, vector<FirstLayerNode> &firstLayer, 
                               SpaceVariable3D *UsefulG2 = NULL, vector<Int3> *useful_nodes = NULL);
 
+  // Fast sweeping (both full-domain and narrow-band). First-layer nodes are fixed.
+  void FastSweep(SpaceVariable3D &Phi, int maxIts, SpaceVariable3D *UsefulG2 = NULL,
+                 vector<Int3> *useful_nodes = NULL);
+
+  void UpdateNodeByFastSweeping(int i, int j, int k, double*** phi, Vec3D*** coords, double*** useful,
+                                int NX, int NY, int NZ);
+
   inline double CentralDifferenceLocal(double phi0, double phi1, double phi2, double x0, double x1, double x2) {
     double c0 = -(x2-x1)/((x1-x0)*(x2-x0));
     double c1 = 1.0/(x1-x0) - 1.0/(x2-x1);
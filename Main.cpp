@@ -17,6 +17,7 @@
 #include <VarFcnANEOSEx1.h>
 #include <VarFcnHomoIncomp.h>
 #include <VarFcnDummy.h>
+#include <VarFcnTabulated.h>
 #include <FluxFcnGenRoe.h>
 #include <FluxFcnLLF.h>
 #include <FluxFcnHLLC.h>
@@ -29,6 +30,10 @@
 #include <PrescribedMotionOperator.h>
 #include <SpecialToolsDriver.h>
 #include <ExactRiemannSolverInterfaceJump.h>
+#include <ExactRiemannSolverApproximate.h>
+#include <ExactRiemannSolverCached.h>
+#include <Timer.h>
+#include <RestartHandler.h>
 #include <set>
 #include <string>
 using std::to_string;
@@ -46,6 +51,7 @@ int verbose;
 double domain_diagonal;
 double start_time; //start time in seconds
 MPI_Comm m2c_comm;
+Timer m2c_timer; //timers and counters (for performance analysis)
 
 int INACTIVE_MATERIAL_ID;
 
@@ -114,6 +120,16 @@ int main(int argc, char* argv[])
                   "specified material model.\n");
       exit_mpi();
     }
+
+    if(it->second->eos_table.type != EOSRuntimeTableData::NONE) { //replace the EOS by tables
+      if(it->second->eos == MaterialModelData::HOMOGENEOUS_INCOMPRESSIBLE) {
+        print_error("*** Error: Run-time EOS tabulation is not supported for incompressible materials.\n");
+        exit_mpi();
+      }
+      vf[matid] = new VarFcnTabulated(*it->second, vf[matid]);
+      print("- Tabulated the EOS of material %d on a %d x %d (density x internal energy) grid.\n",
+            matid, it->second->eos_table.Nrho, it->second->eos_table.Ne);
+    }
   }
   if(vf_tracker.size() != vf.size()) {
     print_error("*** Error: Detected error in the specification of material IDs.\n");
@@ -184,6 +200,20 @@ int main(int argc, char* argv[])
       exit_mpi();
     }
   }
+  ExactRiemannSolverApproximate *riemann_approx = NULL;
+  if(iod.exact_riemann.approximate_solver == ExactRiemannSolverData::ACOUSTIC) { //exact solver as fall-back
+    if(iod.exact_riemann.surface_tension == ExactRiemannSolverData::YES) {
+      print_error("*** Error: The approximate Riemann solver does not support surface tension.\n");
+      exit_mpi();
+    }
+    riemann_approx = new ExactRiemannSolverApproximate(vf, iod.exact_riemann, riemann);
+    riemann = riemann_approx;
+  }
+  ExactRiemannSolverCached *riemann_cache = NULL;
+  if(iod.exact_riemann.solution_cache == ExactRiemannSolverData::YES) { //memoize bimaterial solutions
+    riemann_cache = new ExactRiemannSolverCached(vf, iod.exact_riemann, riemann);
+    riemann = riemann_cache;
+  }
 
   //! Initialize FluxFcn for the advector flux of the N-S equations
   FluxFcnBase *ff = NULL;
@@ -221,6 +251,16 @@ int main(int argc, char* argv[])
   //! Let global_mesh find subdomain boundaries and neighbors
   global_mesh.FindSubdomainInfo(comm, dms);
 
+  //! Checkpoint/restart
+  RestartHandler restart(comm, iod);
+  if(restart.IsRestart()) {
+    if(concurrent.Coupled()) {
+      print_error("*** Error: Restart is not supported for simulations with concurrent programs.\n");
+      exit_mpi();
+    }
+    restart.ReadMetaFile();
+  }
+
   //! Initialize space operator
   SpaceOperator spo(comm, dms, iod, vf, *ff, *riemann, global_mesh);
 
@@ -230,6 +270,8 @@ int main(int argc, char* argv[])
     embed->SetCommAndMeshInfo(dms, spo.GetMeshCoordinates(), 
                               *(spo.GetPointerToInnerGhostNodes()), *(spo.GetPointerToOuterGhostNodes()),
                               global_mesh);
+    if(restart.IsRestart())
+      restart.ReadEmbeddedSurfaces(*embed); //nodal coords and velocities at the checkpoint
     embed->SetupIntersectors();
     embed->TrackSurfaces();
   }
@@ -355,9 +397,12 @@ int main(int argc, char* argv[])
   // ------------------------------------------------------------------------
   //! Initialize V, ID, Phi. 
   SpaceInitializer spinit(comm, dms, iod, global_mesh, spo.GetMeshCoordinates());
-  std::multimap<int, std::pair<int,int> >
-  id2closure = spinit.SetInitialCondition(V, ID, Phi, NPhi, KappaPhi, spo, lso, ghand,
-                                          embed ? embed->GetPointerToEmbeddedBoundaryData() : nullptr);
+  std::multimap<int, std::pair<int,int> > id2closure;
+  if(restart.IsRestart())
+    id2closure = restart.ReadInitialCondition(V, ID, Phi, NPhi, KappaPhi, lso);
+  else
+    id2closure = spinit.SetInitialCondition(V, ID, Phi, NPhi, KappaPhi, spo, lso, ghand,
+                                            embed ? embed->GetPointerToEmbeddedBoundaryData() : nullptr);
 
   // Boundary conditions are applied to V and Phi. But the ghost nodes of ID have not been populated.
   // ------------------------------------------------------------------------
@@ -379,7 +424,8 @@ int main(int argc, char* argv[])
   mpo.UpdateMaterialIDAtGhostNodes(ID); //ghost nodes (outside domain) get the ID of their image nodes
 
   if(incompressible) {
-    inco->FinalizeInitialCondition(V, ID); //Shift vel to cell faces, set rho=rho0, p=0 (must be followed by ApplyBC)
+    if(!restart.IsRestart()) //velocity read from restart files is already on cell faces
+      inco->FinalizeInitialCondition(V, ID); //Shift vel to cell faces, set rho=rho0, p=0 (must be followed by ApplyBC)
     inco->ApplyBoundaryConditions(V);
   }
 
@@ -443,6 +489,11 @@ int main(int argc, char* argv[])
 #endif
 
 
+  //! Overwrite the initial values of L, Xi, and Vturb
+  if(restart.IsRestart())
+    restart.ReadAuxiliaryVariables(L, Xi, Vturb);
+
+
   //! Create prescribed motion operator (if needed)
   PrescribedMotionOperator* pmo = NULL;
   if(!iod.schemes.pm.dataMap.empty())
@@ -548,6 +599,9 @@ int main(int argc, char* argv[])
   double cfl = 0.0;
   int time_step = 0;
 
+  if(restart.IsRestart()) //get t, dt, time_step, and the states of integrator and output
+    restart.ReadSolverStates(*integrator, out, t, dt, time_step);
+
   // In the case of steady-state simulation with local time-stepping, the constant "dt" is not
   // actually used. It represents the smallest dt in all the cells.
 
@@ -705,8 +759,11 @@ int main(int argc, char* argv[])
       //----------------------------------------------------
       t      += dt;
       dtleft -= dt;
-      integrator->AdvanceOneTimeStep(V, ID, Phi, NPhi, KappaPhi, L, Xi, Vturb, LocalDt, t, dt, time_step,
-                                     subcycle, dts); 
+      {
+        ScopedTimer scoped_timer("TimeStep");
+        integrator->AdvanceOneTimeStep(V, ID, Phi, NPhi, KappaPhi, L, Xi, Vturb, LocalDt, t, dt, time_step,
+                                       subcycle, dts); 
+      }
       subcycle++; //do this *after* AdvanceOneTimeStep.
       //----------------------------------------------------
 
@@ -764,6 +821,16 @@ int main(int argc, char* argv[])
 
     out.OutputSolutions(t, dts0, time_step, V, ID, Phi, NPhi, KappaPhi, L, Xi, Vturb, false/*force_write*/);
 
+    //Checkpoint (restart files). Stop if the clock time limit is reached.
+    bool time_is_up = restart.ClockTimeLimitReached();
+    restart.WriteRestartFiles(t, dts0, time_step, V, ID, Phi, NPhi, KappaPhi, L, Xi, Vturb, embed, *integrator,
+                              out, id2closure, time_is_up/*force_write*/);
+    if(time_is_up) {
+      print("- Reached the clock time limit (%e s). Terminating (restart files written).\n",
+            iod.restart.clocktime_limit);
+      break;
+    }
+
   }
 
   if(concurrent.Coupled())
@@ -777,6 +844,9 @@ int main(int argc, char* argv[])
 
   out.OutputSolutions(t, dts, time_step, V, ID, Phi, NPhi, KappaPhi, L, Xi, Vturb, true/*force_write*/);
 
+  restart.WriteRestartFiles(t, dts, time_step, V, ID, Phi, NPhi, KappaPhi, L, Xi, Vturb, embed, *integrator,
+                            out, id2closure, true/*force_write*/); //no duplication
+
   print("\n");
   print("\033[0;32m==========================================\033[0m\n");
   print("\033[0;32m   NORMAL TERMINATION (t = %e)  \033[0m\n", t); 
@@ -784,6 +854,16 @@ int main(int argc, char* argv[])
   print("Total Computation Time: %f sec.\n", walltime()-start_time);
   print("\n");
 
+  //! Timing report
+  string timing_file = "";
+  if(strcmp(iod.output.timing_report, ""))
+    timing_file = string(iod.output.prefix) + string(iod.output.timing_report);
+  if(riemann_approx)
+    riemann_approx->ReportStatistics(comm);
+  if(riemann_cache)
+    riemann_cache->ReportStatistics(comm);
+  m2c_timer.Report(comm, walltime()-start_time, timing_file.c_str());
+
 
 
   //! finalize 
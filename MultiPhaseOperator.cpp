@@ -37,6 +37,8 @@ MultiPhaseOperator::MultiPhaseOperator(MPI_Comm &comm_, DataManagers3D &dm_all_,
   coordinates.GetCornerIndices(&i0, &j0, &k0, &imax, &jmax, &kmax);
   coordinates.GetGhostedCornerIndices(&ii0, &jj0, &kk0, &iimax, &jjmax, &kkmax);
 
+  tracking_id_changes = false;
+
   for(int i=0; i<(int)lso.size(); i++)
     ls2matid[i] = lso[i]->GetMaterialID();
 
@@ -126,7 +128,8 @@ MultiPhaseOperator::Destroy()
 
 void 
 MultiPhaseOperator::UpdateMaterialIDByLevelSet(vector<SpaceVariable3D*> &Phi0, vector<SpaceVariable3D*> &Phi,
-                                               vector<Intersector*> *intersector, SpaceVariable3D &ID)
+                                               vector<Intersector*> *intersector, SpaceVariable3D &ID,
+                                               vector<vector<Int3>*> *bands)
 {
 
 #ifdef LEVELSET_TEST
@@ -147,61 +150,85 @@ MultiPhaseOperator::UpdateMaterialIDByLevelSet(vector<SpaceVariable3D*> &Phi0, v
     phi0[ls] = Phi0[ls]->GetDataPointer();
   
 
+  // Nodes to be visited: If all the level sets are narrow-band, phi can only change sign within the
+  // bands. So, only the union of the bands is visited. Otherwise, the entire subdomain interior.
+  vector<Int3> band_nodes;
+  bool use_bands = bands && (int)bands->size()==ls_size;
+  for(int ls=0; ls<ls_size && use_bands; ls++)
+    use_bands = (*bands)[ls]!=NULL;
+  if(use_bands) {
+    for(auto&& band : *bands)
+      for(auto&& ijk : *band)
+        if(coordinates.IsHere(ijk[0],ijk[1],ijk[2],false))
+          band_nodes.push_back(ijk);
+    SortAndRemoveDuplicates(band_nodes);
+  }
+  vector<Int3> *nodes = use_bands ? &band_nodes : NULL;
+  int nNodes = NumberOfNodes(nodes);
+
   int myls(-1);
   int total_swept_nodes = 0;
   set<std::pair<int,int> > swept; //pairs "ls" with -1 = phi[ls]<0 / 0 = phi[ls]=0 / 1 = phi[ls] > 0
   set<Int3> remaining_nodes;
-  for(int k=k0; k<kmax; k++)
-    for(int j=j0; j<jmax; j++)
-      for(int i=i0; i<imax; i++) {
+#pragma omp parallel for private(myls, swept) reduction(+:total_swept_nodes)
+  for(int n=0; n<nNodes; n++) {
 
-        tag[k][j][i] = 0;
+    int i, j, k;
+    GetNode(nodes, n, i, j, k);
 
-        if(id[k][j][i] == INACTIVE_MATERIAL_ID)
-          continue; //if occluded, id should not be changed
+    tag[k][j][i] = 0; //Note: With bands, tags outside the bands are not reset (should be 0 already)
 
-        swept.clear();
-        for(int ls=0; ls<ls_size; ls++) {
-          if(phi[ls][k][j][i]*phi0[ls][k][j][i]>0.0)
-            continue; //no change
-          else {
-            if     (phi[ls][k][j][i]<0)  swept.insert(std::make_pair(ls, -1));
-            else if(phi[ls][k][j][i]==0) swept.insert(std::make_pair(ls, 0));
-            else                         swept.insert(std::make_pair(ls, 1));
-          }
-        }
+    if(id[k][j][i] == INACTIVE_MATERIAL_ID)
+      continue; //if occluded, id should not be changed
+
+    swept.clear();
+    for(int ls=0; ls<ls_size; ls++) {
+      if(phi[ls][k][j][i]*phi0[ls][k][j][i]>0.0)
+        continue; //no change
+      else {
+        if     (phi[ls][k][j][i]<0)  swept.insert(std::make_pair(ls, -1));
+        else if(phi[ls][k][j][i]==0) swept.insert(std::make_pair(ls, 0));
+        else                         swept.insert(std::make_pair(ls, 1));
+      }
+    }
 
-        if(swept.empty())
-          continue; // no sign change: Should not update ID, particularly important if there are also embedded surfaces
-                      // that also influence material ID
+    if(swept.empty())
+      continue; // no sign change: Should not update ID, particularly important if there are also embedded surfaces
+                  // that also influence material ID
 
-        total_swept_nodes++;
+    total_swept_nodes++;
 
-        myls = -1;
-        for(auto&& ls_status : swept) {
-          if(ls_status.second == -1) {
-            if(myls!=-1) {
-              fprintf(stdout,"\033[0;31m*** Error: Node (%d,%d,%d) belongs to two material subdomains. "
-                             "phi[%d(matid:%d)] = %e, phi[%d(matid:%d)] = %e.\033[0m\n", i,j,k, myls, ls2matid[myls],
-                             phi[myls][k][j][i], ls_status.first, ls2matid[ls_status.first],
-                             phi[ls_status.first][k][j][i]); 
-              exit(-1);
-            }
-            myls = ls_status.first;
-          } 
+    if(tracking_id_changes) {
+#pragma omp critical (m2c_swept_nodes)
+      swept_nodes.push_back(Int3(i,j,k));
+    }
+
+    myls = -1;
+    for(auto&& ls_status : swept) {
+      if(ls_status.second == -1) {
+        if(myls!=-1) {
+          fprintf(stdout,"\033[0;31m*** Error: Node (%d,%d,%d) belongs to two material subdomains. "
+                         "phi[%d(matid:%d)] = %e, phi[%d(matid:%d)] = %e.\033[0m\n", i,j,k, myls, ls2matid[myls],
+                         phi[myls][k][j][i], ls_status.first, ls2matid[ls_status.first],
+                         phi[ls_status.first][k][j][i]); 
+          exit(-1);
         }
+        myls = ls_status.first;
+      } 
+    }
 
-     //   fprintf(stdout,"(%d,%d,%d)(%e,%e,%e) is swept, phi0: %e -> %e, phi1: %e -> %e. myls = %d\n", i,j,k,
-     //           global_mesh.GetX(i), global_mesh.GetY(j), global_mesh.GetZ(k),
-     //           phi0[0][k][j][i], phi[0][k][j][i], phi0[1][k][j][i], phi[1][k][j][i], myls);
+ //   fprintf(stdout,"(%d,%d,%d)(%e,%e,%e) is swept, phi0: %e -> %e, phi1: %e -> %e. myls = %d\n", i,j,k,
+ //           global_mesh.GetX(i), global_mesh.GetY(j), global_mesh.GetZ(k),
+ //           phi0[0][k][j][i], phi[0][k][j][i], phi0[1][k][j][i], phi[1][k][j][i], myls);
 
-        if(myls != -1)
-          id[k][j][i] = ls2matid[myls];
-        else {// the node does not belong to any subdomain tracked by level set(s) ==> tag it
-          tag[k][j][i] = 1;
-          remaining_nodes.insert(Int3(i,j,k));
-        }
-      }
+    if(myls != -1)
+      id[k][j][i] = ls2matid[myls];
+    else {// the node does not belong to any subdomain tracked by level set(s) ==> tag it
+      tag[k][j][i] = 1;
+#pragma omp critical (m2c_remaining_nodes)
+      remaining_nodes.insert(Int3(i,j,k));
+    }
+  }
 
   int total_remaining = remaining_nodes.size();
   int progress(0);
@@ -305,10 +332,12 @@ MultiPhaseOperator::UpdateMaterialIDByLevelSet(vector<SpaceVariable3D*> &Phi0, v
     } 
     else {
       // Likely some orphans. Material ID should be 0 (best guess)
-      for(auto&& ijk : tmp)
+      for(auto&& ijk : tmp) {
         id[ijk[2]][ijk[1]][ijk[0]] = 0;
+        tag[ijk[2]][ijk[1]][ijk[0]] = 0; //not left tagged (tags outside the bands may not be reset next time)
+      }
 
-      Tag.RestoreDataPointerToLocalVector();
+      Tag.RestoreDataPointerAndInsert();
       ID.RestoreDataPointerToLocalVector();
       if(verbose>=1)
         print_warning("Warning: Found %d orphan nodes swept by interfaces tracked by level sets. Set ID = 0.\n",
@@ -949,30 +978,33 @@ MultiPhaseOperator::UpdateStateVariablesByRiemannSolutions(SpaceVariable3D &IDn,
   // create a vector that temporarily stores unresolved nodes (which will be resolved separately)
   vector<Int3> unresolved;
 
-  // work inside the real domain
+  // work inside the real domain (only at swept nodes, if they are being tracked)
+  vector<Int3> *nodes = GetSweptNodes();
+  int nNodes = NumberOfNodes(nodes);
   int counter = 0;
-  for(int k=k0; k<kmax; k++)
-    for(int j=j0; j<jmax; j++)
-      for(int i=i0; i<imax; i++) {
+  for(int n=0; n<nNodes; n++) {
 
-        if(id[k][j][i] == idn[k][j][i]) //id remains the same. Skip
-          continue;
+    int i, j, k;
+    GetNode(nodes, n, i, j, k);
 
-        if(id[k][j][i] == INACTIVE_MATERIAL_ID)
-          continue;
+    if(id[k][j][i] == idn[k][j][i]) //id remains the same. Skip
+      continue;
+
+    if(id[k][j][i] == INACTIVE_MATERIAL_ID)
+      continue;
 
-        counter = LocalUpdateByRiemannSolutions(i, j, k, id[k][j][i], v[k][j][i-1], v[k][j][i+1], 
-                      v[k][j-1][i], v[k][j+1][i], v[k-1][j][i], v[k+1][j][i], riemann_solutions,
-                      v[k][j][i], true);
-        if(counter==0)
-          counter = LocalUpdateByRiemannSolutions(i, j, k, id[k][j][i], v[k][j][i-1], v[k][j][i+1], 
-              v[k][j-1][i], v[k][j+1][i], v[k-1][j][i], v[k+1][j][i], riemann_solutions,
-              v[k][j][i], false);
+    counter = LocalUpdateByRiemannSolutions(i, j, k, id[k][j][i], v[k][j][i-1], v[k][j][i+1], 
+                  v[k][j-1][i], v[k][j+1][i], v[k-1][j][i], v[k+1][j][i], riemann_solutions,
+                  v[k][j][i], true);
+    if(counter==0)
+      counter = LocalUpdateByRiemannSolutions(i, j, k, id[k][j][i], v[k][j][i-1], v[k][j][i+1], 
+          v[k][j-1][i], v[k][j+1][i], v[k-1][j][i], v[k+1][j][i], riemann_solutions,
+          v[k][j][i], false);
 
-        if(counter==0) //add it to unresolved nodes...
-          unresolved.push_back(Int3(k,j,i)); //note the order: k,j,i
+    if(counter==0) //add it to unresolved nodes...
+      unresolved.push_back(Int3(k,j,i)); //note the order: k,j,i
 
-      }  
+  }  
 
 
   V.RestoreDataPointerAndInsert(); //insert data & communicate with neighbor subd's
@@ -1004,91 +1036,91 @@ MultiPhaseOperator::LocalUpdateByRiemannSolutions(int i, int j, int k, int id, V
   Int3 ind(k,j,i);
 
   // left
-  auto it = riemann_solutions.left.find(ind);
-  if(it != riemann_solutions.left.end()) {
-    if(it->second.second/*ID*/ == id && (!upwind || vl[1] > 0)) {
+  const RiemannSolutionMap::Entry *sol = riemann_solutions.left.Find(ind);
+  if(sol) {
+    if(sol->id == id && (!upwind || vl[1] > 0)) {
       Vec3D v1(vl[1], vl[2], vl[3]);
       weight = upwind ? vl[1]/v1.norm() : 1.0;
       sum_weight += weight;
       if(counter==0) 
-        v = weight*it->second.first; /*riemann solution*/
+        v = weight*sol->state; /*riemann solution*/
       else 
-        v += weight*it->second.first; /*riemann solution*/
+        v += weight*sol->state; /*riemann solution*/
       counter++;
     }
   }
 
   // right
-  it = riemann_solutions.right.find(ind);
-  if(it != riemann_solutions.right.end()) {
-    if(it->second.second/*ID*/ == id && (!upwind || vr[1] < 0)) {
+  sol = riemann_solutions.right.Find(ind);
+  if(sol) {
+    if(sol->id == id && (!upwind || vr[1] < 0)) {
       Vec3D v1(vr[1], vr[2], vr[3]);
       weight = upwind ? -vr[1]/v1.norm() : 1.0;
       sum_weight += weight;
       if(counter==0)
-        v = weight*it->second.first; /*riemann solution*/
+        v = weight*sol->state; /*riemann solution*/
       else
-        v += weight*it->second.first; /*riemann solution*/
+        v += weight*sol->state; /*riemann solution*/
       counter++;
     }
   }
 
   // bottom
-  it = riemann_solutions.bottom.find(ind);
-  if(it != riemann_solutions.bottom.end()) {
-    if(it->second.second/*ID*/ == id && (!upwind || vb[2] > 0)) {
+  sol = riemann_solutions.bottom.Find(ind);
+  if(sol) {
+    if(sol->id == id && (!upwind || vb[2] > 0)) {
       Vec3D v1(vb[1], vb[2], vb[3]);
       weight = upwind ? vb[2]/v1.norm() : 1.0;
       sum_weight += weight;
       if(counter==0)
-        v = weight*it->second.first; /*riemann solution*/
+        v = weight*sol->state; /*riemann solution*/
       else
-        v += weight*it->second.first; /*riemann solution*/
+        v += weight*sol->state; /*riemann solution*/
       counter++;
     }
   }
 
   // top
-  it = riemann_solutions.top.find(ind);
-  if(it != riemann_solutions.top.end()) {
-    if(it->second.second/*ID*/ == id && (!upwind || vt[2] < 0)) {
+  sol = riemann_solutions.top.Find(ind);
+  if(sol) {
+    if(sol->id == id && (!upwind || vt[2] < 0)) {
       Vec3D v1(vt[1], vt[2], vt[3]);
       weight = upwind ? -vt[2]/v1.norm() : 1.0;
       sum_weight += weight;
       if(counter==0)
-        v = weight*it->second.first; /*riemann solution*/
+        v = weight*sol->state; /*riemann solution*/
       else
-        v += weight*it->second.first; /*riemann solution*/
+        v += weight*sol->state; /*riemann solution*/
       counter++;
     }
   }
 
   // back
-  it = riemann_solutions.back.find(ind);
-  if(it != riemann_solutions.back.end()) {
-    if(it->second.second/*ID*/ == id && (!upwind || vk[3] > 0)) {
+  sol = riemann_solutions.back.Find(ind);
+  if(sol) {
+    if(sol->id == id && (!upwind || vk[3] > 0)) {
       Vec3D v1(vk[1], vk[2], vk[3]);
       weight = upwind ? vk[3]/v1.norm() : 1.0;
       sum_weight += weight;
       if(counter==0)
-        v = weight*it->second.first; /*riemann solution*/
+        v = weight*sol->state; /*riemann solution*/
       else
-        v += weight*it->second.first; /*riemann solution*/
+        v += weight*sol->state; /*riemann solution*/
       counter++;
     }
   }
 
   // front
-  it = riemann_solutions.front.find(ind);
-  if(it != riemann_solutions.front.end()) {
-    if(it->second.second/*ID*/ == id && (!upwind || vf[3] < 0)) {
+  sol = riemann_solutions.front.Find(ind);
+  if(sol) {
+    if(sol->id == id && (!upwind || vf[3] < 0)) {
       Vec3D v1(vf[1], vf[2], vf[3]);
       weight = upwind ? -vf[3]/v1.norm() : 1.0;
       sum_weight += weight;
       if(counter==0)
-        v = weight*it->second.first; /*riemann solution*/
+        v = weight*sol->state; /*riemann solution*/
       else
-        v += weight*it->second.first; /*riemann solution*/
+        v += weight*sol->state; /*riemann solution*/
       counter++;
     }
   }
@@ -1130,89 +1162,92 @@ MultiPhaseOperator::UpdateStateVariablesByExtrapolation(SpaceVariable3D &IDn,
   // create a vector that temporarily stores unresolved nodes (which will be resolved separately)
   vector<Int3> unresolved;
 
-  // work inside the real domain
-  for(int k=k0; k<kmax; k++)
-    for(int j=j0; j<jmax; j++)
-      for(int i=i0; i<imax; i++) {
+  // work inside the real domain (only at swept nodes, if they are being tracked)
+  vector<Int3> *nodes = GetSweptNodes();
+  int nNodes = NumberOfNodes(nodes);
+  for(int n=0; n<nNodes; n++) {
 
-        if(id[k][j][i] == idn[k][j][i]) //id remains the same. Skip
-          continue;
+    int i, j, k;
+    GetNode(nodes, n, i, j, k);
 
-        if(id[k][j][i] == INACTIVE_MATERIAL_ID)
-          continue;
-
-        // coordinates of this node
-        Vec3D& x0(coords[k][j][i]);
+    if(id[k][j][i] == idn[k][j][i]) //id remains the same. Skip
+      continue;
 
-        sum_weight = 0.0;
-        vsum       = 0.0;
+    if(id[k][j][i] == INACTIVE_MATERIAL_ID)
+      continue;
 
-        //go over the neighboring nodes 
-        for(int neighk = k-1; neighk <= k+1; neighk++)         
-          for(int neighj = j-1; neighj <= j+1; neighj++)
-            for(int neighi = i-1; neighi <= i+1; neighi++) {
+    // coordinates of this node
+    Vec3D& x0(coords[k][j][i]);
 
-              if(id[neighk][neighj][neighi] != id[k][j][i])
-                continue; //this neighbor has a different ID. Skip it.
+    sum_weight = 0.0;
+    vsum       = 0.0;
 
-              if(id[neighk][neighj][neighi] != idn[neighk][neighj][neighi])
-                continue; //this neighbor also changed ID. Skip it. (Also skipping node [k][j][i])
+    //go over the neighboring nodes 
+    for(int neighk = k-1; neighk <= k+1; neighk++)         
+      for(int neighj = j-1; neighj <= j+1; neighj++)
+        for(int neighi = i-1; neighi <= i+1; neighi++) {
 
-              if(ID.OutsidePhysicalDomain(neighi, neighj, neighk))
-                continue; //this neighbor is outside the physical domain. Skip.
+          if(id[neighk][neighj][neighi] != id[k][j][i])
+            continue; //this neighbor has a different ID. Skip it.
 
-              // coordinates of this neighbor
-              Vec3D& x1(coords[neighk][neighj][neighi]);
+          if(id[neighk][neighj][neighi] != idn[neighk][neighj][neighi])
+            continue; //this neighbor also changed ID. Skip it. (Also skipping node [k][j][i])
 
-              if(intersector) {
-                bool connected = true;
-                for(auto&& xter : *intersector) {
-                  if(xter->Intersects(x0,x1)) {
-                    connected = false;
-                    break; //this neighbor is blocked to current node by an embedded surface
-                  }
-                }
-                if(!connected)
-                  continue;
-              }
+          if(ID.OutsidePhysicalDomain(neighi, neighj, neighk))
+            continue; //this neighbor is outside the physical domain. Skip.
 
-              if(iod.multiphase.phasechange_dir == MultiPhaseData::ALL) 
-                weight = 1.0/((x0-x1).norm());
-              else {//Upwind
-                // velocity at the neighbor node
-                v1[0] = v[neighk][neighj][neighi][1];
-                v1[1] = v[neighk][neighj][neighi][2];
-                v1[2] = v[neighk][neighj][neighi][3];
-                // compute weight
-                v1norm = v1.norm();
-                if(v1norm != 0)
-                  v1 /= v1norm;
-                x1x0 = x0 - x1; 
-                x1x0 /= x1x0.norm();
-
-                weight = max(0.0, x1x0*v1);
-              }
+          // coordinates of this neighbor
+          Vec3D& x1(coords[neighk][neighj][neighi]);
 
-              // add weighted s.v. at neighbor node
-              if(weight>0) {
-                sum_weight += weight;
-                vsum       += weight*v[neighk][neighj][neighi];
+          if(intersector) {
+            bool connected = true;
+            for(auto&& xter : *intersector) {
+              if(xter->Intersects(x0,x1)) {
+                connected = false;
+                break; //this neighbor is blocked to current node by an embedded surface
               }
             }
+            if(!connected)
+              continue;
+          }
 
-        if(sum_weight==0) {
-          if(verbose>1) {
-            if(iod.multiphase.phasechange_dir == MultiPhaseData::ALL) 
-              fprintf(stdout,"\033[0;35mWarning: Unable to update phase change at (%d,%d,%d)(%e,%e,%e) "
-                      "by extrapolation.\n\033[0m", i,j,k, x0[0],x0[1],x0[2]);
-            else
-              fprintf(stdout,"\033[0;35mWarning: Unable to update phase change at (%d,%d,%d)(%e,%e,%e) "
-                      "by extrapolation w/ upwinding.\n\033[0m", i,j,k, x0[0],x0[1],x0[2]);
+          if(iod.multiphase.phasechange_dir == MultiPhaseData::ALL) 
+            weight = 1.0/((x0-x1).norm());
+          else {//Upwind
+            // velocity at the neighbor node
+            v1[0] = v[neighk][neighj][neighi][1];
+            v1[1] = v[neighk][neighj][neighi][2];
+            v1[2] = v[neighk][neighj][neighi][3];
+            // compute weight
+            v1norm = v1.norm();
+            if(v1norm != 0)
+              v1 /= v1norm;
+            x1x0 = x0 - x1; 
+            x1x0 /= x1x0.norm();
+
+            weight = max(0.0, x1x0*v1);
           }
-          unresolved.push_back(Int3(k,j,i)); //note the order: k,j,i          
-        } else
-          v[k][j][i] = vsum/sum_weight; 
+
+          // add weighted s.v. at neighbor node
+          if(weight>0) {
+            sum_weight += weight;
+            vsum       += weight*v[neighk][neighj][neighi];
+          }
+        }
+
+    if(sum_weight==0) {
+      if(verbose>1) {
+        if(iod.multiphase.phasechange_dir == MultiPhaseData::ALL) 
+          fprintf(stdout,"\033[0;35mWarning: Unable to update phase change at (%d,%d,%d)(%e,%e,%e) "
+                  "by extrapolation.\n\033[0m", i,j,k, x0[0],x0[1],x0[2]);
+        else
+          fprintf(stdout,"\033[0;35mWarning: Unable to update phase change at (%d,%d,%d)(%e,%e,%e) "
+                  "by extrapolation w/ upwinding.\n\033[0m", i,j,k, x0[0],x0[1],x0[2]);
       }
+      unresolved.push_back(Int3(k,j,i)); //note the order: k,j,i          
+    } else
+      v[k][j][i] = vsum/sum_weight; 
+  }
 
   V.RestoreDataPointerAndInsert(); //insert data & communicate with neighbor subd's
   ID.RestoreDataPointerToLocalVector();
@@ -2019,43 +2054,49 @@ MultiPhaseOperator::AddLambdaToEnthalpyAfterInterfaceMotion(SpaceVariable3D &IDn
   Vec5D***  v   = (Vec5D***) V.GetDataPointer();
   double*** lam = Lambda.GetDataPointer();
 
+  // only at swept nodes, if they are being tracked
+  vector<Int3> *nodes = GetSweptNodes();
+  int nNodes = NumberOfNodes(nodes);
+
   int myidn, myid;
   int counter = 0;
-  for(int k=k0; k<kmax; k++)
-    for(int j=j0; j<jmax; j++)
-      for(int i=i0; i<imax; i++) {
+#pragma omp parallel for private(myidn, myid) reduction(+:counter)
+  for(int n=0; n<nNodes; n++) {
 
-        myidn = (int)idn[k][j][i];
-        myid  = (int)id[k][j][i];
+    int i, j, k;
+    GetNode(nodes, n, i, j, k);
 
-        if(myidn == myid) //id remains the same. Skip
-          continue;
+    myidn = (int)idn[k][j][i];
+    myid  = (int)id[k][j][i];
 
-        if(lam[k][j][i]<=0.0) //no latent heat here
-          continue;
+    if(myidn == myid) //id remains the same. Skip
+      continue;
 
-        for(auto it = trans[myidn].begin(); it != trans[myidn].end(); it++) {
+    if(lam[k][j][i]<=0.0) //no latent heat here
+      continue;
 
-          // check if this is the phase transition from "myidn" to "myid"
-          if((*it)->ToID() != myid)
-            continue;
+    for(auto it = trans[myidn].begin(); it != trans[myidn].end(); it++) {
 
-          //---------------------------------------------------------------------
-          // Now, do the actual work: Add lam to enthalpy
-          double rho = v[k][j][i][0];
-          //double p   = v[k][j][i][4];
-          double e   = varFcn[myid]->GetInternalEnergyPerUnitMass(v[k][j][i][0], v[k][j][i][4]);
-          //double h   = e + p/rho + lam[k][j][i]; //adding lam
-          e += lam[k][j][i]; //Correction of phase-change model (see Xuning JFM)
-          lam[k][j][i] = 0.0;
-          // update p to account for the increase of enthalpy (rho is fixed)
-          v[k][j][i][4] = varFcn[myid]->GetPressure(rho, e);
-
-          counter++;
-          //---------------------------------------------------------------------
-          
-        }
-      }
+      // check if this is the phase transition from "myidn" to "myid"
+      if((*it)->ToID() != myid)
+        continue;
+
+      //---------------------------------------------------------------------
+      // Now, do the actual work: Add lam to enthalpy
+      double rho = v[k][j][i][0];
+      //double p   = v[k][j][i][4];
+      double e   = varFcn[myid]->GetInternalEnergyPerUnitMass(v[k][j][i][0], v[k][j][i][4]);
+      //double h   = e + p/rho + lam[k][j][i]; //adding lam
+      e += lam[k][j][i]; //Correction of phase-change model (see Xuning JFM)
+      lam[k][j][i] = 0.0;
+      // update p to account for the increase of enthalpy (rho is fixed)
+      v[k][j][i][4] = varFcn[myid]->GetPressure(rho, e);
+
+      counter++;
+      //---------------------------------------------------------------------
+      
+    }
+  }
 
   MPI_Allreduce(MPI_IN_PLACE, &counter, 1, MPI_INT, MPI_SUM, comm);
 
@@ -2327,4 +2368,29 @@ MultiPhaseOperator::IsOrphanAcrossEmbeddedSurfaces(int i, int j, int k, double**
 
 //-----------------------------------------------------
 
+//-------------------------------------------------------------------------
+
+vector<Int3>*
+MultiPhaseOperator::GetSweptNodes()
+{
+  if(!tracking_id_changes)
+    return NULL;
+
+  // same order as a k-j-i sweep over the subdomain (the results of some updates depend on the order)
+  SortAndRemoveDuplicates(swept_nodes);
+  return &swept_nodes;
+}
+
+//-------------------------------------------------------------------------
+
+void
+MultiPhaseOperator::SortAndRemoveDuplicates(vector<Int3> &nodes)
+{
+  std::sort(nodes.begin(), nodes.end(),
+            [](const Int3 &a, const Int3 &b) {
+              return a[2]<b[2] || (a[2]==b[2] && (a[1]<b[1] || (a[1]==b[1] && a[0]<b[0])));});
+  nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+}
+
+//-------------------------------------------------------------------------
 
@@ -57,6 +57,11 @@ class MultiPhaseOperator
   //! latent heat reservoir (for modeling phase transition)
   SpaceVariable3D Lambda;
 
+  //! interior nodes swept by the interfaces tracked by level sets, i.e. nodes at which IDn and ID may
+  //! differ (only meaningful between StartTrackingIDChanges and StopTrackingIDChanges)
+  vector<Int3> swept_nodes;
+  bool tracking_id_changes;
+
 public:
   MultiPhaseOperator(MPI_Comm &comm_, DataManagers3D &dm_all_, IoData &iod_,
                      vector<VarFcnBase*> &varFcn_, GlobalMeshInfo &global_mesh_,
@@ -70,9 +75,18 @@ public:
   //! update material id at (external) ghost nodes (they get the IDs of their images)
   void UpdateMaterialIDAtGhostNodes(SpaceVariable3D &ID);
 
-  //! update material id including the ghost region
+  //! update material id including the ghost region. If "bands" contains the narrow bands of all the
+  //! level sets (see LevelSetOperator::GetPointerToUsefulNodes), only the nodes in the bands are visited.
   void UpdateMaterialIDByLevelSet(vector<SpaceVariable3D*> &Phi0, vector<SpaceVariable3D*> &Phi,
-                                  vector<Intersector*> *intersector, SpaceVariable3D &ID);
+                                  vector<Intersector*> *intersector, SpaceVariable3D &ID,
+                                  vector<vector<Int3>*> *bands = NULL);
+
+  //! Between Start and Stop, the nodes swept by level sets (in UpdateMaterialIDByLevelSet) are recorded,
+  //! and the functions that compare IDn with ID (UpdateStateVariablesAfterInterfaceMotion and 
+  //! AddLambdaToEnthalpyAfterInterfaceMotion) only visit these nodes. Call Start right after setting IDn = ID,
+  //! and only if ID is not changed by other means (except reverting/fixing swept nodes) before Stop.
+  void StartTrackingIDChanges() {swept_nodes.clear(); tracking_id_changes = true;}
+  void StopTrackingIDChanges() {swept_nodes.clear(); tracking_id_changes = false;}
 
   //! update V due to interface motion
   int UpdateStateVariablesAfterInterfaceMotion(SpaceVariable3D &IDn, SpaceVariable3D &ID,
@@ -138,6 +152,24 @@ protected:
                                          std::set<Int3> &imposed_occluded,
                                          vector<std::pair<Int3,bool> > &neighbors);
 
+  //! swept nodes sorted in k-j-i order, or NULL if they are not tracked
+  vector<Int3>* GetSweptNodes();
+
+  //! sorts the nodes in k-j-i order (i.e. the order of a sweep over the subdomain)
+  void SortAndRemoveDuplicates(vector<Int3> &nodes);
+
+  //! loops over a list of nodes, or (if the list is NULL) the subdomain interior in k-j-i order
+  inline int NumberOfNodes(vector<Int3> *nodes) {
+    return nodes ? nodes->size() : (imax-i0)*(jmax-j0)*(kmax-k0);}
+  inline void GetNode(vector<Int3> *nodes, int n, int &i, int &j, int &k) {
+    if(nodes) {
+      i = (*nodes)[n][0];  j = (*nodes)[n][1];  k = (*nodes)[n][2];
+    } else {
+      int nx = imax-i0, ny = jmax-j0;
+      i = i0 + n%nx;  j = j0 + (n/nx)%ny;  k = k0 + n/(nx*ny);
+    }
+  }
+
   //! internal function called by ResolveConflictsWithEmbeddedSurfaces
   bool IsOrphanAcrossEmbeddedSurfaces(int i, int j, int k, double*** idn, double*** id,
                                       vector<Intersector*> *intersector);
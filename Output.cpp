@@ -4,9 +4,11 @@
  ************************************************************************/
 
 #include <Utils.h>
+#include <Timer.h>
 #include <Vector5D.h>
 #include <Output.h>
 #include <float.h> //DBL_MAX
+#include <fstream>
 
 //--------------------------------------------------------------------------
 
@@ -20,7 +22,7 @@ Output::Output(MPI_Comm &comm_, DataManagers3D &dms, IoData &iod_, GlobalMeshInf
     scalar(comm_, &(dms.ghosted1_1dof)),
     vector3(comm_, &(dms.ghosted1_3dof)),
     vector5(comm_, &(dms.ghosted1_5dof)),
-    probe_output(comm_, iod_.output, vf_, ion_, heo_),
+    probe_output(comm_, iod_.output, vf_, ion_, heo_, strcmp(iod_.restart.input_file, "") != 0),
     energy_output(comm_,iod_, iod_.output, iod_.mesh, iod_.eqs, laser_, vf_, coordinates, delta_xyz, cell_volume),
     matvol_output(comm_, iod_, cell_volume),
     ion(ion_), heo(heo_), inco(inco_),
@@ -30,26 +32,31 @@ Output::Output(MPI_Comm &comm_, DataManagers3D &dms, IoData &iod_, GlobalMeshInf
 
   last_snapshot_time = -1.0;
 
-  char f1[256];
-  sprintf(f1, "%s%s.pvd", iod.output.prefix, iod.output.solution_filename_base);
+  pvdfile = NULL;
 
-  pvdfile  = fopen(f1,"w");
-  if(!pvdfile) {
-    print_error("*** Error: Cannot open file '%s%s.pvd' for output.\n", iod.output.prefix, iod.output.solution_filename_base);
-    exit_mpi();
-  }
+  if(strcmp(iod.restart.input_file, "") == 0) { //in a restart run, the pvd file is updated by ReadRestartData
 
-  print(pvdfile, "<?xml version=\"1.0\"?>\n");
-  print(pvdfile, "<VTKFile type=\"Collection\" version=\"0.1\"\n");
-  print(pvdfile, "byte_order=\"LittleEndian\">\n");
-  print(pvdfile, "  <Collection>\n");
+    char f1[256];
+    sprintf(f1, "%s%s.pvd", iod.output.prefix, iod.output.solution_filename_base);
 
-  print(pvdfile, "  </Collection>\n");
-  print(pvdfile, "</VTKFile>\n");
+    pvdfile  = fopen(f1,"w");
+    if(!pvdfile) {
+      print_error("*** Error: Cannot open file '%s%s.pvd' for output.\n", iod.output.prefix, iod.output.solution_filename_base);
+      exit_mpi();
+    }
 
-  mpi_barrier();
+    print(pvdfile, "<?xml version=\"1.0\"?>\n");
+    print(pvdfile, "<VTKFile type=\"Collection\" version=\"0.1\"\n");
+    print(pvdfile, "byte_order=\"LittleEndian\">\n");
+    print(pvdfile, "  <Collection>\n");
 
-  fclose(pvdfile); pvdfile = NULL;
+    print(pvdfile, "  </Collection>\n");
+    print(pvdfile, "</VTKFile>\n");
+
+    mpi_barrier();
+
+    fclose(pvdfile); pvdfile = NULL;
+  }
 
   // setup line plots
   int numLines = iod.output.linePlots.dataMap.size();
@@ -136,6 +143,8 @@ Output::OutputSolutions(double time, double dt, int time_step, SpaceVariable3D &
                         SpaceVariable3D *L, SpaceVariable3D *Xi, SpaceVariable3D *Vturb,
                         bool force_write)
 {
+  ScopedTimer scoped_timer("Output");
+
 
   SpaceVariable3D *Vout = &V;
   if(global_mesh.IsMeshStaggered()) { //interpolate velocity
@@ -189,6 +198,69 @@ Output::OutputSolutions(double time, double dt, int time_step, SpaceVariable3D &
 
 //--------------------------------------------------------------------------
 
+void
+Output::WriteRestartData(std::ostream &out)
+{
+  out.write(reinterpret_cast<const char*>(&iFrame), sizeof(int));
+  out.write(reinterpret_cast<const char*>(&last_snapshot_time), sizeof(double));
+
+  probe_output.WriteRestartData(out);
+  for(auto&& line : line_outputs)
+    line->WriteRestartData(out);
+}
+
+//--------------------------------------------------------------------------
+
+void
+Output::ReadRestartData(std::istream &in, double t0, int time_step0)
+{
+  in.read(reinterpret_cast<char*>(&iFrame), sizeof(int));
+  in.read(reinterpret_cast<char*>(&last_snapshot_time), sizeof(double));
+
+  probe_output.ReadRestartData(in, t0, time_step0);
+  for(auto&& line : line_outputs)
+    line->ReadRestartData(in, t0, time_step0);
+
+  // Rebuild the pvd file, keeping the first iFrame snapshots (i.e. those written before the checkpoint)
+  int mpi_rank;
+  MPI_Comm_rank(comm, &mpi_rank);
+  if(mpi_rank == 0) {
+    char f1[256];
+    sprintf(f1, "%s%s.pvd", iod.output.prefix, iod.output.solution_filename_base);
+
+    std::vector<std::string> datasets;
+    std::ifstream old_file(f1);
+    std::string line;
+    while(std::getline(old_file, line) && (int)datasets.size()<iFrame)
+      if(line.find("<DataSet") != std::string::npos)
+        datasets.push_back(line);
+    old_file.close();
+
+    if((int)datasets.size()<iFrame)
+      fprintf(stdout, "\033[0;35mWarning: Found %d (instead of %d) solution snapshots in %s.\033[0m\n",
+              (int)datasets.size(), iFrame, f1);
+
+    pvdfile = fopen(f1,"w");
+    if(!pvdfile) {
+      fprintf(stdout, "\033[0;31m*** Error: Cannot open file '%s' for output.\033[0m\n", f1);
+      exit(-1);
+    }
+    fprintf(pvdfile, "<?xml version=\"1.0\"?>\n");
+    fprintf(pvdfile, "<VTKFile type=\"Collection\" version=\"0.1\"\n");
+    fprintf(pvdfile, "byte_order=\"LittleEndian\">\n");
+    fprintf(pvdfile, "  <Collection>\n");
+    for(auto&& ds : datasets)
+      fprintf(pvdfile, "%s\n", ds.c_str());
+    fprintf(pvdfile, "  </Collection>\n");
+    fprintf(pvdfile, "</VTKFile>\n");
+    fclose(pvdfile); pvdfile = NULL;
+  }
+
+  mpi_barrier();
+}
+
+//--------------------------------------------------------------------------
+
 void
 Output::WriteSolutionSnapshot(double time, [[maybe_unused]] int time_step, SpaceVariable3D &V, 
                               SpaceVariable3D &ID, std::vector<SpaceVariable3D*> &Phi,
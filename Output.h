@@ -87,6 +87,11 @@ public:
 
   void FinalizeOutput();
 
+  //! Checkpoint/restart: frame counter and the time of the last snapshot (incl. probes and line plots).
+  //! Reading also removes snapshots/probe data written after the checkpoint (t0, time_step0) from the files.
+  void WriteRestartData(std::ostream &out);
+  void ReadRestartData(std::istream &in, double t0, int time_step0);
+
 private:
   void OutputMeshInformation(SpaceVariable3D& coordinates);
 
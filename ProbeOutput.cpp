@@ -5,6 +5,8 @@
 
 #include <ProbeOutput.h>
 #include <trilinear_interpolation.h>
+#include <fstream>
+#include <cstdlib> //atoi
 using std::pair;
 using std::array;
 
@@ -12,9 +14,9 @@ using std::array;
 
 // This constructor is for explicitly specified probe nodes (i.e. not a line)
 ProbeOutput::ProbeOutput(MPI_Comm &comm_, OutputData &iod_output_, std::vector<VarFcnBase*> &vf_,
-                         IonizationOperator* ion_, HyperelasticityOperator *heo_) : 
+                         IonizationOperator* ion_, HyperelasticityOperator *heo_, bool append_) : 
              comm(comm_), iod_output(iod_output_), vf(vf_), 
-             ion(ion_), heo(heo_)
+             ion(ion_), heo(heo_), append(append_)
 {
   iFrame = 0;
 
@@ -52,7 +54,7 @@ ProbeOutput::ProbeOutput(MPI_Comm &comm_, OutputData &iod_output_, std::vector<V
   if (iod_output.probes.density[0] != 0) {
     char *filename = new char[spn + strlen(iod_output.probes.density)];
     sprintf(filename, "%s%s", iod_output.prefix, iod_output.probes.density);
-    file[Probes::DENSITY] = fopen(filename, "w");
+    file[Probes::DENSITY] = OpenFile(filename, Probes::DENSITY);
 
     if(!file[Probes::DENSITY]) {
       print_error("*** Error: Cannot open file '%s' for output.\n", filename);
@@ -65,7 +67,7 @@ ProbeOutput::ProbeOutput(MPI_Comm &comm_, OutputData &iod_output_, std::vector<V
   if (iod_output.probes.velocity_x[0] != 0) {
     char *filename = new char[spn + strlen(iod_output.probes.velocity_x)];
     sprintf(filename, "%s%s", iod_output.prefix, iod_output.probes.velocity_x);
-    file[Probes::VELOCITY_X] = fopen(filename, "w");
+    file[Probes::VELOCITY_X] = OpenFile(filename, Probes::VELOCITY_X);
 
     if(!file[Probes::VELOCITY_X]) {
       print_error("*** Error: Cannot open file '%s' for output.\n", filename);
@@ -78,7 +80,7 @@ ProbeOutput::ProbeOutput(MPI_Comm &comm_, OutputData &iod_output_, std::vector<V
   if (iod_output.probes.velocity_y[0] != 0) {
     char *filename = new char[spn + strlen(iod_output.probes.velocity_y)];
     sprintf(filename, "%s%s", iod_output.prefix, iod_output.probes.velocity_y);
-    file[Probes::VELOCITY_Y] = fopen(filename, "w");
+    file[Probes::VELOCITY_Y] = OpenFile(filename, Probes::VELOCITY_Y);
 
     if(!file[Probes::VELOCITY_Y]) {
       print_error("*** Error: Cannot open file '%s' for output.\n", filename);
@@ -91,7 +93,7 @@ ProbeOutput::ProbeOutput(MPI_Comm &comm_, OutputData &iod_output_, std::vector<V
   if (iod_output.probes.velocity_z[0] != 0) {
     char *filename = new char[spn + strlen(iod_output.probes.velocity_z)];
     sprintf(filename, "%s%s", iod_output.prefix, iod_output.probes.velocity_z);
-    file[Probes::VELOCITY_Z] = fopen(filename, "w");
+    file[Probes::VELOCITY_Z] = OpenFile(filename, Probes::VELOCITY_Z);
 
     if(!file[Probes::VELOCITY_Z]) {
       print_error("*** Error: Cannot open file '%s' for output.\n", filename);
@@ -104,7 +106,7 @@ ProbeOutput::ProbeOutput(MPI_Comm &comm_, OutputData &iod_output_, std::vector<V
   if (iod_output.probes.pressure[0] != 0) {
     char *filename = new char[spn + strlen(iod_output.probes.pressure)];
     sprintf(filename, "%s%s", iod_output.prefix, iod_output.probes.pressure);
-    file[Probes::PRESSURE] = fopen(filename, "w");
+    file[Probes::PRESSURE] = OpenFile(filename, Probes::PRESSURE);
 
     if(!file[Probes::PRESSURE]) {
       print_error("*** Error: Cannot open file '%s' for output.\n", filename);
@@ -117,7 +119,7 @@ ProbeOutput::ProbeOutput(MPI_Comm &comm_, OutputData &iod_output_, std::vector<V
   if (iod_output.probes.temperature[0] != 0) {
     char *filename = new char[spn + strlen(iod_output.probes.temperature)];
     sprintf(filename, "%s%s", iod_output.prefix, iod_output.probes.temperature);
-    file[Probes::TEMPERATURE] = fopen(filename, "w");
+    file[Probes::TEMPERATURE] = OpenFile(filename, Probes::TEMPERATURE);
 
     if(!file[Probes::TEMPERATURE]) {
       print_error("*** Error: Cannot open file '%s' for output.\n", filename);
@@ -130,7 +132,7 @@ ProbeOutput::ProbeOutput(MPI_Comm &comm_, OutputData &iod_output_, std::vector<V
   if (iod_output.probes.delta_temperature[0] != 0) {
     char *filename = new char[spn + strlen(iod_output.probes.delta_temperature)];
     sprintf(filename, "%s%s", iod_output.prefix, iod_output.probes.delta_temperature);
-    file[Probes::DELTA_TEMPERATURE] = fopen(filename, "w");
+    file[Probes::DELTA_TEMPERATURE] = OpenFile(filename, Probes::DELTA_TEMPERATURE);
 
     if(!file[Probes::DELTA_TEMPERATURE]) {
       print_error("*** Error: Cannot open file '%s' for output.\n", filename);
@@ -143,7 +145,7 @@ ProbeOutput::ProbeOutput(MPI_Comm &comm_, OutputData &iod_output_, std::vector<V
   if (iod_output.probes.materialid[0] != 0) {
     char *filename = new char[spn + strlen(iod_output.probes.materialid)];
     sprintf(filename, "%s%s", iod_output.prefix, iod_output.probes.materialid);
-    file[Probes::MATERIALID] = fopen(filename, "w");
+    file[Probes::MATERIALID] = OpenFile(filename, Probes::MATERIALID);
 
     if(!file[Probes::MATERIALID]) {
       print_error("*** Error: Cannot open file '%s' for output.\n", filename);
@@ -156,7 +158,7 @@ ProbeOutput::ProbeOutput(MPI_Comm &comm_, OutputData &iod_output_, std::vector<V
   if (iod_output.probes.laser_radiance[0] != 0) {
     char *filename = new char[spn + strlen(iod_output.probes.laser_radiance)];
     sprintf(filename, "%s%s", iod_output.prefix, iod_output.probes.laser_radiance);
-    file[Probes::LASERRADIANCE] = fopen(filename, "w");
+    file[Probes::LASERRADIANCE] = OpenFile(filename, Probes::LASERRADIANCE);
 
     if(!file[Probes::LASERRADIANCE]) {
       print_error("*** Error: Cannot open file '%s' for output.\n", filename);
@@ -169,7 +171,7 @@ ProbeOutput::ProbeOutput(MPI_Comm &comm_, OutputData &iod_output_, std::vector<V
   if (iod_output.probes.levelset0[0] != 0) {
     char *filename = new char[spn + strlen(iod_output.probes.levelset0)];
     sprintf(filename, "%s%s", iod_output.prefix, iod_output.probes.levelset0);
-    file[Probes::LEVELSET0] = fopen(filename, "w");
+    file[Probes::LEVELSET0] = OpenFile(filename, Probes::LEVELSET0);
 
     if(!file[Probes::LEVELSET0]) {
       print_error("*** Error: Cannot open file '%s' for output.\n", filename);
@@ -182,7 +184,7 @@ ProbeOutput::ProbeOutput(MPI_Comm &comm_, OutputData &iod_output_, std::vector<V
   if (iod_output.probes.levelset1[0] != 0) {
     char *filename = new char[spn + strlen(iod_output.probes.levelset1)];
     sprintf(filename, "%s%s", iod_output.prefix, iod_output.probes.levelset1);
-    file[Probes::LEVELSET1] = fopen(filename, "w");
+    file[Probes::LEVELSET1] = OpenFile(filename, Probes::LEVELSET1);
 
     if(!file[Probes::LEVELSET1]) {
       print_error("*** Error: Cannot open file '%s' for output.\n", filename);
@@ -195,7 +197,7 @@ ProbeOutput::ProbeOutput(MPI_Comm &comm_, OutputData &iod_output_, std::vector<V
   if (iod_output.probes.levelset2[0] != 0) {
     char *filename = new char[spn + strlen(iod_output.probes.levelset2)];
     sprintf(filename, "%s%s", iod_output.prefix, iod_output.probes.levelset2);
-    file[Probes::LEVELSET2] = fopen(filename, "w");
+    file[Probes::LEVELSET2] = OpenFile(filename, Probes::LEVELSET2);
 
     if(!file[Probes::LEVELSET2]) {
       print_error("*** Error: Cannot open file '%s' for output.\n", filename);
@@ -208,7 +210,7 @@ ProbeOutput::ProbeOutput(MPI_Comm &comm_, OutputData &iod_output_, std::vector<V
   if (iod_output.probes.levelset3[0] != 0) {
     char *filename = new char[spn + strlen(iod_output.probes.levelset3)];
     sprintf(filename, "%s%s", iod_output.prefix, iod_output.probes.levelset3);
-    file[Probes::LEVELSET3] = fopen(filename, "w");
+    file[Probes::LEVELSET3] = OpenFile(filename, Probes::LEVELSET3);
 
     if(!file[Probes::LEVELSET3]) {
       print_error("*** Error: Cannot open file '%s' for output.\n", filename);
@@ -221,7 +223,7 @@ ProbeOutput::ProbeOutput(MPI_Comm &comm_, OutputData &iod_output_, std::vector<V
   if (iod_output.probes.levelset4[0] != 0) {
     char *filename = new char[spn + strlen(iod_output.probes.levelset4)];
     sprintf(filename, "%s%s", iod_output.prefix, iod_output.probes.levelset4);
-    file[Probes::LEVELSET4] = fopen(filename, "w");
+    file[Probes::LEVELSET4] = OpenFile(filename, Probes::LEVELSET4);
 
     if(!file[Probes::LEVELSET4]) {
       print_error("*** Error: Cannot open file '%s' for output.\n", filename);
@@ -238,7 +240,7 @@ ProbeOutput::ProbeOutput(MPI_Comm &comm_, OutputData &iod_output_, std::vector<V
     }
     char *filename = new char[spn + strlen(iod_output.probes.ionization_result)];
     sprintf(filename, "%s%s", iod_output.prefix, iod_output.probes.ionization_result);
-    file[Probes::IONIZATION] = fopen(filename, "w");
+    file[Probes::IONIZATION] = OpenFile(filename, Probes::IONIZATION);
 
     if(!file[Probes::IONIZATION]) {
       print_error("*** Error: Cannot open file '%s' for output.\n", filename);
@@ -251,7 +253,7 @@ ProbeOutput::ProbeOutput(MPI_Comm &comm_, OutputData &iod_output_, std::vector<V
   if (iod_output.probes.reference_map[0] != 0) {
     char *filename = new char[spn + strlen(iod_output.probes.reference_map)];
     sprintf(filename, "%s%s", iod_output.prefix, iod_output.probes.reference_map);
-    file[Probes::REFERENCE_MAP] = fopen(filename, "w");
+    file[Probes::REFERENCE_MAP] = OpenFile(filename, Probes::REFERENCE_MAP);
 
     if(!file[Probes::REFERENCE_MAP]) {
       print_error("*** Error: Cannot open file '%s' for output.\n", filename);
@@ -268,7 +270,7 @@ ProbeOutput::ProbeOutput(MPI_Comm &comm_, OutputData &iod_output_, std::vector<V
     }
     char *filename = new char[spn + strlen(iod_output.probes.principal_elastic_stresses)];
     sprintf(filename, "%s%s", iod_output.prefix, iod_output.probes.principal_elastic_stresses);
-    file[Probes::PRINCIPAL_ELASTIC_STRESSES] = fopen(filename, "w");
+    file[Probes::PRINCIPAL_ELASTIC_STRESSES] = OpenFile(filename, Probes::PRINCIPAL_ELASTIC_STRESSES);
 
     if(!file[Probes::PRINCIPAL_ELASTIC_STRESSES]) {
       print_error("*** Error: Cannot open file '%s' for output.\n", filename);
@@ -280,13 +282,9 @@ ProbeOutput::ProbeOutput(MPI_Comm &comm_, OutputData &iod_output_, std::vector<V
 
 
   for(int i=0; i<Probes::SIZE; i++)
-    if(file[i]) { //write header
-      for(int iNode = 0; iNode<numNodes; iNode++)
-        print(file[i], "## Probe %d: %e, %e, %e\n", iNode, locations[iNode][0], locations[iNode][1], 
-                       locations[iNode][2]);
-      print(file[i], "## Time step  |  Time  |  Solutions at probe nodes (0, 1, 2, etc.)\n");
+    if(file[i] && !append) { //write header (in a restart run, the file already has it)
+      WriteHeader(i);
       mpi_barrier();
-      fflush(file[i]);
     }
 
 }
@@ -295,7 +293,7 @@ ProbeOutput::ProbeOutput(MPI_Comm &comm_, OutputData &iod_output_, std::vector<V
 // This constructor is for "line plots"
 ProbeOutput::ProbeOutput(MPI_Comm &comm_, OutputData &iod_output_, std::vector<VarFcnBase*> &vf_,
                          IonizationOperator* ion_, int line_number_) : 
-             comm(comm_), iod_output(iod_output_), vf(vf_), ion(ion_)
+             comm(comm_), iod_output(iod_output_), vf(vf_), ion(ion_), append(false)
 {
 
   iFrame = 0;
@@ -340,6 +338,87 @@ ProbeOutput::~ProbeOutput()
 
 //-------------------------------------------------------------------------
 
+FILE*
+ProbeOutput::OpenFile(const char *fname, int i)
+{
+  file_name[i] = fname;
+  return fopen(fname, append ? "a" : "w");
+}
+
+//-------------------------------------------------------------------------
+
+void
+ProbeOutput::WriteHeader(int i)
+{
+  for(int iNode = 0; iNode<numNodes; iNode++)
+    print(file[i], "## Probe %d: %e, %e, %e\n", iNode, locations[iNode][0], locations[iNode][1], 
+                   locations[iNode][2]);
+  print(file[i], "## Time step  |  Time  |  Solutions at probe nodes (0, 1, 2, etc.)\n");
+  fflush(file[i]);
+}
+
+//-------------------------------------------------------------------------
+
+void
+ProbeOutput::WriteRestartData(std::ostream &out)
+{
+  out.write(reinterpret_cast<const char*>(&iFrame), sizeof(int));
+  out.write(reinterpret_cast<const char*>(&last_snapshot_time), sizeof(double));
+}
+
+//-------------------------------------------------------------------------
+
+void
+ProbeOutput::ReadRestartData(std::istream &in, double t0, int time_step0)
+{
+  in.read(reinterpret_cast<char*>(&iFrame), sizeof(int));
+  in.read(reinterpret_cast<char*>(&last_snapshot_time), sizeof(double));
+
+  // A snapshot written at the checkpoint is written again at the start of the restarted run (force_write)
+  if(last_snapshot_time == t0 && iFrame>0)
+    iFrame--; //line plots: the same file is re-written
+
+  int mpi_rank = 0;
+  MPI_Comm_rank(comm, &mpi_rank);
+
+  // Probe nodes: keep the header and the lines written before the checkpoint (only proc #0 writes)
+  for(int i=0; i<Probes::SIZE; i++) {
+    if(!file[i] || mpi_rank != 0)
+      continue;
+
+    fclose(file[i]);
+
+    std::vector<std::string> lines;
+    bool has_header = false;
+    std::ifstream old_file(file_name[i].c_str());
+    std::string line;
+    while(std::getline(old_file, line)) {
+      if(line.compare(0, 2, "##") == 0)
+        has_header = true;
+      else if(std::atoi(line.c_str()) >= time_step0) //the first column is the time step
+        break;
+      lines.push_back(line);
+    }
+    old_file.close();
+
+    file[i] = fopen(file_name[i].c_str(), "w");
+    if(!file[i]) {
+      fprintf(stdout, "\033[0;31m*** Error: Cannot open file '%s' for output.\033[0m\n", file_name[i].c_str());
+      exit(-1);
+    }
+    if(has_header) {
+      for(auto&& l : lines)
+        fprintf(file[i], "%s\n", l.c_str());
+      fflush(file[i]);
+    } else
+      WriteHeader(i);
+  }
+
+  mpi_barrier();
+}
+
+//-------------------------------------------------------------------------
+
 void
 ProbeOutput::SetupInterpolation(SpaceVariable3D &coordinates)
 {
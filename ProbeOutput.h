@@ -38,6 +38,9 @@ class ProbeOutput {
 
   std::vector<Vec3D> locations;
   FILE *file[Probes::SIZE]; //!< one file per solution variable
+  std::string file_name[Probes::SIZE];
+
+  bool append; //!< restart run: append to the existing files (see ReadRestartData)
 
   int line_number; //!< only used if the probes are along a line
 
@@ -51,7 +54,7 @@ class ProbeOutput {
 public:
   //! Constructor 1: write probe info to file. 
   ProbeOutput(MPI_Comm &comm_, OutputData &iod_output_, std::vector<VarFcnBase*> &vf_,
-              IonizationOperator* ion_, HyperelasticityOperator *heo_);
+              IonizationOperator* ion_, HyperelasticityOperator *heo_, bool append_ = false);
   //! Constructor 2: Probe is part of line_plot 
   ProbeOutput(MPI_Comm &comm_, OutputData &iod_output_, std::vector<VarFcnBase*> &vf_, 
               IonizationOperator* ion_, int line_number); 
@@ -70,6 +73,16 @@ public:
            SpaceVariable3D *Nu_T /* Calculated Eddy Viscosity */,
            bool force_write);
 
+  //! Checkpoint/restart: frame counter and the time of the last snapshot. For probe nodes, ReadRestartData
+  //! also removes the lines written at or after the checkpoint (time step time_step0) from the files.
+  void WriteRestartData(std::ostream &out);
+  void ReadRestartData(std::istream &in, double t0, int time_step0);
+
+private:
+
+  FILE* OpenFile(const char *fname, int i); //!< opens file[i] (appends in a restart run)
+  void WriteHeader(int i);
+
 public:
   //! Utililty functions
   
@@ -4,6 +4,7 @@
  ************************************************************************/
 
 #include <Reconstructor.h>
+#include <Timer.h>
 #include <DistancePointToSpheroid.h>
 #include <DistancePointToParallelepiped.h>
 #include <memory> //std::unique_ptr
@@ -335,8 +336,10 @@ void Reconstructor::Destroy()
 void Reconstructor::Reconstruct(SpaceVariable3D &V, SpaceVariable3D &Vl, SpaceVariable3D &Vr,
            SpaceVariable3D &Vb, SpaceVariable3D &Vt, SpaceVariable3D &Vk, SpaceVariable3D &Vf,
            SpaceVariable3D *ID, vector<std::unique_ptr<EmbeddedBoundaryDataSet> > *EBDS,
-           SpaceVariable3D *Selected, bool do_nothing_if_not_selected)
+           SpaceVariable3D *Selected, bool do_nothing_if_not_selected, bool complete_ghost_update)
 {
+  ScopedTimer scoped_timer("Reconstruct");
+
 
   //! Constant reconstruction is trivial.
   if(iod_rec.type == ReconstructionData::CONSTANT) {
@@ -401,6 +404,7 @@ void Reconstructor::Reconstruct(SpaceVariable3D &V, SpaceVariable3D &Vl, SpaceVa
   double*** u = (double***) U.GetDataPointer(); 
   if(iod_rec.varType == ReconstructionData::CONSERVATIVE ||
      iod_rec.varType == ReconstructionData::CONSERVATIVE_CHARACTERISTIC) {
+#pragma omp parallel for collapse(2)
     for(int k=kk0; k<kkmax; k++)
       for(int j=jj0; j<jjmax; j++)
         for(int i=ii0; i<iimax; i++)
@@ -412,17 +416,22 @@ void Reconstructor::Reconstruct(SpaceVariable3D &V, SpaceVariable3D &Vl, SpaceVa
    *  Loop through all the real cells.
    *  Calculate slope limiter --> slope --> face values
    ***************************************************************/
+  double alpha = iod_rec.generalized_minmod_coeff; //!< only needed for gen. minmod
+
+  //----------------------------------------------------------------
+  // Step 1: Reconstruction within the interior of each subdomain
+  //         (cells are independent of each other --> multi-threaded, each thread has its own work arrays)
+  //----------------------------------------------------------------
+#pragma omp parallel
+  {
   double dql[nDOF], dqr[nDOF], dqb[nDOF], dqt[nDOF], dqk[nDOF], dqf[nDOF];
   double sigmax[nDOF], sigmay[nDOF], sigmaz[nDOF]; 
 
   double a[3], b[3];
-  double alpha = iod_rec.generalized_minmod_coeff; //!< only needed for gen. minmod
   int kay[3]; //!< only for Van Albada
 
-  //----------------------------------------------------------------
-  // Step 1: Reconstruction within the interior of each subdomain
-  //----------------------------------------------------------------
   int vType;
+#pragma omp for collapse(2) schedule(static)
   for(int k=k0; k<kmax; k++) {
     for(int j=j0; j<jmax; j++) {
       for(int i=i0; i<imax; i++) {
@@ -780,28 +789,87 @@ RETRY:
       }
     }
   }
+  } //end of omp parallel
 
   
   //----------------------------------------------------------------
   // Step 2: Exchange info with neighbors
   //----------------------------------------------------------------
-  Vl.RestoreDataPointerAndInsert();
-  Vr.RestoreDataPointerAndInsert();
-  Vb.RestoreDataPointerAndInsert();
-  Vt.RestoreDataPointerAndInsert();
-  Vk.RestoreDataPointerAndInsert();
-  Vf.RestoreDataPointerAndInsert();
+  //  (Only globalVec is updated here. The exchanges are started and completed in Step 3, i.e.
+  //   CompleteReconstruction, which the caller may postpone to overlap them with computation.)
+  Vl.RestoreDataPointerAndMarkGhostsStale();
+  Vr.RestoreDataPointerAndMarkGhostsStale();
+  Vb.RestoreDataPointerAndMarkGhostsStale();
+  Vt.RestoreDataPointerAndMarkGhostsStale();
+  Vk.RestoreDataPointerAndMarkGhostsStale();
+  Vf.RestoreDataPointerAndMarkGhostsStale();
+
+  //! Restore vectors
+  CoeffA.RestoreDataPointerToLocalVector(); //!< no changes to vector
+  CoeffB.RestoreDataPointerToLocalVector(); //!< no changes to vector
+  CoeffK.RestoreDataPointerToLocalVector(); //!< no changes to vector
+  V.RestoreDataPointerToLocalVector(); //!< no changes to vector
+  //delta_xyz.RestoreDataPointerToLocalVector(); //!< no changes to vector
+
+  if(FixedByUser) FixedByUser->RestoreDataPointerToLocalVector();
+
+  if(ID) ID->RestoreDataPointerToLocalVector(); //!< no changes to vector
+
+  if(Selected) Selected->RestoreDataPointerToLocalVector(); //!< no changes to vector
+
+  if(xf.size()>0) {
+    for(auto it = EBDS->begin(); it != EBDS->end(); it++) 
+      (*it)->XForward_ptr->RestoreDataPointerToLocalVector();
+  }
+
+  U.RestoreDataPointerToLocalVector(); //!< internal variable
 
 
   //----------------------------------------------------------------
   // Step 3: Update ghost layer outside the physical domain
   //----------------------------------------------------------------
-  vl = (double***) Vl.GetDataPointer(); 
-  vr = (double***) Vr.GetDataPointer(); 
-  vb = (double***) Vb.GetDataPointer(); 
-  vt = (double***) Vt.GetDataPointer(); 
-  vk = (double***) Vk.GetDataPointer(); 
-  vf = (double***) Vf.GetDataPointer(); 
+  if(complete_ghost_update)
+    CompleteReconstruction(V, Vl, Vr, Vb, Vt, Vk, Vf, Selected, do_nothing_if_not_selected);
+
+}
+
+//--------------------------------------------------------------------------
+
+void Reconstructor::CompleteReconstruction(SpaceVariable3D &V, SpaceVariable3D &Vl, SpaceVariable3D &Vr,
+           SpaceVariable3D &Vb, SpaceVariable3D &Vt, SpaceVariable3D &Vk, SpaceVariable3D &Vf,
+           SpaceVariable3D *Selected, bool do_nothing_if_not_selected)
+{
+  ScopedTimer scoped_timer("CompleteReconstruction");
+
+  //! Start all the exchanges (if not started already), so that the messages are in flight together
+  Vl.BeginGhostUpdate();
+  Vr.BeginGhostUpdate();
+  Vb.BeginGhostUpdate();
+  Vt.BeginGhostUpdate();
+  Vk.BeginGhostUpdate();
+  Vf.BeginGhostUpdate();
+
+  if(iod_rec.type == ReconstructionData::CONSTANT) {
+    Vl.UpdateGhosts();  Vr.UpdateGhosts();  Vb.UpdateGhosts();
+    Vt.UpdateGhosts();  Vk.UpdateGhosts();  Vf.UpdateGhosts();
+    return; //the external ghost layer is copied from V
+  }
+
+  int NX, NY, NZ;
+  delta_xyz.GetGlobalSize(&NX, &NY, &NZ);
+
+  int nDOF = V.NumDOF();
+
+  double*** v   = (double***) V.GetDataPointer(); 
+  double*** sel = Selected ? Selected->GetDataPointer() : NULL;
+
+  //! The exchanges are completed here (images may be in the internal ghost layer)
+  double*** vl = (double***) Vl.GetDataPointer(); 
+  double*** vr = (double***) Vr.GetDataPointer(); 
+  double*** vb = (double***) Vb.GetDataPointer(); 
+  double*** vt = (double***) Vt.GetDataPointer(); 
+  double*** vk = (double***) Vk.GetDataPointer(); 
+  double*** vf = (double***) Vf.GetDataPointer(); 
   int i,j,k,ii,jj,kk;
 
   for(auto gp = ghost_nodes_outer->begin(); gp != ghost_nodes_outer->end(); gp++) {
@@ -895,26 +963,10 @@ RETRY:
   Vk.RestoreDataPointerToLocalVector(); //no need to communicate
   Vf.RestoreDataPointerToLocalVector(); //no need to communicate
 
-  //! Restore vectors
-  CoeffA.RestoreDataPointerToLocalVector(); //!< no changes to vector
-  CoeffB.RestoreDataPointerToLocalVector(); //!< no changes to vector
-  CoeffK.RestoreDataPointerToLocalVector(); //!< no changes to vector
   V.RestoreDataPointerToLocalVector(); //!< no changes to vector
-  //delta_xyz.RestoreDataPointerToLocalVector(); //!< no changes to vector
-
-  if(FixedByUser) FixedByUser->RestoreDataPointerToLocalVector();
-
-  if(ID) ID->RestoreDataPointerToLocalVector(); //!< no changes to vector
 
   if(Selected) Selected->RestoreDataPointerToLocalVector(); //!< no changes to vector
 
-  if(xf.size()>0) {
-    for(auto it = EBDS->begin(); it != EBDS->end(); it++) 
-      (*it)->XForward_ptr->RestoreDataPointerToLocalVector();
-  }
-
-  U.RestoreDataPointerToLocalVector(); //!< internal variable
-
 }
 
 //--------------------------------------------------------------------------
@@ -966,6 +1018,7 @@ void Reconstructor::ReconstructIn1D(int dir/*0~x,1~y,2~z*/, SpaceVariable3D &U,
   double alpha = iod_rec.generalized_minmod_coeff; //!< only needed for gen. minmod
   int kay; //!< only for Van Albada
 
+#pragma omp parallel for collapse(2) private(sigma, a, b, kay) firstprivate(dq0, dq1)
   for(int k=k0; k<kmax; k++) {
     for(int j=j0; j<jmax; j++) {
       for(int i=i0; i<imax; i++) {
@@ -1031,11 +1084,13 @@ void Reconstructor::ReconstructIn1D(int dir/*0~x,1~y,2~z*/, SpaceVariable3D &U,
     }
   }
 
-  Um.RestoreDataPointerAndInsert();
-  Up.RestoreDataPointerAndInsert();
+  Um.RestoreDataPointerAndMarkGhostsStale();  Um.BeginGhostUpdate();
+  Up.RestoreDataPointerAndMarkGhostsStale();  Up.BeginGhostUpdate();
 
-  if(Slope)
-    Slope->RestoreDataPointerAndInsert(); 
+  if(Slope) {
+    Slope->RestoreDataPointerAndMarkGhostsStale();
+    Slope->BeginGhostUpdate();
+  }
 
 
   // Now, go over the ghost layer
@@ -74,7 +74,17 @@ public:
            SpaceVariable3D *ID = NULL,
            vector<std::unique_ptr<EmbeddedBoundaryDataSet> > *EBDS = nullptr,
            SpaceVariable3D *Selected = NULL,
-           bool do_nothing_if_not_selected = true); //!< the last input is used (only?) in LevelSetOperator
+           bool do_nothing_if_not_selected = true, //!< used (only?) in LevelSetOperator
+           bool complete_ghost_update = true);
+
+  /** The last part of Reconstruct: completes the exchange of the reconstructed states and populates
+    * the ghost layer outside the physical domain. It needs to be called separately only if
+    * Reconstruct was called with complete_ghost_update = false. In that case, the caller may modify
+    * the states within the subdomain interior (e.g., clipping), and then work on the interior while
+    * the exchanges are in flight (see SpaceVariable3D::GetDataPointer(false)). Collective. */
+  void CompleteReconstruction(SpaceVariable3D &V, SpaceVariable3D &Vl, SpaceVariable3D &Vr,
+           SpaceVariable3D &Vb, SpaceVariable3D &Vt, SpaceVariable3D &Vk, SpaceVariable3D &Vf,
+           SpaceVariable3D *Selected = NULL, bool do_nothing_if_not_selected = true);
 
   /** This function applies reconstruction directly to the input variable U. In other words, no
     * conversions are done inside the function.*/
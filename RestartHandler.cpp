@@ -0,0 +1,485 @@
+/************************************************************************
+ * Copyright © 2020 The Multiphysics Modeling and Computation (M2C) Lab
+ * <kevin.wgy@gmail.com> <kevinw3@vt.edu>
+ ************************************************************************/
+
+#include<RestartHandler.h>
+#include<EmbeddedBoundaryOperator.h>
+#include<LevelSetOperator.h>
+#include<TimeIntegrator.h>
+#include<Output.h>
+#include<Utils.h>
+#include<Timer.h>
+#include<sstream>
+#include<cstdio> //std::rename, std::remove
+#include<cfloat> //DBL_MAX
+using std::string;
+using std::vector;
+using std::multimap;
+using std::pair;
+using std::to_string;
+
+extern double start_time;
+
+//! version of the file format (to be incremented if the format changes)
+static const int RESTART_FILE_VERSION = 3;
+
+//---------------------------------------------------------
+// Each file is a sequence of records: [int name_length][name][long long num_bytes][data]
+//---------------------------------------------------------
+
+static void
+WriteRecordHeader(std::ostream &file, const string &name, long long nbytes)
+{
+  int len = name.size();
+  file.write(reinterpret_cast<const char*>(&len), sizeof(int));
+  file.write(name.data(), len);
+  file.write(reinterpret_cast<const char*>(&nbytes), sizeof(long long));
+}
+
+//---------------------------------------------------------
+
+static void
+WriteRecord(std::ostream &file, const string &name, const string &data)
+{
+  WriteRecordHeader(file, name, data.size());
+  file.write(data.data(), data.size());
+}
+
+//---------------------------------------------------------
+
+static void
+WriteField(std::ostream &file, const string &name, SpaceVariable3D &U)
+{
+  long long nbytes = 7*sizeof(int) + sizeof(double)*U.NumNodesIncludingGhosts()*U.NumDOF();
+  WriteRecordHeader(file, name, nbytes);
+  U.WriteLocalArrayToStream(file);
+}
+
+//---------------------------------------------------------
+
+//! reads the header of a record. Returns false at the end of the stream.
+static bool
+ReadRecordHeader(std::istream &file, string &name, long long &nbytes)
+{
+  int len = 0;
+  if(!file.read(reinterpret_cast<char*>(&len), sizeof(int)) || len<=0)
+    return false;
+  name.resize(len);
+  file.read(&name[0], len);
+  file.read(reinterpret_cast<char*>(&nbytes), sizeof(long long));
+  return (bool)file && nbytes>=0;
+}
+
+//---------------------------------------------------------
+
+RestartHandler::RestartHandler(MPI_Comm &comm_, IoData &iod_) : comm(comm_), iod(iod_),
+                               last_checkpoint_time(-DBL_MAX), last_checkpoint_step(-1), live_step(-1),
+                               time0(0.0), dt0(0.0), time_step0(0)
+{
+  last_checkpoint_clocktime = walltime();
+}
+
+//---------------------------------------------------------
+
+RestartHandler::~RestartHandler()
+{
+  if(field_file.is_open())
+    field_file.close();
+}
+
+//---------------------------------------------------------
+
+bool
+RestartHandler::WriteRestartFiles(double t, double dt, int time_step, SpaceVariable3D &V, SpaceVariable3D &ID,
+                                  vector<SpaceVariable3D*> &Phi, vector<SpaceVariable3D*> &NPhi,
+                                  vector<SpaceVariable3D*> &KappaPhi, SpaceVariable3D *L, SpaceVariable3D *Xi,
+                                  SpaceVariable3D *Vturb, EmbeddedBoundaryOperator *embed,
+                                  TimeIntegratorBase &integrator, Output &out,
+                                  multimap<int, pair<int,int> > &id2closure, bool force_write)
+{
+  if(strcmp(iod.restart.filename_base, "") == 0)
+    return false;
+
+  if(time_step == last_checkpoint_step) //already written
+    return false;
+
+  int mpi_rank, mpi_size;
+  MPI_Comm_rank(comm, &mpi_rank);
+  MPI_Comm_size(comm, &mpi_size);
+
+  //! Check whether it is time to write
+  bool write_now = force_write || isTimeToWrite(t, dt, time_step, iod.restart.frequency_dt,
+                                                iod.restart.frequency, last_checkpoint_time, false);
+  if(!write_now && iod.restart.frequency_clocktime>0.0) {
+    int due = (walltime() - last_checkpoint_clocktime >= iod.restart.frequency_clocktime) ? 1 : 0;
+    MPI_Bcast(&due, 1, MPI_INT, 0, comm); //clocks may differ slightly. Proc #0 decides.
+    write_now = (due==1);
+  }
+  if(!write_now)
+    return false;
+
+  ScopedTimer scoped_timer("Checkpoint");
+
+  string base = string(iod.output.prefix) + string(iod.restart.filename_base);
+
+  //! Step 1: Each processor writes its own file. (A new file, not referenced by the current meta file.)
+  string fname = GetFieldFileName(base, time_step, mpi_rank);
+  std::ofstream file(fname.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+
+  // Note: WriteField may update ghost layers (collective). So it is called even if the file failed to open.
+  int header[4] = {RESTART_FILE_VERSION, mpi_size, mpi_rank, time_step};
+  WriteRecord(file, "Header", string(reinterpret_cast<const char*>(header), sizeof(header)));
+
+  WriteField(file, "V", V);
+  WriteField(file, "ID", ID);
+  for(int i=0; i<(int)Phi.size(); i++) {
+    WriteField(file, "Phi" + to_string(i), *Phi[i]);
+    WriteField(file, "NPhi" + to_string(i), *NPhi[i]);
+    WriteField(file, "KappaPhi" + to_string(i), *KappaPhi[i]);
+  }
+  if(L)
+    WriteField(file, "L", *L);
+  if(Xi)
+    WriteField(file, "Xi", *Xi);
+  if(Vturb)
+    WriteField(file, "Vturb", *Vturb);
+
+  file.close();
+  int error = file.fail() ? 1 : 0;
+  MPI_Allreduce(MPI_IN_PLACE, &error, 1, MPI_INT, MPI_MAX, comm);
+  if(error) {
+    print_error(comm, "*** Error: Unable to write restart file(s) %s.*.\n", base.c_str());
+    exit_mpi();
+  }
+
+  //! Step 2: Proc #0 writes the meta file (with data that are the same on all the processors).
+  //!         The field files are complete at this point (see the Allreduce above). Renaming the
+  //!         meta file makes the new checkpoint current.
+  if(mpi_rank == 0) {
+    string mname = base + ".meta";
+    std::ofstream mfile((mname + ".tmp").c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if(mfile) {
+      std::ostringstream header;
+      int NX, NY, NZ;
+      V.GetGlobalSize(&NX, &NY, &NZ);
+      int ints[7] = {RESTART_FILE_VERSION, mpi_size, NX, NY, NZ, (int)Phi.size(), time_step};
+      double reals[2] = {t, dt};
+      header.write(reinterpret_cast<const char*>(ints), sizeof(ints));
+      header.write(reinterpret_cast<const char*>(reals), sizeof(reals));
+      WriteRecord(mfile, "Header", header.str());
+
+      std::ostringstream closures;
+      int n = id2closure.size();
+      closures.write(reinterpret_cast<const char*>(&n), sizeof(int));
+      for(auto&& c : id2closure) {
+        int triple[3] = {c.first, c.second.first, c.second.second};
+        closures.write(reinterpret_cast<const char*>(triple), sizeof(triple));
+      }
+      WriteRecord(mfile, "Closures", closures.str());
+
+      std::ostringstream integ;
+      integrator.WriteRestartData(integ);
+      WriteRecord(mfile, "Integrator", integ.str());
+
+      std::ostringstream outp;
+      out.WriteRestartData(outp);
+      WriteRecord(mfile, "Output", outp.str());
+
+      if(embed) {
+        std::ostringstream surf;
+        embed->WriteRestartData(surf);
+        WriteRecord(mfile, "EmbeddedSurfaces", surf.str());
+      }
+
+      mfile.close();
+    }
+    error = (!mfile || mfile.fail()) ? 1 : 0;
+    if(!error)
+      std::rename((mname + ".tmp").c_str(), mname.c_str());
+  }
+  MPI_Bcast(&error, 1, MPI_INT, 0, comm);
+  if(error) {
+    print_error(comm, "*** Error: Unable to write restart file %s.meta.\n", base.c_str());
+    exit_mpi();
+  }
+
+  //! Step 3: Delete the field files of the previous checkpoint (no longer referenced)
+  if(live_step>=0 && live_step != time_step)
+    std::remove(GetFieldFileName(base, live_step, mpi_rank).c_str());
+  live_step = time_step;
+
+  last_checkpoint_time = t;
+  last_checkpoint_step = time_step;
+  last_checkpoint_clocktime = walltime();
+
+  print(comm, "- Wrote restart files at %e (time step %d) to %s.*\n", t, time_step, base.c_str());
+
+  return true;
+}
+
+//---------------------------------------------------------
+
+bool
+RestartHandler::ClockTimeLimitReached()
+{
+  if(iod.restart.clocktime_limit<=0.0)
+    return false;
+
+  int reached = (walltime() - start_time >= iod.restart.clocktime_limit) ? 1 : 0;
+  MPI_Bcast(&reached, 1, MPI_INT, 0, comm); //proc #0 decides
+  return reached==1;
+}
+
+//---------------------------------------------------------
+
+void
+RestartHandler::ReadMetaFile()
+{
+  int mpi_rank, mpi_size;
+  MPI_Comm_rank(comm, &mpi_rank);
+  MPI_Comm_size(comm, &mpi_size);
+
+  string mname = string(iod.restart.input_file) + ".meta";
+
+  //! proc #0 reads the entire file, then broadcasts it
+  string buffer;
+  long long size = -1;
+  if(mpi_rank == 0) {
+    std::ifstream mfile(mname.c_str(), std::ios::in | std::ios::binary);
+    if(mfile) {
+      std::ostringstream content;
+      content << mfile.rdbuf();
+      buffer = content.str();
+      size = buffer.size();
+    }
+  }
+  MPI_Bcast(&size, 1, MPI_LONG_LONG, 0, comm);
+  if(size<0) {
+    print_error(comm, "*** Error: Unable to open restart file %s.\n", mname.c_str());
+    exit_mpi();
+  }
+  buffer.resize(size);
+  MPI_Bcast(&buffer[0], size, MPI_CHAR, 0, comm);
+
+  std::istringstream in(buffer);
+  string name;
+  long long nbytes;
+  while(ReadRecordHeader(in, name, nbytes)) {
+    string data(nbytes, '\0');
+    in.read(&data[0], nbytes);
+    meta[name] = data;
+  }
+
+  string header = GetMetaRecord("Header");
+  int ints[7];
+  double reals[2];
+  if(header.size() != sizeof(ints) + sizeof(reals)) {
+    print_error(comm, "*** Error: %s is not a valid restart file.\n", mname.c_str());
+    exit_mpi();
+  }
+  memcpy(ints, header.data(), sizeof(ints));
+  memcpy(reals, header.data() + sizeof(ints), sizeof(reals));
+  if(ints[0] != RESTART_FILE_VERSION) {
+    print_error(comm, "*** Error: Restart file %s has version %d (expected: %d).\n", mname.c_str(),
+                ints[0], RESTART_FILE_VERSION);
+    exit_mpi();
+  }
+  if(ints[1] != mpi_size) {
+    print_error(comm, "*** Error: Restart files were written by %d processors. Running with %d processors.\n",
+                ints[1], mpi_size);
+    exit_mpi();
+  }
+  time_step0 = ints[6];
+  time0      = reals[0];
+  dt0        = reals[1];
+
+  //! If new checkpoints overwrite this one, the checkpoint read here remains current until a new one is written
+  if(string(iod.restart.input_file) == string(iod.output.prefix) + string(iod.restart.filename_base)) {
+    live_step = time_step0;
+    last_checkpoint_step = time_step0; //no need to write it again
+  }
+
+  print(comm, "- Restarting from %s.* (t = %e, time step %d).\n", iod.restart.input_file, time0, time_step0);
+}
+
+//---------------------------------------------------------
+
+string
+RestartHandler::GetMetaRecord(const char *name)
+{
+  auto it = meta.find(name);
+  if(it == meta.end()) {
+    print_error(comm, "*** Error: Unable to find '%s' in restart file %s.meta.\n", name, iod.restart.input_file);
+    exit_mpi();
+  }
+  return it->second;
+}
+
+//---------------------------------------------------------
+
+void
+RestartHandler::ReadEmbeddedSurfaces(EmbeddedBoundaryOperator &embed)
+{
+  std::istringstream in(GetMetaRecord("EmbeddedSurfaces"));
+  embed.ReadRestartData(in, time0);
+}
+
+//---------------------------------------------------------
+
+void
+RestartHandler::OpenFieldFile()
+{
+  int mpi_rank, mpi_size;
+  MPI_Comm_rank(comm, &mpi_rank);
+  MPI_Comm_size(comm, &mpi_size);
+
+  string fname = GetFieldFileName(iod.restart.input_file, time_step0, mpi_rank);
+  field_file.open(fname.c_str(), std::ios::in | std::ios::binary);
+
+  //! build the index of records
+  int error = field_file ? 0 : 1;
+  if(!error) {
+    string name;
+    long long nbytes;
+    while(ReadRecordHeader(field_file, name, nbytes)) {
+      field_index[name] = field_file.tellg();
+      field_file.seekg(nbytes, std::ios::cur);
+    }
+    field_file.clear(); //clear eof
+
+    auto it = field_index.find("Header");
+    if(it == field_index.end())
+      error = 1;
+    else {
+      int header[4];
+      field_file.seekg(it->second);
+      field_file.read(reinterpret_cast<char*>(header), sizeof(header));
+      if(!field_file || header[0] != RESTART_FILE_VERSION || header[1] != mpi_size || header[2] != mpi_rank ||
+         header[3] != time_step0)
+        error = 1;
+    }
+  }
+  MPI_Allreduce(MPI_IN_PLACE, &error, 1, MPI_INT, MPI_MAX, comm);
+  if(error) {
+    print_error(comm, "*** Error: Unable to read restart file(s) %s.*, or they do not match %s.meta.\n",
+                iod.restart.input_file, iod.restart.input_file);
+    exit_mpi();
+  }
+}
+
+//---------------------------------------------------------
+
+void
+RestartHandler::ReadField(const char *name, SpaceVariable3D &U)
+{
+  int error = 0;
+  auto it = field_index.find(name);
+  if(it == field_index.end())
+    error = 1;
+  else {
+    field_file.seekg(it->second);
+    if(!U.ReadLocalArrayFromStream(field_file))
+      error = 2;
+  }
+  MPI_Allreduce(MPI_IN_PLACE, &error, 1, MPI_INT, MPI_MAX, comm);
+  if(error==1) {
+    print_error(comm, "*** Error: Unable to find '%s' in restart files %s.*.\n", name, iod.restart.input_file);
+    exit_mpi();
+  }
+  if(error==2) {
+    print_error(comm, "*** Error: '%s' in restart files %s.* does not match the mesh or domain partition.\n",
+                name, iod.restart.input_file);
+    exit_mpi();
+  }
+}
+
+//---------------------------------------------------------
+
+multimap<int, pair<int,int> >
+RestartHandler::ReadInitialCondition(SpaceVariable3D &V, SpaceVariable3D &ID, vector<SpaceVariable3D*> &Phi,
+                                     vector<SpaceVariable3D*> &NPhi, vector<SpaceVariable3D*> &KappaPhi,
+                                     vector<LevelSetOperator*> &lso)
+{
+  ScopedTimer scoped_timer("ReadRestart");
+
+  //! check mesh and level sets
+  string header = GetMetaRecord("Header");
+  int ints[7];
+  memcpy(ints, header.data(), sizeof(ints));
+  int NX, NY, NZ;
+  V.GetGlobalSize(&NX, &NY, &NZ);
+  if(ints[2] != NX || ints[3] != NY || ints[4] != NZ) {
+    print_error(comm, "*** Error: Mesh in the restart files (%d x %d x %d) does not match the input file "
+                "(%d x %d x %d).\n", ints[2], ints[3], ints[4], NX, NY, NZ);
+    exit_mpi();
+  }
+  if(ints[5] != (int)Phi.size()) {
+    print_error(comm, "*** Error: Number of level sets in the restart files (%d) does not match the "
+                "input file (%d).\n", ints[5], (int)Phi.size());
+    exit_mpi();
+  }
+
+  OpenFieldFile();
+
+  ReadField("V", V);
+  ReadField("ID", ID);
+  for(int i=0; i<(int)Phi.size(); i++) {
+    ReadField(("Phi" + to_string(i)).c_str(), *Phi[i]);
+    ReadField(("NPhi" + to_string(i)).c_str(), *NPhi[i]);
+    ReadField(("KappaPhi" + to_string(i)).c_str(), *KappaPhi[i]);
+    if(lso[i]->NarrowBand())
+      lso[i]->ConstructNarrowBandInReinitializer(*Phi[i]);
+  }
+
+  //! id2closure (only relevant with embedded surfaces)
+  multimap<int, pair<int,int> > id2closure;
+  std::istringstream in(GetMetaRecord("Closures"));
+  int n = 0;
+  in.read(reinterpret_cast<char*>(&n), sizeof(int));
+  for(int i=0; i<n; i++) {
+    int triple[3];
+    in.read(reinterpret_cast<char*>(triple), sizeof(triple));
+    id2closure.insert(std::make_pair(triple[0], std::make_pair(triple[1], triple[2])));
+  }
+
+  return id2closure;
+}
+
+//---------------------------------------------------------
+
+void
+RestartHandler::ReadAuxiliaryVariables(SpaceVariable3D *L, SpaceVariable3D *Xi, SpaceVariable3D *Vturb)
+{
+  if(L && field_index.find("L") != field_index.end()) //otherwise, L is computed before time-stepping
+    ReadField("L", *L);
+  if(Xi)
+    ReadField("Xi", *Xi);
+  if(Vturb)
+    ReadField("Vturb", *Vturb);
+}
+
+//---------------------------------------------------------
+
+void
+RestartHandler::ReadSolverStates(TimeIntegratorBase &integrator, Output &out, double &t, double &dt,
+                                 int &time_step)
+{
+  std::istringstream integ(GetMetaRecord("Integrator"));
+  integrator.ReadRestartData(integ);
+
+  std::istringstream outp(GetMetaRecord("Output"));
+  out.ReadRestartData(outp, time0, time_step0);
+
+  t         = time0;
+  dt        = dt0;
+  time_step = time_step0;
+
+  last_checkpoint_time = time0; //no need to re-write the same checkpoint
+  last_checkpoint_step = time_step0;
+
+  field_file.close();
+  field_index.clear();
+}
+
+//---------------------------------------------------------
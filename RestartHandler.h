@@ -0,0 +1,102 @@
+/************************************************************************
+ * Copyright © 2020 The Multiphysics Modeling and Computation (M2C) Lab
+ * <kevin.wgy@gmail.com> <kevinw3@vt.edu>
+ ************************************************************************/
+
+#ifndef _RESTART_HANDLER_H_
+#define _RESTART_HANDLER_H_
+
+#include<IoData.h>
+#include<SpaceVariable.h>
+#include<fstream>
+#include<string>
+#include<cstring>
+#include<map>
+
+class EmbeddedBoundaryOperator;
+class LevelSetOperator;
+class TimeIntegratorBase;
+class Output;
+
+/*********************************************************************
+ * class RestartHandler writes and reads checkpoint (restart) files.
+ * A checkpoint consists of
+ *   - <Output.Prefix><FileName>.meta, written by proc #0: time and time
+ *     step counters, output counters (incl. probes and Lagrangian
+ *     output), state of the time integrator, embedded surfaces (nodal
+ *     coords & velocities), and the material ID of enclosed regions
+ *     (id2closure);
+ *   - <Output.Prefix><FileName>.<time step>.<rank>, written by each
+ *     processor: the local arrays (incl. ghost layers) of V, ID, Phi,
+ *     NPhi, KappaPhi, L, Xi, and Vturb, in raw binary format.
+ * Each file is a sequence of named records, so the variables can be
+ * read in any order. Each checkpoint has its own field files. The meta
+ * file is written last (as ".tmp", then renamed), and only this rename
+ * makes the new checkpoint current. The field files of the previous
+ * checkpoint are deleted after that. So a crash while writing does not
+ * destroy the previous checkpoint.
+ * Notes:
+ *   - A restart run must use the same mesh and number of processors.
+ *   - A restart run skips SpaceInitializer: V, ID, Phi, etc. are read
+ *     directly from the files.
+ *********************************************************************
+*/
+
+class RestartHandler
+{
+  MPI_Comm &comm;
+  IoData &iod;
+
+  //! writing
+  double last_checkpoint_time;
+  int last_checkpoint_step;
+  double last_checkpoint_clocktime;
+  int live_step; //!< time step of the checkpoint referenced by <Output.Prefix><FileName>.meta (-1: none/unknown)
+
+  //! reading
+  std::map<std::string, std::string> meta; //!< records of the .meta file (small)
+  std::ifstream field_file; //!< the .<time step>.<rank> file
+  std::map<std::string, std::streampos> field_index; //!< position of each record in field_file
+
+  double time0, dt0; //!< time and time step size at the checkpoint
+  int time_step0;
+
+public:
+
+  RestartHandler(MPI_Comm &comm_, IoData &iod_);
+  ~RestartHandler();
+
+  bool IsRestart() {return strcmp(iod.restart.input_file, "") != 0;}
+
+  //! Reading (called in the following order, each one only if the corresponding object exists)
+  void ReadMetaFile(); //!< collective. Proc #0 reads, then broadcasts
+  void ReadEmbeddedSurfaces(EmbeddedBoundaryOperator &embed); //!< before the surfaces are tracked
+  std::multimap<int, std::pair<int,int> >
+  ReadInitialCondition(SpaceVariable3D &V, SpaceVariable3D &ID, std::vector<SpaceVariable3D*> &Phi,
+                       std::vector<SpaceVariable3D*> &NPhi, std::vector<SpaceVariable3D*> &KappaPhi,
+                       std::vector<LevelSetOperator*> &lso); //!< replaces SpaceInitializer::SetInitialCondition
+  void ReadAuxiliaryVariables(SpaceVariable3D *L, SpaceVariable3D *Xi, SpaceVariable3D *Vturb);
+  void ReadSolverStates(TimeIntegratorBase &integrator, Output &out, double &t, double &dt, int &time_step);
+
+  //! Writing (collective). Returns true if the checkpoint is written.
+  bool WriteRestartFiles(double t, double dt, int time_step, SpaceVariable3D &V, SpaceVariable3D &ID,
+                         std::vector<SpaceVariable3D*> &Phi, std::vector<SpaceVariable3D*> &NPhi,
+                         std::vector<SpaceVariable3D*> &KappaPhi, SpaceVariable3D *L, SpaceVariable3D *Xi,
+                         SpaceVariable3D *Vturb, EmbeddedBoundaryOperator *embed, TimeIntegratorBase &integrator,
+                         Output &out, std::multimap<int, std::pair<int,int> > &id2closure, bool force_write);
+
+  //! Collective. Whether the clock time limit specified by the user (if any) has been reached
+  bool ClockTimeLimitReached();
+
+private:
+
+  std::string GetFieldFileName(const std::string &base, int time_step, int rank) {
+    return base + "." + std::to_string(time_step) + "." + std::to_string(rank);}
+
+  void OpenFieldFile();
+  void ReadField(const char *name, SpaceVariable3D &U);
+  std::string GetMetaRecord(const char *name);
+
+};
+
+#endif
@@ -8,24 +8,137 @@
 
 #include <Vector3D.h>
 #include <Vector5D.h>
+#include <vector>
+#include <cassert>
+
+/*****************************************************************
+ * class RiemannSolutionMap stores the solutions of Riemann problems
+ * at one side (e.g., x-) of cell interfaces, keyed by the cell index
+ * (k,j,i). Entries are stored contiguously in a vector. Look-ups use
+ * an open-addressing hash table (linear probing) that holds indices
+ * into this vector. Clear() keeps the allocated memory, so refilling
+ * the map in the next time step does not allocate.
+ *****************************************************************/
+
+class RiemannSolutionMap {
+
+public:
+
+  struct Entry {
+    unsigned long long key;
+    Vec5D state;
+    int id;
+    int slot; //!< position in the hash table
+  };
+
+private:
+
+  std::vector<Entry> entries;
+  std::vector<int> slots; //!< -1: empty. Size is a power of 2 (or 0)
+  unsigned long long mask;
+
+public:
+
+  RiemannSolutionMap() : mask(0) {}
+  ~RiemannSolutionMap() {}
+
+  inline int size() const {return entries.size();}
+  inline bool empty() const {return entries.empty();}
+
+  //! for iterating over all the entries (in the order of insertion)
+  inline std::vector<Entry>::const_iterator begin() const {return entries.begin();}
+  inline std::vector<Entry>::const_iterator end() const {return entries.end();}
+
+  //! O(size), not O(capacity)
+  void Clear() {
+    for(auto&& e : entries)
+      slots[e.slot] = -1;
+    entries.clear();
+  }
+
+  //! Inserts a new entry, or overwrites the existing one with the same index
+  void Insert(const Int3 &ind /*k,j,i*/, const Vec5D &state, int id) {
+    if(2*(entries.size()+1) > slots.size())
+      Rehash(slots.empty() ? 64 : 2*slots.size());
+    unsigned long long key = Key(ind);
+    unsigned long long s = Hash(key);
+    while(slots[s]>=0) {
+      Entry &e(entries[slots[s]]);
+      if(e.key == key) {
+        e.state = state;
+        e.id = id;
+        return;
+      }
+      s = (s+1) & mask;
+    }
+    slots[s] = entries.size();
+    entries.push_back(Entry{key, state, id, (int)s});
+  }
+
+  //! Returns NULL if not found
+  const Entry* Find(const Int3 &ind /*k,j,i*/) const {
+    if(entries.empty())
+      return NULL;
+    unsigned long long key = Key(ind);
+    unsigned long long s = Hash(key);
+    while(slots[s]>=0) {
+      const Entry &e(entries[slots[s]]);
+      if(e.key == key)
+        return &e;
+      s = (s+1) & mask;
+    }
+    return NULL;
+  }
+
+private:
+
+  //! Packs (k,j,i) into 64 bits (21 bits each). Indices must be in [-1, 2^21-2] (incl. ghost layer)
+  inline unsigned long long Key(const Int3 &ind) const {
+    assert(ind[0]>=-1 && ind[0]<(1<<21)-1 && ind[1]>=-1 && ind[1]<(1<<21)-1 &&
+           ind[2]>=-1 && ind[2]<(1<<21)-1);
+    return ((unsigned long long)(ind[0]+1)<<42) | ((unsigned long long)(ind[1]+1)<<21)
+           | (unsigned long long)(ind[2]+1);
+  }
+
+  //! Fibonacci hashing
+  inline unsigned long long Hash(unsigned long long key) const {
+    key *= 0x9E3779B97F4A7C15ULL;
+    return (key ^ (key>>32)) & mask;
+  }
+
+  void Rehash(int new_size) {
+    slots.assign(new_size, -1);
+    mask = new_size - 1;
+    for(int n=0; n<(int)entries.size(); n++) {
+      unsigned long long s = Hash(entries[n].key);
+      while(slots[s]>=0)
+        s = (s+1) & mask;
+      slots[s] = n;
+      entries[n].slot = s;
+    }
+  }
+
+};
+
+//-----------------------------------------------------------------
 
 class RiemannSolutions {
 
 public: //for the moment, keep everything public
 
-  //Solutions of exact Riemann problems
-  std::map<Int3/*k,j,i*/, std::pair<Vec5D/*state*/, int/*ID*/> > left;   //x-
-  std::map<Int3/*k,j,i*/, std::pair<Vec5D/*state*/, int/*ID*/> > right;  //x+
-  std::map<Int3/*k,j,i*/, std::pair<Vec5D/*state*/, int/*ID*/> > bottom; //y-
-  std::map<Int3/*k,j,i*/, std::pair<Vec5D/*state*/, int/*ID*/> > top;    //y+
-  std::map<Int3/*k,j,i*/, std::pair<Vec5D/*state*/, int/*ID*/> > back;   //z-
-  std::map<Int3/*k,j,i*/, std::pair<Vec5D/*state*/, int/*ID*/> > front;  //z+
+  //Solutions of exact Riemann problems (state & ID), keyed by (k,j,i)
+  RiemannSolutionMap left;   //x-
+  RiemannSolutionMap right;  //x+
+  RiemannSolutionMap bottom; //y-
+  RiemannSolutionMap top;    //y+
+  RiemannSolutionMap back;   //z-
+  RiemannSolutionMap front;  //z+
 
   RiemannSolutions() {}
   ~RiemannSolutions() {}
 
   void Clear() {
-    left.clear(); right.clear(); bottom.clear(); top.clear(); back.clear(); front.clear();
+    left.Clear(); right.Clear(); bottom.Clear(); top.Clear(); back.Clear(); front.Clear();
   }
 };
 
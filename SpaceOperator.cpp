@@ -4,6 +4,7 @@
  ************************************************************************/
 
 #include <SpaceOperator.h>
+#include <Timer.h>
 #include <Utils.h>
 #include <FluxFcnLLF.h>
 #include <Vector3D.h>
@@ -33,6 +34,23 @@ using namespace GeoTools;
 extern int verbose;
 extern int INACTIVE_MATERIAL_ID;
 
+//-----------------------------------------------------
+//! Splits a row of nodes (i = i0, ..., imax-1) into runs of consecutive nodes with the same material ID,
+//! and calls fun(id, ib, ie) for each run [ib, ie). Used to evaluate the EOS in batches.
+template<typename Fun>
+static inline void ForEachMaterialRun(double *idrow, int i0, int imax, Fun fun)
+{
+  int ib = i0;
+  while(ib<imax) {
+    int myid = idrow[ib];
+    int ie = ib+1;
+    while(ie<imax && (int)idrow[ie] == myid)
+      ie++;
+    fun(myid, ib, ie);
+    ib = ie;
+  }
+}
+
 //-----------------------------------------------------
 
 SpaceOperator::SpaceOperator(MPI_Comm &comm_, DataManagers3D &dm_all_, IoData &iod_,
@@ -84,6 +102,12 @@ SpaceOperator::SpaceOperator(MPI_Comm &comm_, DataManagers3D &dm_all_, IoData &i
     interfluxFcn = new FluxFcnLLF(varFcn, iod);
   }
 
+  interface_riemann_problems.resize(get_max_threads());
+
+  if(iod.schemes.ns.layout == SchemeData::STRUCTURE_OF_ARRAYS)
+    print_warning(comm, "Warning: DataLayout = StructureOfArrays is experimental. Each state conversion gathers "
+                  "and scatters the full field, which may offset the gain from vectorization.\n");
+
 }
 
 //-----------------------------------------------------
@@ -122,6 +146,9 @@ void SpaceOperator::Destroy()
   Vf.Destroy();
   Utmp.Destroy();
   Tag.Destroy();
+
+  Usoa.Destroy();
+  Vsoa.Destroy();
 }
 
 //-----------------------------------------------------
@@ -553,9 +580,14 @@ void SpaceOperator::CreateGhostNodeLists(bool screenout)
 void SpaceOperator::ConservativeToPrimitive(SpaceVariable3D &U, SpaceVariable3D &ID, SpaceVariable3D &V,
                                             bool workOnGhost)
 {
-  Vec5D*** u = (Vec5D***) U.GetDataPointer();
-  Vec5D*** v = (Vec5D***) V.GetDataPointer();
-  double*** id = (double***) ID.GetDataPointer();
+  if(iod.schemes.ns.layout == SchemeData::STRUCTURE_OF_ARRAYS) {
+    ConservativeToPrimitiveSoA(U, ID, V, workOnGhost);
+    return;
+  }
+
+  Vec5D*** u = (Vec5D***) U.GetDataPointer(workOnGhost);
+  Vec5D*** v = (Vec5D***) V.GetDataPointer(workOnGhost);
+  double*** id = (double***) ID.GetDataPointer(workOnGhost);
 
   int myi0, myj0, myk0, myimax, myjmax, mykmax;
   if(workOnGhost)
@@ -563,13 +595,40 @@ void SpaceOperator::ConservativeToPrimitive(SpaceVariable3D &U, SpaceVariable3D
   else
     U.GetCornerIndices(&myi0, &myj0, &myk0, &myimax, &myjmax, &mykmax);
 
+#pragma omp parallel
+  {
+  int nrow = myimax - myi0;
+  vector<double> rho(nrow), e(nrow), p(nrow); //work arrays (per thread)
+
+#pragma omp for collapse(2)
   for(int k=myk0; k<mykmax; k++)
-    for(int j=myj0; j<myjmax; j++)
-      for(int i=myi0; i<myimax; i++)
-        varFcn[id[k][j][i]]->ConservativeToPrimitive((double*)u[k][j][i], (double*)v[k][j][i]); 
+    for(int j=myj0; j<myjmax; j++) {
+      Vec5D *urow = u[k][j], *vrow = v[k][j];
+      ForEachMaterialRun(id[k][j], myi0, myimax, [&](int myid, int ib, int ie) {
+        if(myid == INACTIVE_MATERIAL_ID) { //VarFcnDummy overrides the conversion
+          for(int i=ib; i<ie; i++)
+            varFcn[myid]->ConservativeToPrimitive((double*)urow[i], (double*)vrow[i]);
+          return;
+        }
+        for(int i=ib; i<ie; i++) {
+          double invRho = 1.0/urow[i][0];
+          vrow[i][0] = urow[i][0];
+          vrow[i][1] = urow[i][1]*invRho;
+          vrow[i][2] = urow[i][2]*invRho;
+          vrow[i][3] = urow[i][3]*invRho;
+          rho[i-myi0] = urow[i][0];
+          e[i-myi0]   = (urow[i][4] - 0.5*urow[i][0]*(vrow[i][1]*vrow[i][1] + vrow[i][2]*vrow[i][2]
+                                                      + vrow[i][3]*vrow[i][3]))*invRho;
+        }
+        varFcn[myid]->GetPressureBatch(ie-ib, &rho[ib-myi0], &e[ib-myi0], &p[ib-myi0]);
+        for(int i=ib; i<ie; i++)
+          vrow[i][4] = p[i-myi0];
+      });
+    }
+  } //end of omp parallel
 
   U.RestoreDataPointerToLocalVector(); //no changes made
-  V.RestoreDataPointerAndInsert();
+  V.RestoreDataPointerAndMarkGhostsStale(); //usually followed by clipping and b.c. (exchange only once)
   ID.RestoreDataPointerToLocalVector(); //no changes made
 }
 
@@ -578,9 +637,14 @@ void SpaceOperator::ConservativeToPrimitive(SpaceVariable3D &U, SpaceVariable3D
 void SpaceOperator::PrimitiveToConservative(SpaceVariable3D &V, SpaceVariable3D &ID, SpaceVariable3D &U, 
                                             bool workOnGhost)
 {
-  Vec5D*** v = (Vec5D***) V.GetDataPointer();
-  Vec5D*** u = (Vec5D***) U.GetDataPointer();
-  double*** id = (double***) ID.GetDataPointer();
+  if(iod.schemes.ns.layout == SchemeData::STRUCTURE_OF_ARRAYS) {
+    PrimitiveToConservativeSoA(V, ID, U, workOnGhost);
+    return;
+  }
+
+  Vec5D*** v = (Vec5D***) V.GetDataPointer(workOnGhost);
+  Vec5D*** u = (Vec5D***) U.GetDataPointer(workOnGhost);
+  double*** id = (double***) ID.GetDataPointer(workOnGhost);
 
   int myi0, myj0, myk0, myimax, myjmax, mykmax;
   if(workOnGhost)
@@ -588,24 +652,191 @@ void SpaceOperator::PrimitiveToConservative(SpaceVariable3D &V, SpaceVariable3D
   else
     U.GetCornerIndices(&myi0, &myj0, &myk0, &myimax, &myjmax, &mykmax);
 
+#pragma omp parallel
+  {
+  int nrow = myimax - myi0;
+  vector<double> rho(nrow), p(nrow), e(nrow); //work arrays (per thread)
+
+#pragma omp for collapse(2)
   for(int k=myk0; k<mykmax; k++)
-    for(int j=myj0; j<myjmax; j++)
-      for(int i=myi0; i<myimax; i++)
-        varFcn[id[k][j][i]]->PrimitiveToConservative((double*)v[k][j][i], (double*)u[k][j][i]); 
+    for(int j=myj0; j<myjmax; j++) {
+      Vec5D *vrow = v[k][j], *urow = u[k][j];
+      ForEachMaterialRun(id[k][j], myi0, myimax, [&](int myid, int ib, int ie) {
+        if(myid == INACTIVE_MATERIAL_ID) { //VarFcnDummy overrides the conversion
+          for(int i=ib; i<ie; i++)
+            varFcn[myid]->PrimitiveToConservative((double*)vrow[i], (double*)urow[i]);
+          return;
+        }
+        for(int i=ib; i<ie; i++) {
+          rho[i-myi0] = vrow[i][0];
+          p[i-myi0]   = vrow[i][4];
+        }
+        varFcn[myid]->GetInternalEnergyPerUnitMassBatch(ie-ib, &rho[ib-myi0], &p[ib-myi0], &e[ib-myi0]);
+        for(int i=ib; i<ie; i++) {
+          urow[i][0] = vrow[i][0];
+          urow[i][1] = vrow[i][0]*vrow[i][1];
+          urow[i][2] = vrow[i][0]*vrow[i][2];
+          urow[i][3] = vrow[i][0]*vrow[i][3];
+          urow[i][4] = vrow[i][0]*(e[i-myi0] + 0.5*(vrow[i][1]*vrow[i][1] + vrow[i][2]*vrow[i][2]
+                                                    + vrow[i][3]*vrow[i][3]));
+        }
+      });
+    }
+  } //end of omp parallel
 
   V.RestoreDataPointerToLocalVector(); //no changes made
-  U.RestoreDataPointerAndInsert();
+  U.RestoreDataPointerAndMarkGhostsStale(); //U's ghost layer is rarely needed
   ID.RestoreDataPointerToLocalVector(); //no changes made
 }
 
+//-----------------------------------------------------
+/** The EOS-independent part of the conversion is done in vectorized loops over contiguous component
+ *  arrays. The EOS (pressure or internal energy) is then evaluated in batches, one for each run of
+ *  consecutive nodes with the same material ID.
+ *  EXPERIMENTAL: The state is not kept in SoA across kernels, so each call pays for a full-field
+ *  Gather and Scatter. No net speedup has been measured; the default layout (ArrayOfStructures)
+ *  does not use this path. */
+void SpaceOperator::ConservativeToPrimitiveSoA(SpaceVariable3D &U, SpaceVariable3D &ID, SpaceVariable3D &V,
+                                               bool workOnGhost)
+{
+  Usoa.Setup(U);
+  Vsoa.Setup(V);
+  Usoa.Gather(U, workOnGhost);
+
+  double*** id = (double***) ID.GetDataPointer(workOnGhost);
+
+  int myi0, myj0, myk0, myimax, myjmax, mykmax;
+  if(workOnGhost)
+    U.GetGhostedCornerIndices(&myi0, &myj0, &myk0, &myimax, &myjmax, &mykmax);
+  else
+    U.GetCornerIndices(&myi0, &myj0, &myk0, &myimax, &myjmax, &mykmax);
+
+  const double* __restrict__ u0 = Usoa.Component(0);
+  const double* __restrict__ u1 = Usoa.Component(1);
+  const double* __restrict__ u2 = Usoa.Component(2);
+  const double* __restrict__ u3 = Usoa.Component(3);
+  const double* __restrict__ u4 = Usoa.Component(4);
+  double* __restrict__ v0 = Vsoa.Component(0);
+  double* __restrict__ v1 = Vsoa.Component(1);
+  double* __restrict__ v2 = Vsoa.Component(2);
+  double* __restrict__ v3 = Vsoa.Component(3);
+  double* __restrict__ v4 = Vsoa.Component(4);
+
+#pragma omp parallel
+  {
+  vector<double> e(myimax - myi0); //internal energy per unit mass (per thread)
+  double* __restrict__ er = e.data();
+
+#pragma omp for collapse(2)
+  for(int k=myk0; k<mykmax; k++)
+    for(int j=myj0; j<myjmax; j++) {
+
+      long long n0 = Usoa.Index(myi0,j,k), n1 = n0 + (myimax - myi0);
+
+      // Step 1: rho, velocity, and internal energy per unit mass
+      for(long long n=n0; n<n1; n++) {
+        double invRho = 1.0/u0[n];
+        v0[n] = u0[n];
+        v1[n] = u1[n]*invRho;
+        v2[n] = u2[n]*invRho;
+        v3[n] = u3[n]*invRho;
+        er[n-n0] = (u4[n] - 0.5*u0[n]*(v1[n]*v1[n] + v2[n]*v2[n] + v3[n]*v3[n]))*invRho;
+      }
+
+      // Step 2: pressure (batched by material ID)
+      ForEachMaterialRun(id[k][j], myi0, myimax, [&](int myid, int ib, int ie) {
+        long long nb = n0 + (ib - myi0);
+        if(myid == INACTIVE_MATERIAL_ID) { //VarFcnDummy overrides the conversion
+          for(long long n=nb; n<nb+(ie-ib); n++) {
+            double uu[5] = {u0[n], u1[n], u2[n], u3[n], u4[n]}, vv[5];
+            varFcn[myid]->ConservativeToPrimitive(uu, vv);
+            v0[n] = vv[0]; v1[n] = vv[1]; v2[n] = vv[2]; v3[n] = vv[3]; v4[n] = vv[4];
+          }
+        } else
+          varFcn[myid]->GetPressureBatch(ie-ib, &v0[nb], &er[ib-myi0], &v4[nb]);
+      });
+    }
+  } //end of omp parallel
+
+  ID.RestoreDataPointerToLocalVector(); //no changes made
+
+  Vsoa.Scatter(V, workOnGhost); //usually followed by clipping and b.c. (exchange only once)
+}
+
+//-----------------------------------------------------
+
+void SpaceOperator::PrimitiveToConservativeSoA(SpaceVariable3D &V, SpaceVariable3D &ID, SpaceVariable3D &U,
+                                               bool workOnGhost)
+{
+  Vsoa.Setup(V);
+  Usoa.Setup(U);
+  Vsoa.Gather(V, workOnGhost);
+
+  double*** id = (double***) ID.GetDataPointer(workOnGhost);
+
+  int myi0, myj0, myk0, myimax, myjmax, mykmax;
+  if(workOnGhost)
+    U.GetGhostedCornerIndices(&myi0, &myj0, &myk0, &myimax, &myjmax, &mykmax);
+  else
+    U.GetCornerIndices(&myi0, &myj0, &myk0, &myimax, &myjmax, &mykmax);
+
+  const double* __restrict__ v0 = Vsoa.Component(0);
+  const double* __restrict__ v1 = Vsoa.Component(1);
+  const double* __restrict__ v2 = Vsoa.Component(2);
+  const double* __restrict__ v3 = Vsoa.Component(3);
+  const double* __restrict__ v4 = Vsoa.Component(4);
+  double* __restrict__ u0 = Usoa.Component(0);
+  double* __restrict__ u1 = Usoa.Component(1);
+  double* __restrict__ u2 = Usoa.Component(2);
+  double* __restrict__ u3 = Usoa.Component(3);
+  double* __restrict__ u4 = Usoa.Component(4);
+
+#pragma omp parallel for collapse(2)
+  for(int k=myk0; k<mykmax; k++)
+    for(int j=myj0; j<myjmax; j++) {
+
+      long long n0 = Vsoa.Index(myi0,j,k), n1 = n0 + (myimax - myi0);
+
+      // Step 1: internal energy per unit mass (temporarily stored in u4), batched by material ID
+      ForEachMaterialRun(id[k][j], myi0, myimax, [&](int myid, int ib, int ie) {
+        if(myid != INACTIVE_MATERIAL_ID) //inactive nodes are handled in Step 3
+          varFcn[myid]->GetInternalEnergyPerUnitMassBatch(ie-ib, &v0[n0+(ib-myi0)], &v4[n0+(ib-myi0)],
+                                                          &u4[n0+(ib-myi0)]);
+      });
+
+      // Step 2: conservative variables
+      for(long long n=n0; n<n1; n++) {
+        u0[n] = v0[n];
+        u1[n] = v0[n]*v1[n];
+        u2[n] = v0[n]*v2[n];
+        u3[n] = v0[n]*v3[n];
+        u4[n] = v0[n]*(u4[n] + 0.5*(v1[n]*v1[n] + v2[n]*v2[n] + v3[n]*v3[n]));
+      }
+
+      // Step 3: inactive cells (VarFcnDummy overrides the conversion)
+      for(int i=myi0; i<myimax; i++) {
+        if((int)id[k][j][i] != INACTIVE_MATERIAL_ID)
+          continue;
+        long long n = n0 + (i - myi0);
+        double vv[5] = {v0[n], v1[n], v2[n], v3[n], v4[n]}, uu[5];
+        varFcn[INACTIVE_MATERIAL_ID]->PrimitiveToConservative(vv, uu);
+        u0[n] = uu[0]; u1[n] = uu[1]; u2[n] = uu[2]; u3[n] = uu[3]; u4[n] = uu[4];
+      }
+    }
+
+  ID.RestoreDataPointerToLocalVector(); //no changes made
+
+  Usoa.Scatter(U, workOnGhost); //U's ghost layer is rarely needed
+}
+
 //-----------------------------------------------------
 
 int SpaceOperator::ClipDensityAndPressure(SpaceVariable3D &V, SpaceVariable3D &ID, 
                                           bool workOnGhost, bool checkState)
 {
 
-  Vec5D*** v = (Vec5D***) V.GetDataPointer();
-  double*** id = (double***) ID.GetDataPointer();
+  Vec5D*** v = (Vec5D***) V.GetDataPointer(workOnGhost);
+  double*** id = (double***) ID.GetDataPointer(workOnGhost);
   Vec3D*** coords = (Vec3D***)coordinates.GetDataPointer();
 
   int myi0, myj0, myk0, myimax, myjmax, mykmax;
@@ -615,29 +846,50 @@ int SpaceOperator::ClipDensityAndPressure(SpaceVariable3D &V, SpaceVariable3D &I
     V.GetCornerIndices(&myi0, &myj0, &myk0, &myimax, &myjmax, &mykmax);
 
   int nClipped = 0;
+#pragma omp parallel
+  {
+  int nrow = myimax - myi0;
+  vector<double> rho(nrow), p(nrow); //work arrays (per thread)
+
+#pragma omp for collapse(2) reduction(+:nClipped)
   for(int k=myk0; k<mykmax; k++) {
     for(int j=myj0; j<myjmax; j++) {
-      for(int i=myi0; i<myimax; i++) {
 
-        nClipped += (int)varFcn[id[k][j][i]]->ClipDensityAndPressure(v[k][j][i]);
+      Vec5D *vrow = v[k][j];
+      for(int i=myi0; i<myimax; i++)
+        nClipped += (int)varFcn[id[k][j][i]]->ClipDensityAndPressure(vrow[i]);
+
+      if(!checkState)
+        continue;
 
-        if(checkState) {
-          if(varFcn[id[k][j][i]]->CheckState(v[k][j][i])) {
+      // The states are checked in batches, one for each run of nodes with the same material ID
+      ForEachMaterialRun(id[k][j], myi0, myimax, [&](int myid, int ib, int ie) {
+        bool failed = false;
+        for(int i=ib; i<ie; i++) {
+          rho[i-myi0] = vrow[i][0];
+          p[i-myi0]   = vrow[i][4];
+          failed = failed || !std::isfinite(vrow[i][1]) || !std::isfinite(vrow[i][2]) || !std::isfinite(vrow[i][3]);
+        }
+        if(!failed && varFcn[myid]->CheckStateBatch(ie-ib, &rho[ib-myi0], &p[ib-myi0], true) == 0)
+          return;
+        for(int i=ib; i<ie; i++) //find the first bad state
+          if(varFcn[myid]->CheckState(vrow[i])) {
             fprintf(stdout, "\033[0;31m*** Error: State variables at (%e,%e,%e) violate hyperbolicity." 
-                    " matid = %d.\n\033[0m", coords[k][j][i][0],coords[k][j][i][1],coords[k][j][i][2], (int)id[k][j][i]);
+                    " matid = %d.\n\033[0m", coords[k][j][i][0],coords[k][j][i][1],coords[k][j][i][2], myid);
             fprintf(stdout, "\033[0;31mv[%d(i),%d(j),%d(k)] = [%e, %e, %e, %e, %e]\n\033[0m", 
-                    i,j,k, v[k][j][i][0], v[k][j][i][1], v[k][j][i][2], v[k][j][i][3], v[k][j][i][4]);
+                    i,j,k, vrow[i][0], vrow[i][1], vrow[i][2], vrow[i][3], vrow[i][4]);
             exit(-1);
           }
-        }
-      }
+      });
     }
   }
+  } //end of omp parallel
 
   MPI_Allreduce(MPI_IN_PLACE, &nClipped, 1, MPI_INT, MPI_SUM, comm);
-  if(nClipped && verbose>0) {
-    print_warning(comm, "Warning: Clipped pressure and/or density in %d cells.\n", nClipped);
-    V.RestoreDataPointerAndInsert();
+  if(nClipped) {
+    if(verbose>0)
+      print_warning(comm, "Warning: Clipped pressure and/or density in %d cells.\n", nClipped);
+    V.RestoreDataPointerAndMarkGhostsStale();
   } else
     V.RestoreDataPointerToLocalVector();
 
@@ -773,7 +1025,7 @@ void SpaceOperator::ApplyBoundaryConditions(SpaceVariable3D &V)
 
   ApplyBoundaryConditionsGeometricEntities(v);
 
-  V.RestoreDataPointerAndInsert();
+  V.RestoreDataPointerToLocalVector(); //only the external ghost layer is modified (not communicated)
 }
 
 //-----------------------------------------------------
@@ -1168,47 +1420,71 @@ void SpaceOperator::FindExtremeValuesOfFlowVariables(SpaceVariable3D &V, SpaceVa
   cmax = Machmax = char_speed_max = -DBL_MAX;
   dx_over_char_speed_min = DBL_MAX;
 
-  // Loop through the real domain (excluding the ghost layer)
-  double c, mach, lam_f, lam_g, lam_h;
-  int myid;
+  bool xactive = global_mesh.x_glob.size()>1;
+  bool yactive = global_mesh.y_glob.size()>1;
+  bool zactive = global_mesh.z_glob.size()>1;
+
+  // Loop through the real domain (excluding the ghost layer). The EOS is evaluated in batches,
+  // one for each run of consecutive nodes (along i) with the same material ID.
+#pragma omp parallel
+  {
+  int nrow = imax - i0;
+  vector<double> rho(nrow), p(nrow), e(nrow), c2(nrow); //work arrays (per thread)
+
+#pragma omp for collapse(2) reduction(min:Vmin[:5], cmin, dx_over_char_speed_min) \
+                            reduction(max:Vmax[:5], cmax, Machmax, char_speed_max)
   for(int k=k0; k<kmax; k++) {
     for(int j=j0; j<jmax; j++) {
-      for(int i=i0; i<imax; i++) {
 
-        myid = id[k][j][i];
-
-        if(myid == INACTIVE_MATERIAL_ID)
-          continue;
+      Vec5D *vrow = v[k][j];
+      Vec3D *dxrow = dxyz[k][j];
 
-        for(int p=0; p<5; p++) {
-          Vmin[p] = min(Vmin[p], v[k][j][i][p]);
-          Vmax[p] = max(Vmax[p], v[k][j][i][p]);
-        } 
+      ForEachMaterialRun(id[k][j], i0, imax, [&](int myid, int ib, int ie) {
 
-        c = varFcn[myid]->ComputeSoundSpeedSquare(v[k][j][i][0]/*rho*/, 
-                            varFcn[myid]->GetInternalEnergyPerUnitMass(v[k][j][i][0],v[k][j][i][4])/*e*/);
+        if(myid == INACTIVE_MATERIAL_ID)
+          return;
 
-        if(c<0) {
-          fprintf(stdout,"*** Error: c^2 (square of sound speed) = %e in SpaceOperator. V = %e, %e, %e, %e, %e, ID = %d.\n",
-                  c, v[k][j][i][0], v[k][j][i][1], v[k][j][i][2], v[k][j][i][3], v[k][j][i][4], myid);
-          exit_mpi();
-        } else
-          c = sqrt(c);
+        for(int i=ib; i<ie; i++) {
+          rho[i-i0] = vrow[i][0];
+          p[i-i0]   = vrow[i][4];
+        }
+        varFcn[myid]->GetInternalEnergyPerUnitMassBatch(ie-ib, &rho[ib-i0], &p[ib-i0], &e[ib-i0]);
+        varFcn[myid]->ComputeSoundSpeedSquareBatch(ie-ib, &rho[ib-i0], &e[ib-i0], &c2[ib-i0]);
 
-        cmin = min(cmin, c);
-        cmax = max(cmax, c);
-        mach = varFcn[myid]->ComputeMachNumber(v[k][j][i]); 
-        Machmax = max(Machmax, mach); 
+        for(int i=ib; i<ie; i++) {
 
-        fluxFcn.EvaluateMaxEigenvalues(v[k][j][i], myid, lam_f, lam_g, lam_h);
-        char_speed_max = max(max(max(char_speed_max, lam_f), lam_g), lam_h);
+          for(int q=0; q<5; q++) {
+            Vmin[q] = min(Vmin[q], vrow[i][q]);
+            Vmax[q] = max(Vmax[q], vrow[i][q]);
+          } 
 
-        if(global_mesh.x_glob.size()>1)  dx_over_char_speed_min = min(dx_over_char_speed_min, dxyz[k][j][i][0]/lam_f);
-        if(global_mesh.y_glob.size()>1)  dx_over_char_speed_min = min(dx_over_char_speed_min, dxyz[k][j][i][1]/lam_g);
-        if(global_mesh.z_glob.size()>1)  dx_over_char_speed_min = min(dx_over_char_speed_min, dxyz[k][j][i][2]/lam_h);
-      }
+          double c = c2[i-i0];
+          if(c<0) {
+            fprintf(stdout,"*** Error: c^2 (square of sound speed) = %e in SpaceOperator. V = %e, %e, %e, %e, %e, ID = %d.\n",
+                    c, vrow[i][0], vrow[i][1], vrow[i][2], vrow[i][3], vrow[i][4], myid);
+            exit_mpi();
+          } else
+            c = sqrt(c);
+
+          cmin = min(cmin, c);
+          cmax = max(cmax, c);
+          double mach = sqrt(vrow[i][1]*vrow[i][1] + vrow[i][2]*vrow[i][2] + vrow[i][3]*vrow[i][3])/c;
+          Machmax = max(Machmax, mach); 
+
+          // max eigenvalues (same as FluxFcnBase::EvaluateMaxEigenvalues)
+          double lam_f = fabs(vrow[i][1]) + c;
+          double lam_g = fabs(vrow[i][2]) + c;
+          double lam_h = fabs(vrow[i][3]) + c;
+          char_speed_max = max(max(max(char_speed_max, lam_f), lam_g), lam_h);
+
+          if(xactive)  dx_over_char_speed_min = min(dx_over_char_speed_min, dxrow[i][0]/lam_f);
+          if(yactive)  dx_over_char_speed_min = min(dx_over_char_speed_min, dxrow[i][1]/lam_g);
+          if(zactive)  dx_over_char_speed_min = min(dx_over_char_speed_min, dxrow[i][2]/lam_h);
+        }
+      });
     }
   }
+  } //end of omp parallel
 
   MPI_Allreduce(MPI_IN_PLACE, Vmin, 5, MPI_DOUBLE, MPI_MIN, comm);
   MPI_Allreduce(MPI_IN_PLACE, Vmax, 5, MPI_DOUBLE, MPI_MAX, comm);
@@ -1370,31 +1646,42 @@ void SpaceOperator::ComputeAdvectionFluxes(SpaceVariable3D &V, SpaceVariable3D &
   //------------------------------------
   if(riemann_solutions)
     riemann_solutions->Clear();
+  for(auto&& problems : interface_riemann_problems)
+    problems.clear(); //keeps the memory
 
   //------------------------------------
   // Reconstruction w/ slope limiters.
+  // The exchange of reconstructed states is NOT completed here. It is overlapped with the computation
+  // of fluxes across interfaces within the subdomain interior (see below).
   //------------------------------------
-  if(TagNodesOutsideConRecDepth(Phi, EBDS, Tag))
-    rec.Reconstruct(V, Vl, Vr, Vb, Vt, Vk, Vf, &ID, EBDS, &Tag, false); //false: apply const rec within depth
+  SpaceVariable3D *tag = TagNodesOutsideConRecDepth(Phi, EBDS, Tag) ? &Tag : NULL;
+  if(tag)
+    rec.Reconstruct(V, Vl, Vr, Vb, Vt, Vk, Vf, &ID, EBDS, tag, false, false); //false: apply const rec within depth
   else
-    rec.Reconstruct(V, Vl, Vr, Vb, Vt, Vk, Vf, &ID, EBDS, NULL); 
+    rec.Reconstruct(V, Vl, Vr, Vb, Vt, Vk, Vf, &ID, EBDS, NULL, true, false); 
 
   //------------------------------------
-  // Check reconstructed states (clip & check)
+  // Check reconstructed states (clip & check) in the subdomain interior, then start the exchanges
   //------------------------------------
-  CheckReconstructedStates(V, Vl, Vr, Vb, Vt, Vk, Vf, ID); //already checked in Reconstructor::Reconstruct
-                                                           //but here we also do clipping
+  CheckReconstructedStates(V, Vl, Vr, Vb, Vt, Vk, Vf, ID, 1); //already checked in Reconstructor::Reconstruct
+                                                              //but here we also do clipping
+  Vl.BeginGhostUpdate();
+  Vr.BeginGhostUpdate();
+  Vb.BeginGhostUpdate();
+  Vt.BeginGhostUpdate();
+  Vk.BeginGhostUpdate();
+  Vf.BeginGhostUpdate();
 
   //------------------------------------
   // Extract data
   //------------------------------------
   Vec5D*** v  = (Vec5D***) V.GetDataPointer();
-  Vec5D*** vl = (Vec5D***) Vl.GetDataPointer();
-  Vec5D*** vr = (Vec5D***) Vr.GetDataPointer();
-  Vec5D*** vb = (Vec5D***) Vb.GetDataPointer();
-  Vec5D*** vt = (Vec5D***) Vt.GetDataPointer();
-  Vec5D*** vk = (Vec5D***) Vk.GetDataPointer();
-  Vec5D*** vf = (Vec5D***) Vf.GetDataPointer();
+  Vec5D*** vl = (Vec5D***) Vl.GetDataPointer(false); //exchange in progress. Do not access ghost layer
+  Vec5D*** vr = (Vec5D***) Vr.GetDataPointer(false);
+  Vec5D*** vb = (Vec5D***) Vb.GetDataPointer(false);
+  Vec5D*** vt = (Vec5D***) Vt.GetDataPointer(false);
+  Vec5D*** vk = (Vec5D***) Vk.GetDataPointer(false);
+  Vec5D*** vf = (Vec5D***) Vf.GetDataPointer(false);
   Vec5D*** f  = (Vec5D***) F.GetDataPointer();
 
   double*** id = (double***) ID.GetDataPointer();
@@ -1443,6 +1730,7 @@ void SpaceOperator::ComputeAdvectionFluxes(SpaceVariable3D &V, SpaceVariable3D &
   Vec5D localflux1, localflux2;
 
   // Initialize F to 0
+#pragma omp parallel for collapse(2)
   for(int k=kk0; k<kkmax; k++)
     for(int j=jj0; j<jjmax; j++) 
       for(int i=ii0; i<iimax; i++) {
@@ -1456,7 +1744,6 @@ void SpaceOperator::ComputeAdvectionFluxes(SpaceVariable3D &V, SpaceVariable3D &
   double Vmid[5];
   double Vsm[5], Vsp[5];
   double area = 0.0;
-  Int3 ind;
 
   // Count the riemann solver errors. Note that when this occurs, it could be that
   // (1) the Riemann problem does NOT have a solution, and 
@@ -1467,12 +1754,55 @@ void SpaceOperator::ComputeAdvectionFluxes(SpaceVariable3D &V, SpaceVariable3D &
   bool use_LLF_at_interface = (iod.multiphase.flux == MultiPhaseData::LOCAL_LAX_FRIEDRICHS);
   
   // Loop through the domain interior, and the right, top, and front ghost layers. For each cell, calculate the
-  // numerical flux across the left, lower, and back cell boundaries/interfaces
+  // numerical flux across the left, lower, and back cell boundaries/interfaces.
+  // This is done in two passes. Pass 0 handles cells whose left, lower, and back neighbors are all
+  // in the subdomain interior, so it does not need the ghost layer of Vl, Vr, etc. Pass 1 handles
+  // the remaining cells (a shell of width 1 on each side), after the exchanges are completed.
   Vec3D vwallf(0.0), vwallb(0.0), nwallf(0.0), nwallb(0.0);
-  for(int k=k0; k<kkmax; k++) {
-    for(int j=j0; j<jjmax; j++) {
+  for(int pass=0; pass<2; pass++) {
+
+    if(pass==1) {
+      // complete the exchanges, populate the external ghost layer, and check the states there
+      V.RestoreDataPointerToLocalVector();
+      Vl.RestoreDataPointerToLocalVector();
+      Vr.RestoreDataPointerToLocalVector();
+      Vb.RestoreDataPointerToLocalVector();
+      Vt.RestoreDataPointerToLocalVector();
+      Vk.RestoreDataPointerToLocalVector();
+      Vf.RestoreDataPointerToLocalVector();
+      ID.RestoreDataPointerToLocalVector();
+
+      rec.CompleteReconstruction(V, Vl, Vr, Vb, Vt, Vk, Vf, tag, !tag); //same as in Reconstruct
+      CheckReconstructedStates(V, Vl, Vr, Vb, Vt, Vk, Vf, ID, 2);
+
+      v  = (Vec5D***) V.GetDataPointer();
+      vl = (Vec5D***) Vl.GetDataPointer();
+      vr = (Vec5D***) Vr.GetDataPointer();
+      vb = (Vec5D***) Vb.GetDataPointer();
+      vt = (Vec5D***) Vt.GetDataPointer();
+      vk = (Vec5D***) Vk.GetDataPointer();
+      vf = (Vec5D***) Vf.GetDataPointer();
+      id = (double***) ID.GetDataPointer();
+    }
+
+  // Multi-threading: The flux across a face is added to the two adjacent cells. To avoid data races,
+  // the rows (k,j) are split into four groups by the parities of k and j. Rows in the same group never
+  // update the same cell, so each group is processed in parallel. The exact Riemann solver stores
+  // intermediate results in member variables, so calls to it are serialized (critical sections).
+  // Bimaterial Riemann problems are only collected here (per thread), and solved after the loops
+  // (ComputeInterfaceRiemannFluxes), so that the loops over single-material faces are not interrupted.
+  for(int color=0; color<4; color++) {
+
+#pragma omp parallel for collapse(2) schedule(dynamic) reduction(+:riemann_errors) \
+                         private(myid, neighborid, midid, Vmid, Vsm, Vsp, area, err, \
+                                 localflux1, localflux2, vwallf, vwallb, nwallf, nwallb)
+  for(int k=k0+color/2; k<kkmax; k+=2) {
+    for(int j=j0+color%2; j<jjmax; j+=2) {
       for(int i=i0; i<iimax; i++) {
 
+        if((pass==0) != (i>i0 && i<imax && j>j0 && j<jmax && k>k0 && k<kmax))
+          continue;
+
         myid = id[k][j][i];
 
         //*****************************************
@@ -1492,6 +1822,7 @@ void SpaceOperator::ComputeAdvectionFluxes(SpaceVariable3D &V, SpaceVariable3D &
               Vec3D dir = GetNormalForOneSidedRiemann(0, 1, nwallf);
               if(iod.ebm.recon == EmbeddedBoundaryMethodData::CONSTANT) {
                 //switch back to constant reconstruction (i.e. v)
+#pragma omp critical (m2c_exact_riemann_solver)
                 err = riemann.ComputeOneSidedRiemannSolution(dir, v[k][j][i-1], neighborid, vwallf, 
                                                              Vmid, midid, Vsm);
                 if(err)
@@ -1502,6 +1833,7 @@ void SpaceOperator::ComputeAdvectionFluxes(SpaceVariable3D &V, SpaceVariable3D &
                                                             localflux1);
               } 
               else {//linear reconstruction w/ limiter
+#pragma omp critical (m2c_exact_riemann_solver)
                 err = riemann.ComputeOneSidedRiemannSolution(dir, vr[k][j][i-1], neighborid, vwallf,
                                                              Vmid, midid, Vsm);
                 if(err) 
@@ -1519,6 +1851,7 @@ void SpaceOperator::ComputeAdvectionFluxes(SpaceVariable3D &V, SpaceVariable3D &
               Vec3D dir = GetNormalForOneSidedRiemann(0,-1, nwallb);
               if(iod.ebm.recon == EmbeddedBoundaryMethodData::CONSTANT) {
                 //switch back to constant reconstruction (i.e. v)
+#pragma omp critical (m2c_exact_riemann_solver)
                 err = riemann.ComputeOneSidedRiemannSolution(dir, v[k][j][i], myid, vwallb, Vmid, midid, Vsp);
                 if(err)
                   riemann_errors++;
@@ -1528,6 +1861,7 @@ void SpaceOperator::ComputeAdvectionFluxes(SpaceVariable3D &V, SpaceVariable3D &
                                                             localflux2);
               } 
               else {//linear reconstruction w/ limiter
+#pragma omp critical (m2c_exact_riemann_solver)
                 err = riemann.ComputeOneSidedRiemannSolution(dir, vl[k][j][i], myid, vwallb, Vmid, midid, Vsp);
                 if(err) 
                   riemann_errors++;
@@ -1559,60 +1893,18 @@ void SpaceOperator::ComputeAdvectionFluxes(SpaceVariable3D &V, SpaceVariable3D &
                 // determine the axis/direction of the 1D Riemann problem
                 Vec3D dir = GetNormalForBimaterialRiemann(0/*i-1/2*/,i,j,k,coords,dxyz,myid,neighborid,
                                                           ls_mat_id,&phi);
-                if(iod.exact_riemann.surface_tension == ExactRiemannSolverData::NO) {//no surface tension
-                  //Solve 1D Riemann problem
-                  if(iod.multiphase.recon == MultiPhaseData::CONSTANT)
-                    //switch back to constant reconstruction (i.e. v)
-                    err = riemann.ComputeRiemannSolution(dir, v[k][j][i-1], neighborid, v[k][j][i], myid,
-                                                         Vmid, midid, Vsm, Vsp);
-                  else//linear reconstruction w/ limitor
-                    err = riemann.ComputeRiemannSolution(dir, vr[k][j][i-1], neighborid, vl[k][j][i], myid,
-                                                         Vmid, midid, Vsm, Vsp);
-                }
-                else {//with surface tension
-		  double curvature = CalculateCurvatureAtCellInterface(0, phi[0], kappaPhi[0], i, j, k);
-                  //Solve 1D Riemann problem
-                  if(iod.multiphase.recon == MultiPhaseData::CONSTANT)
-                    //switch back to constant reconstruction (i.e. v)
-                    err = riemann.ComputeRiemannSolution(dir, v[k][j][i-1], neighborid, v[k][j][i], myid,
-                                                         Vmid, midid, Vsm, Vsp, curvature);
-                  else//linear reconstruction w/ limitor
-                    err = riemann.ComputeRiemannSolution(dir, vr[k][j][i-1], neighborid, vl[k][j][i], myid,
-                                                         Vmid, midid, Vsm, Vsp, curvature);
-                }
-                if(err)
-                  riemann_errors++;
-
-                //Clip Riemann solution and check it
-                varFcn[neighborid]->ClipDensityAndPressure(Vsm);
-                varFcn[neighborid]->CheckState(Vsm);
-                varFcn[myid]->ClipDensityAndPressure(Vsp);
-                varFcn[myid]->CheckState(Vsp);
-
-                if(riemann_solutions && !err) {//store Riemann solution for "phase-change update" 
-                  ind[0] = k; ind[1] = j; ind[2] = i;
-                  riemann_solutions->left[ind] = std::make_pair((Vec5D)Vsm, neighborid); 
-                  ind[2] = i-1;
-                  riemann_solutions->right[ind] = std::make_pair((Vec5D)Vsp, myid); 
-                }
-
-                if(iod.multiphase.flux == MultiPhaseData::EXACT) { //Godunov-type flux
-                  fluxFcn.EvaluateFluxFunction_F(Vmid, midid, localflux1);
-                  localflux2 = localflux1;
-                } else {//Numerical flux function
-                  if(iod.multiphase.recon == MultiPhaseData::CONSTANT) {
-                    //switch back to constant reconstruction (i.e. v)
-                    fluxFcn.ComputeNumericalFluxAtCellInterface(0/*F*/, v[k][j][i-1]/*Vm*/, Vsm/*Vp*/, 
-                                                                neighborid, localflux1);
-                    fluxFcn.ComputeNumericalFluxAtCellInterface(0/*F*/, Vsp/*Vm*/, v[k][j][i]/*Vp*/,
-                                                                myid, localflux2);
-                  } else {//linear reconstruction w/ limiter
-                    fluxFcn.ComputeNumericalFluxAtCellInterface(0/*F*/, vr[k][j][i-1]/*Vm*/, Vsm/*Vp*/,
-                                                                neighborid, localflux1);
-                    fluxFcn.ComputeNumericalFluxAtCellInterface(0/*F*/, Vsp/*Vm*/, vl[k][j][i]/*Vp*/,
-                                                                myid, localflux2);
-                  }
-                }
+                double curvature = iod.exact_riemann.surface_tension == ExactRiemannSolverData::NO ? 0.0
+                                 : CalculateCurvatureAtCellInterface(0, phi[0], kappaPhi[0], i, j, k);
+                //Solved later, together with the other interface Riemann problems (see below)
+                if(iod.multiphase.recon == MultiPhaseData::CONSTANT)
+                  //switch back to constant reconstruction (i.e. v)
+                  AddInterfaceRiemannProblem(0, k, j, i, dir, v[k][j][i-1], neighborid, v[k][j][i], myid,
+                                             curvature, dxyz[k][j][i][1]*dxyz[k][j][i][2]);
+                else //linear reconstruction w/ limiter
+                  AddInterfaceRiemannProblem(0, k, j, i, dir, vr[k][j][i-1], neighborid, vl[k][j][i], myid,
+                                             curvature, dxyz[k][j][i][1]*dxyz[k][j][i][2]);
+                localflux1 = 0.0;
+                localflux2 = 0.0;
               }
             } else { // This should only occur when embedded surface has an issue (skip)
               localflux1 = 0.0;
@@ -1653,6 +1945,7 @@ void SpaceOperator::ComputeAdvectionFluxes(SpaceVariable3D &V, SpaceVariable3D &
               Vec3D dir = GetNormalForOneSidedRiemann(1, 1, nwallf);
               if(iod.ebm.recon == EmbeddedBoundaryMethodData::CONSTANT) {
                 //switch back to constant reconstruction (i.e. v)
+#pragma omp critical (m2c_exact_riemann_solver)
                 err = riemann.ComputeOneSidedRiemannSolution(dir, v[k][j-1][i], neighborid, vwallf, Vmid,
                                                              midid, Vsm);
                 if(err)
@@ -1663,6 +1956,7 @@ void SpaceOperator::ComputeAdvectionFluxes(SpaceVariable3D &V, SpaceVariable3D &
                                                             localflux1);
               }
               else {//linear reconstruction w/ limiter
+#pragma omp critical (m2c_exact_riemann_solver)
                 err = riemann.ComputeOneSidedRiemannSolution(dir, vt[k][j-1][i], neighborid, vwallf, Vmid,
                                                              midid, Vsm);
                 if(err)
@@ -1679,6 +1973,7 @@ void SpaceOperator::ComputeAdvectionFluxes(SpaceVariable3D &V, SpaceVariable3D &
               Vec3D dir = GetNormalForOneSidedRiemann(1,-1, nwallb);
               if(iod.ebm.recon == EmbeddedBoundaryMethodData::CONSTANT) {
                 //switch back to constant reconstruction (i.e. v)
+#pragma omp critical (m2c_exact_riemann_solver)
                 err = riemann.ComputeOneSidedRiemannSolution(dir, v[k][j][i], myid, vwallb, Vmid, midid, Vsp);
                 if(err)
                   riemann_errors++;
@@ -1688,6 +1983,7 @@ void SpaceOperator::ComputeAdvectionFluxes(SpaceVariable3D &V, SpaceVariable3D &
                                                             localflux2);
               }
               else {//linear reconstruction w/ limiter
+#pragma omp critical (m2c_exact_riemann_solver)
                 err = riemann.ComputeOneSidedRiemannSolution(dir, vb[k][j][i], myid, vwallb, Vmid, midid, Vsp);
                 if(err)
                   riemann_errors++;
@@ -1718,61 +2014,18 @@ void SpaceOperator::ComputeAdvectionFluxes(SpaceVariable3D &V, SpaceVariable3D &
                 // determine the axis/direction of the 1D Riemann problem
                 Vec3D dir = GetNormalForBimaterialRiemann(1/*j-1/2*/,i,j,k,coords,dxyz,myid,neighborid,
                                                           ls_mat_id,&phi);
-                if(iod.exact_riemann.surface_tension == ExactRiemannSolverData::NO) {//no surface tension
-                  //Solve 1D Riemann problem
-                  if(iod.multiphase.recon == MultiPhaseData::CONSTANT)
-                    //switch back to constant reconstruction (i.e. v)
-                    err = riemann.ComputeRiemannSolution(dir, v[k][j-1][i], neighborid, v[k][j][i], myid,
-                                                         Vmid, midid, Vsm, Vsp);
-                  else
-                    err = riemann.ComputeRiemannSolution(dir, vt[k][j-1][i], neighborid, vb[k][j][i], myid,
-                                                         Vmid, midid, Vsm, Vsp);
-                }
-                else { 
-		  double curvature = CalculateCurvatureAtCellInterface(1, phi[0], kappaPhi[0], i, j, k);
-                  //Solve 1D Riemann problem
-                  if(iod.multiphase.recon == MultiPhaseData::CONSTANT)
-                    //switch back to constant reconstruction (i.e. v)
-                    err = riemann.ComputeRiemannSolution(dir, v[k][j-1][i], neighborid, v[k][j][i], myid,
-                                                         Vmid, midid, Vsm, Vsp, curvature);
-                  else
-                    err = riemann.ComputeRiemannSolution(dir, vt[k][j-1][i], neighborid, vb[k][j][i], myid,
-                                                         Vmid, midid, Vsm, Vsp, curvature);
-                }
-
-                if(err)
-                  riemann_errors++;
-
-                //Clip Riemann solution and check it
-                varFcn[neighborid]->ClipDensityAndPressure(Vsm);
-                varFcn[neighborid]->CheckState(Vsm);
-                varFcn[myid]->ClipDensityAndPressure(Vsp);
-                varFcn[myid]->CheckState(Vsp);
-
-                if(riemann_solutions && !err) {//store Riemann solution for "phase-change update"
-                  ind[0] = k; ind[1] = j; ind[2] = i;
-                  riemann_solutions->bottom[ind] = std::make_pair((Vec5D)Vsm, neighborid); 
-                  ind[1] = j-1;
-                  riemann_solutions->top[ind] = std::make_pair((Vec5D)Vsp, myid); 
-                }
-
-                if(iod.multiphase.flux == MultiPhaseData::EXACT) { //Godunov-type flux
-                  fluxFcn.EvaluateFluxFunction_G(Vmid, midid, localflux1);
-                  localflux2 = localflux1;
-                } else {//Numerical flux function
-                  if(iod.multiphase.recon == MultiPhaseData::CONSTANT) {
-                    //switch back to constant reconstruction (i.e. v)
-                    fluxFcn.ComputeNumericalFluxAtCellInterface(1/*G*/, v[k][j-1][i]/*Vm*/, Vsm/*Vp*/, 
-                                                                neighborid, localflux1);
-                    fluxFcn.ComputeNumericalFluxAtCellInterface(1/*G*/, Vsp/*Vm*/, v[k][j][i]/*Vp*/,
-                                                                myid, localflux2);
-                  } else {
-                    fluxFcn.ComputeNumericalFluxAtCellInterface(1/*G*/, vt[k][j-1][i]/*Vm*/, Vsm/*Vp*/,
-                                                                neighborid, localflux1);
-                    fluxFcn.ComputeNumericalFluxAtCellInterface(1/*G*/, Vsp/*Vm*/, vb[k][j][i]/*Vp*/,
-                                                                myid, localflux2);
-                  }
-                }
+                double curvature = iod.exact_riemann.surface_tension == ExactRiemannSolverData::NO ? 0.0
+                                 : CalculateCurvatureAtCellInterface(1, phi[0], kappaPhi[0], i, j, k);
+                //Solved later, together with the other interface Riemann problems (see below)
+                if(iod.multiphase.recon == MultiPhaseData::CONSTANT)
+                  //switch back to constant reconstruction (i.e. v)
+                  AddInterfaceRiemannProblem(1, k, j, i, dir, v[k][j-1][i], neighborid, v[k][j][i], myid,
+                                             curvature, dxyz[k][j][i][0]*dxyz[k][j][i][2]);
+                else //linear reconstruction w/ limiter
+                  AddInterfaceRiemannProblem(1, k, j, i, dir, vt[k][j-1][i], neighborid, vb[k][j][i], myid,
+                                             curvature, dxyz[k][j][i][0]*dxyz[k][j][i][2]);
+                localflux1 = 0.0;
+                localflux2 = 0.0;
               }
             } else { // This should only occur when embedded surface has an issue (skip)
               localflux1 = 0.0;
@@ -1812,6 +2065,7 @@ void SpaceOperator::ComputeAdvectionFluxes(SpaceVariable3D &V, SpaceVariable3D &
               Vec3D dir = GetNormalForOneSidedRiemann(2, 1, nwallf);
               if(iod.ebm.recon == EmbeddedBoundaryMethodData::CONSTANT) {
                 //switch back to constant reconstruction (i.e. v)
+#pragma omp critical (m2c_exact_riemann_solver)
                 err = riemann.ComputeOneSidedRiemannSolution(dir, v[k-1][j][i], neighborid, vwallf, Vmid,
                                                              midid, Vsm);
                 if(err)
@@ -1822,6 +2076,7 @@ void SpaceOperator::ComputeAdvectionFluxes(SpaceVariable3D &V, SpaceVariable3D &
                                                             localflux1);
               }
               else {//linear reconstruction w/ limiter
+#pragma omp critical (m2c_exact_riemann_solver)
                 err = riemann.ComputeOneSidedRiemannSolution(dir, vf[k-1][j][i], neighborid, vwallf, Vmid,
                                                              midid, Vsm);
                 if(err)
@@ -1838,6 +2093,7 @@ void SpaceOperator::ComputeAdvectionFluxes(SpaceVariable3D &V, SpaceVariable3D &
               Vec3D dir = GetNormalForOneSidedRiemann(2,-1, nwallb);
               if(iod.ebm.recon == EmbeddedBoundaryMethodData::CONSTANT) {
                 //switch back to constant reconstruction (i.e. v)
+#pragma omp critical (m2c_exact_riemann_solver)
                 err = riemann.ComputeOneSidedRiemannSolution(dir, v[k][j][i], myid, vwallb, Vmid, midid, Vsp);
                 if(err)
                   riemann_errors++;
@@ -1847,6 +2103,7 @@ void SpaceOperator::ComputeAdvectionFluxes(SpaceVariable3D &V, SpaceVariable3D &
                                                             localflux2);
               }
               else {//linear reconstruction w/ limiter
+#pragma omp critical (m2c_exact_riemann_solver)
                 err = riemann.ComputeOneSidedRiemannSolution(dir, vk[k][j][i], myid, vwallb, Vmid, midid, Vsp);
                 if(err)
                   riemann_errors++;
@@ -1877,61 +2134,18 @@ void SpaceOperator::ComputeAdvectionFluxes(SpaceVariable3D &V, SpaceVariable3D &
                 // determine the axis/direction of the 1D Riemann problem
                 Vec3D dir = GetNormalForBimaterialRiemann(2/*k-1/2*/,i,j,k,coords,dxyz,myid,neighborid,
                                                           ls_mat_id,&phi);
-                if(iod.exact_riemann.surface_tension == ExactRiemannSolverData::NO) {//no surface tension
-                  //Solve 1D Riemann problem
-                  if(iod.multiphase.recon == MultiPhaseData::CONSTANT)
-                    //switch back to constant reconstruction (i.e. v)
-                    err = riemann.ComputeRiemannSolution(dir, v[k-1][j][i], neighborid, v[k][j][i], myid,
-                                                         Vmid, midid, Vsm, Vsp);
-                  else
-                    err = riemann.ComputeRiemannSolution(dir, vf[k-1][j][i], neighborid, vk[k][j][i], myid,
-                                                         Vmid, midid, Vsm, Vsp);
-                }
-                else {
-		  double curvature = CalculateCurvatureAtCellInterface(2, phi[0], kappaPhi[0], i, j, k);
-                  //Solve 1D Riemann problem
-                  if(iod.multiphase.recon == MultiPhaseData::CONSTANT)
-                    //switch back to constant reconstruction (i.e. v)
-                    err = riemann.ComputeRiemannSolution(dir, v[k-1][j][i], neighborid, v[k][j][i], myid,
-                                                         Vmid, midid, Vsm, Vsp, curvature);
-                  else
-                    err = riemann.ComputeRiemannSolution(dir, vf[k-1][j][i], neighborid, vk[k][j][i], myid,
-                                                         Vmid, midid, Vsm, Vsp, curvature);
-                }
-
-                if(err)
-                  riemann_errors++;
-
-                //Clip Riemann solution and check it
-                varFcn[neighborid]->ClipDensityAndPressure(Vsm);
-                varFcn[neighborid]->CheckState(Vsm);
-                varFcn[myid]->ClipDensityAndPressure(Vsp);
-                varFcn[myid]->CheckState(Vsp);
-
-                if(riemann_solutions && !err) {//store Riemann solution for "phase-change update"
-                  ind[0] = k; ind[1] = j; ind[2] = i;
-                  riemann_solutions->back[ind] = std::make_pair((Vec5D)Vsm, neighborid); 
-                  ind[0] = k-1;
-                  riemann_solutions->front[ind] = std::make_pair((Vec5D)Vsp, myid); 
-                }
-
-                if(iod.multiphase.flux == MultiPhaseData::EXACT) { //Godunov-type flux
-                  fluxFcn.EvaluateFluxFunction_H(Vmid, midid, localflux1);
-                  localflux2 = localflux1;
-                } else {//Numerical flux function
-                  if(iod.multiphase.recon == MultiPhaseData::CONSTANT) {
-                    //switch back to constant reconstruction (i.e. v)
-                    fluxFcn.ComputeNumericalFluxAtCellInterface(2/*H*/, v[k-1][j][i]/*Vm*/, Vsm/*Vp*/,
-                                                                neighborid, localflux1);
-                    fluxFcn.ComputeNumericalFluxAtCellInterface(2/*H*/, Vsp/*Vm*/, v[k][j][i]/*Vp*/,
-                                                                myid, localflux2);
-                  } else {
-                    fluxFcn.ComputeNumericalFluxAtCellInterface(2/*H*/, vf[k-1][j][i]/*Vm*/, Vsm/*Vp*/,
-                                                                neighborid, localflux1);
-                    fluxFcn.ComputeNumericalFluxAtCellInterface(2/*H*/, Vsp/*Vm*/, vk[k][j][i]/*Vp*/,
-                                                                myid, localflux2);
-                  }
-                }
+                double curvature = iod.exact_riemann.surface_tension == ExactRiemannSolverData::NO ? 0.0
+                                 : CalculateCurvatureAtCellInterface(2, phi[0], kappaPhi[0], i, j, k);
+                //Solved later, together with the other interface Riemann problems (see below)
+                if(iod.multiphase.recon == MultiPhaseData::CONSTANT)
+                  //switch back to constant reconstruction (i.e. v)
+                  AddInterfaceRiemannProblem(2, k, j, i, dir, v[k-1][j][i], neighborid, v[k][j][i], myid,
+                                             curvature, dxyz[k][j][i][0]*dxyz[k][j][i][1]);
+                else //linear reconstruction w/ limiter
+                  AddInterfaceRiemannProblem(2, k, j, i, dir, vf[k-1][j][i], neighborid, vk[k][j][i], myid,
+                                             curvature, dxyz[k][j][i][0]*dxyz[k][j][i][1]);
+                localflux1 = 0.0;
+                localflux2 = 0.0;
               }
             } else { // This should only occur when embedded surface has an issue (skip)
               localflux1 = 0.0;
@@ -1957,8 +2171,19 @@ void SpaceOperator::ComputeAdvectionFluxes(SpaceVariable3D &V, SpaceVariable3D &
       }
     }
   }
+
+  } //end of color
+
+  } //end of pass
+
+  //------------------------------------
+  // Fluxes across material interfaces (bimaterial Riemann problems), collected in the loops above
+  //------------------------------------
+  riemann_errors += ComputeInterfaceRiemannFluxes(f, riemann_solutions);
         
   
+  if(riemann_errors>0)
+    m2c_timer.AddCount("RiemannSolverFailures", riemann_errors);
   MPI_Allreduce(MPI_IN_PLACE, &riemann_errors, 1, MPI_INT, MPI_SUM, comm);
   if(riemann_errors>0) 
     print_warning(comm, "Warning: Riemann solver failed to find a bracketing interval or to "
@@ -2351,16 +2576,18 @@ void
 SpaceOperator::CheckReconstructedStates(SpaceVariable3D &V,
                                         SpaceVariable3D &Vl, SpaceVariable3D &Vr, SpaceVariable3D &Vb,
                                         SpaceVariable3D &Vt, SpaceVariable3D &Vk, SpaceVariable3D &Vf,
-                                        SpaceVariable3D &ID)
+                                        SpaceVariable3D &ID, int region)
 {
 
+  bool sync = (region != 1); //the subdomain interior does not need the internal ghost layer
+
   Vec5D*** v  = (Vec5D***) V.GetDataPointer();
-  Vec5D*** vl = (Vec5D***) Vl.GetDataPointer();
-  Vec5D*** vr = (Vec5D***) Vr.GetDataPointer();
-  Vec5D*** vb = (Vec5D***) Vb.GetDataPointer();
-  Vec5D*** vt = (Vec5D***) Vt.GetDataPointer();
-  Vec5D*** vk = (Vec5D***) Vk.GetDataPointer();
-  Vec5D*** vf = (Vec5D***) Vf.GetDataPointer();
+  Vec5D*** vl = (Vec5D***) Vl.GetDataPointer(sync);
+  Vec5D*** vr = (Vec5D***) Vr.GetDataPointer(sync);
+  Vec5D*** vb = (Vec5D***) Vb.GetDataPointer(sync);
+  Vec5D*** vt = (Vec5D***) Vt.GetDataPointer(sync);
+  Vec5D*** vk = (Vec5D***) Vk.GetDataPointer(sync);
+  Vec5D*** vf = (Vec5D***) Vf.GetDataPointer(sync);
 
   double*** id = (double***) ID.GetDataPointer();
 
@@ -2373,6 +2600,8 @@ SpaceOperator::CheckReconstructedStates(SpaceVariable3D &V,
   bool error = false;
   int boundary;
   int myid;
+#pragma omp parallel for collapse(2) private(clipped, boundary, myid) firstprivate(error) \
+                         reduction(+:nClipped)
   for(int k=kk0; k<kkmax; k++) {
     for(int j=jj0; j<jjmax; j++) {
       for(int i=ii0; i<iimax; i++) {
@@ -2384,6 +2613,9 @@ SpaceOperator::CheckReconstructedStates(SpaceVariable3D &V,
         if(boundary>=2) //not needed
           continue;
 
+        if(region && (region==1) != (i>=i0 && i<imax && j>=j0 && j<jmax && k>=k0 && k<kmax))
+          continue;
+
         myid = id[k][j][i];
 
         if(myid == INACTIVE_MATERIAL_ID)
@@ -2490,12 +2722,21 @@ SpaceOperator::CheckReconstructedStates(SpaceVariable3D &V,
     print_warning(comm, "Warning: Clipped pressure and/or density in %d reconstructed states.\n", nClipped);
  
   V.RestoreDataPointerToLocalVector(); //no changes made
-  Vl.RestoreDataPointerToLocalVector(); //no need to communicate
-  Vr.RestoreDataPointerToLocalVector(); 
-  Vb.RestoreDataPointerToLocalVector(); 
-  Vt.RestoreDataPointerToLocalVector(); 
-  Vk.RestoreDataPointerToLocalVector(); 
-  Vf.RestoreDataPointerToLocalVector(); 
+  if(region==1) { //clipped states will be sent to neighbors (together with the other updates)
+    Vl.RestoreDataPointerAndMarkGhostsStale();
+    Vr.RestoreDataPointerAndMarkGhostsStale();
+    Vb.RestoreDataPointerAndMarkGhostsStale();
+    Vt.RestoreDataPointerAndMarkGhostsStale();
+    Vk.RestoreDataPointerAndMarkGhostsStale();
+    Vf.RestoreDataPointerAndMarkGhostsStale();
+  } else {
+    Vl.RestoreDataPointerToLocalVector(); //no need to communicate
+    Vr.RestoreDataPointerToLocalVector(); 
+    Vb.RestoreDataPointerToLocalVector(); 
+    Vt.RestoreDataPointerToLocalVector(); 
+    Vk.RestoreDataPointerToLocalVector(); 
+    Vf.RestoreDataPointerToLocalVector(); 
+  }
   ID.RestoreDataPointerToLocalVector();
 }
 
@@ -2508,6 +2749,8 @@ void SpaceOperator::ComputeResidual(SpaceVariable3D &V, SpaceVariable3D &ID, Spa
                                     vector<unique_ptr<EmbeddedBoundaryDataSet> > *EBDS,
                                     SpaceVariable3D *Xi, bool run_heat)
 {
+  ScopedTimer scoped_timer("ComputeResidual");
+
 
 #ifdef LEVELSET_TEST
   return; //testing the level set solver without solving the N-S / Euler equations
@@ -2556,6 +2799,7 @@ void SpaceOperator::ComputeResidual(SpaceVariable3D &V, SpaceVariable3D &ID, Spa
   // -------------------------------------------------
   // multiply flux by -1, and divide by cell volume (for cells within the actual domain)
   // -------------------------------------------------
+#pragma omp parallel for collapse(2)
   for(int k=k0; k<kmax; k++)
     for(int j=j0; j<jmax; j++) 
       for(int i=i0; i<imax; i++) {
@@ -2665,6 +2909,94 @@ SpaceOperator::FindEdgeSurfaceIntersections(int dir/*0~x,1~y,2~z*/, int i, int j
 
 //-----------------------------------------------------
 
+void
+SpaceOperator::AddInterfaceRiemannProblem(int axis, int k, int j, int i, Vec3D &dir, double *Vm, int idm,
+                                          double *Vp, int idp, double curvature, double area)
+{
+  vector<InterfaceRiemannProblem> &problems(interface_riemann_problems[get_thread_num()]);
+  problems.emplace_back();
+  InterfaceRiemannProblem &prob(problems.back());
+  prob.k = k;  prob.j = j;  prob.i = i;
+  prob.axis = axis;
+  prob.dir  = dir;
+  for(int n=0; n<5; n++) {
+    prob.Vm[n] = Vm[n];
+    prob.Vp[n] = Vp[n];
+  }
+  prob.idm = idm;
+  prob.idp = idp;
+  prob.curvature = curvature;
+  prob.area = area;
+}
+
+//-----------------------------------------------------
+/** Step 1 (threaded): Solve the Riemann problems and compute the fluxes on both sides of each face.
+ *  Step 2 (serial): Store the Riemann solutions and add the fluxes to the adjacent cells. (Different
+ *  faces may share a cell.) */
+int
+SpaceOperator::ComputeInterfaceRiemannFluxes(Vec5D*** f, RiemannSolutions *riemann_solutions)
+{
+  int riemann_errors = 0;
+  bool exact_flux = iod.multiphase.flux == MultiPhaseData::EXACT; //Godunov-type flux
+
+  for(auto&& problems : interface_riemann_problems) {
+
+    int N = problems.size();
+
+#pragma omp parallel for schedule(dynamic)
+    for(int n=0; n<N; n++) {
+      InterfaceRiemannProblem &prob(problems[n]);
+      double Vmid[5];
+      int midid;
+#pragma omp critical (m2c_exact_riemann_solver)
+      prob.err = riemann.ComputeRiemannSolution(prob.dir, prob.Vm, prob.idm, prob.Vp, prob.idp,
+                                                Vmid, midid, prob.Vsm, prob.Vsp, prob.curvature);
+
+      //Clip Riemann solution and check it
+      varFcn[prob.idm]->ClipDensityAndPressure(prob.Vsm);
+      varFcn[prob.idm]->CheckState(prob.Vsm);
+      varFcn[prob.idp]->ClipDensityAndPressure(prob.Vsp);
+      varFcn[prob.idp]->CheckState(prob.Vsp);
+
+      if(exact_flux) {
+        if(prob.axis==0)      fluxFcn.EvaluateFluxFunction_F(Vmid, midid, prob.flux1);
+        else if(prob.axis==1) fluxFcn.EvaluateFluxFunction_G(Vmid, midid, prob.flux1);
+        else                  fluxFcn.EvaluateFluxFunction_H(Vmid, midid, prob.flux1);
+        prob.flux2 = prob.flux1;
+      } else {//Numerical flux function
+        fluxFcn.ComputeNumericalFluxAtCellInterface(prob.axis, prob.Vm, prob.Vsm/*Vp*/, prob.idm, prob.flux1);
+        fluxFcn.ComputeNumericalFluxAtCellInterface(prob.axis, prob.Vsp/*Vm*/, prob.Vp, prob.idp, prob.flux2);
+      }
+    }
+
+    for(auto&& prob : problems) {
+
+      int k = prob.k, j = prob.j, i = prob.i;
+      int km = prob.axis==2 ? k-1 : k;
+      int jm = prob.axis==1 ? j-1 : j;
+      int im = prob.axis==0 ? i-1 : i;
+
+      if(prob.err)
+        riemann_errors++;
+      else if(riemann_solutions) {//store Riemann solution for "phase-change update"
+        RiemannSolutionMap *minus_side = prob.axis==0 ? &riemann_solutions->left
+                                       : (prob.axis==1 ? &riemann_solutions->bottom : &riemann_solutions->back);
+        RiemannSolutionMap *plus_side  = prob.axis==0 ? &riemann_solutions->right
+                                       : (prob.axis==1 ? &riemann_solutions->top : &riemann_solutions->front);
+        minus_side->Insert(Int3(k,j,i), (Vec5D)prob.Vsm, prob.idm);
+        plus_side->Insert(Int3(km,jm,im), (Vec5D)prob.Vsp, prob.idp);
+      }
+
+      f[km][jm][im] += prob.flux1*prob.area;
+      f[k][j][i]    -= prob.flux2*prob.area;
+    }
+  }
+
+  return riemann_errors;
+}
+
+//-----------------------------------------------------
+
 Vec3D
 SpaceOperator::GetNormalForOneSidedRiemann(int d, int forward_or_backward, Vec3D& nwall)
 {
@@ -15,6 +15,7 @@
 #include <FluxFcnBase.h>
 #include <Reconstructor.h>
 #include <RiemannSolutions.h>
+#include <SpaceVariableSoA.h>
 
 class EmbeddedBoundaryDataSet;
 class TriangulatedSurface;
@@ -79,6 +80,10 @@ class SpaceOperator
   //! For temporary variable (5D)
   SpaceVariable3D Utmp;
 
+  //! Work buffers in the structure-of-arrays layout (only used if iod.schemes.ns.layout == STRUCTURE_OF_ARRAYS,
+  //! which is experimental)
+  SpaceVariable3DSoA Usoa, Vsoa;
+
   //! internal variable for temporary use (1D)
   SpaceVariable3D Tag;
 
@@ -86,6 +91,23 @@ class SpaceOperator
   bool domain_has_overset; //!< whether the entire domain has overset boundaries
   vector<std::pair<Int3, Vec5D> > ghost_overset; //!< overset ghost nodes outside the physical domain
 
+  //! A bimaterial Riemann problem at a cell face (k,j,i)-1/2 (see ComputeAdvectionFluxes)
+  struct InterfaceRiemannProblem {
+    int k, j, i;
+    int axis; //!< 0~x, 1~y, 2~z
+    Vec3D dir; //!< normal of the 1D Riemann problem
+    double Vm[5], Vp[5];
+    int idm, idp;
+    double curvature, area;
+    //! results
+    Vec5D flux1, flux2; //!< fluxes on the minus and plus sides
+    double Vsm[5], Vsp[5];
+    int err;
+  };
+
+  //! Interface Riemann problems collected by each thread. Reused in every time step.
+  vector<vector<InterfaceRiemannProblem> > interface_riemann_problems;
+
 
 public:
   SpaceOperator(MPI_Comm &comm_, DataManagers3D &dm_all_, IoData &iod_,
@@ -166,18 +188,30 @@ private:
 
   void CreateGhostNodeLists(bool screenout);
 
+  //! Versions of ConservativeToPrimitive and PrimitiveToConservative in the structure-of-arrays layout
+  void ConservativeToPrimitiveSoA(SpaceVariable3D &U, SpaceVariable3D &ID, SpaceVariable3D &V, bool workOnGhost);
+  void PrimitiveToConservativeSoA(SpaceVariable3D &V, SpaceVariable3D &ID, SpaceVariable3D &U, bool workOnGhost);
+
   void ApplyBoundaryConditionsGeometricEntities(Vec5D*** v);
 
   void CheckReconstructedStates(SpaceVariable3D &V,
                                 SpaceVariable3D &Vl, SpaceVariable3D &Vr, SpaceVariable3D &Vb,
                                 SpaceVariable3D &Vt, SpaceVariable3D &Vk, SpaceVariable3D &Vf,
-                                SpaceVariable3D &ID);
+                                SpaceVariable3D &ID,
+                                int region = 0/*0~all, 1~subdomain interior, 2~ghost layer*/);
 
   void ComputeAdvectionFluxes(SpaceVariable3D &V, SpaceVariable3D &ID, SpaceVariable3D &F,
                               RiemannSolutions *riemann_solutions = NULL,
                               vector<int> *ls_mat_id = NULL, vector<SpaceVariable3D*> *Phi = NULL, vector<SpaceVariable3D*> *KappaPhi = NULL,
                               vector<std::unique_ptr<EmbeddedBoundaryDataSet> > *EBDS = nullptr);
 
+  //! Adds a bimaterial Riemann problem to the work list of the calling thread
+  void AddInterfaceRiemannProblem(int axis, int k, int j, int i, Vec3D &dir, double *Vm, int idm,
+                                  double *Vp, int idp, double curvature, double area);
+
+  //! Solves the collected bimaterial Riemann problems and adds the fluxes to f. Returns the number of errors.
+  int ComputeInterfaceRiemannFluxes(Vec5D*** f, RiemannSolutions *riemann_solutions);
+
   Vec3D GetNormalForOneSidedRiemann(int d,/*0,1,2*/
                                     int forward_or_backward,/*1~wall is in the +x/y/z dir of material, -1~-x/y/z*/
                                     Vec3D& nwall);
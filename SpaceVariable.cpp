@@ -7,6 +7,7 @@
 #include <GlobalMeshInfo.h>
 #include <petscviewer.h>
 #include <Utils.h>
+#include <Timer.h>
 #include <bits/stdc++.h> //min_element, max_element
 using std::vector;
 extern int INACTIVE_MATERIAL_ID;
@@ -182,6 +183,8 @@ void DataManagers3D::DestroyAllDataManagers()
 SpaceVariable3D::SpaceVariable3D() : comm(NULL), dm(NULL), globalVec(), localVec()
 {
   array = NULL;
+  ghosts_stale = false;
+  ghost_update_in_progress = false;
 }
 
 //---------------------------------------------------------
@@ -206,6 +209,9 @@ void SpaceVariable3D::Setup(MPI_Comm &comm_, DM *dm_)
 
   array = NULL;
 
+  ghosts_stale = false;
+  ghost_update_in_progress = false;
+
   DMBoundaryType bx, by, bz;
 
   DMDAGetInfo(*dm, NULL, &NX, &NY, &NZ, &nProcX, &nProcY, &nProcZ, &dof, &ghost_width, 
@@ -255,10 +261,13 @@ SpaceVariable3D::~SpaceVariable3D()
 
 //---------------------------------------------------------
 
-double*** SpaceVariable3D::GetDataPointer()
+double*** SpaceVariable3D::GetDataPointer(bool sync_ghosts)
 {
   if(!dm) return NULL;
 
+  if(sync_ghosts)
+    UpdateGhosts(); //"exchange on first read"
+
   DMDAVecGetArray(*dm, localVec, &array);
   return array;
 }
@@ -271,11 +280,18 @@ void SpaceVariable3D::RestoreDataPointerAndInsert()
     return;
 
   RestoreDataPointerToLocalVector();
+
+  if(ghost_update_in_progress) //should not happen, unless the user has ignored the caveat in GetDataPointer
+    EndGhostUpdate();
+
   DMLocalToGlobal(*dm, localVec, INSERT_VALUES, globalVec);
 
   // sync local to global
+  ScopedTimer scoped_timer("GhostExchange");
   DMGlobalToLocalBegin(*dm, globalVec, INSERT_VALUES, localVec);
   DMGlobalToLocalEnd(*dm, globalVec, INSERT_VALUES, localVec);
+
+  ghosts_stale = false;
 }
 
 //---------------------------------------------------------
@@ -286,11 +302,79 @@ void SpaceVariable3D::RestoreDataPointerAndAdd()
     return;
 
   RestoreDataPointerToLocalVector();
+
+  if(ghost_update_in_progress)
+    EndGhostUpdate();
+
   DMLocalToGlobal(*dm, localVec, ADD_VALUES, globalVec);
 
   // sync local to global
+  ScopedTimer scoped_timer("GhostExchange");
+  DMGlobalToLocalBegin(*dm, globalVec, INSERT_VALUES, localVec);
+  DMGlobalToLocalEnd(*dm, globalVec, INSERT_VALUES, localVec);
+
+  ghosts_stale = false;
+}
+
+//---------------------------------------------------------
+
+void SpaceVariable3D::RestoreDataPointerAndMarkGhostsStale()
+{
+  if(!dm)
+    return;
+
+  RestoreDataPointerToLocalVector();
+
+  if(ghost_update_in_progress)
+    EndGhostUpdate();
+
+  // With INSERT_VALUES, this only copies the subdomain interior (no communication)
+  DMLocalToGlobal(*dm, localVec, INSERT_VALUES, globalVec);
+
+  ghosts_stale = true;
+}
+
+//---------------------------------------------------------
+
+void SpaceVariable3D::BeginGhostUpdate()
+{
+  if(!dm || !ghosts_stale || ghost_update_in_progress)
+    return; //nothing to do
+
+  // The subdomain interior may have been modified after the variable was marked stale (e.g., by a
+  // function that only works on the interior). Copy it to globalVec first (local, no communication).
+  DMLocalToGlobal(*dm, localVec, INSERT_VALUES, globalVec);
+
   DMGlobalToLocalBegin(*dm, globalVec, INSERT_VALUES, localVec);
+  ghost_update_in_progress = true;
+}
+
+//---------------------------------------------------------
+
+void SpaceVariable3D::EndGhostUpdate()
+{
+  if(!dm || !ghost_update_in_progress)
+    return; //nothing to do
+
+  ScopedTimer scoped_timer("GhostExchange"); //only the part that is not overlapped with computation
   DMGlobalToLocalEnd(*dm, globalVec, INSERT_VALUES, localVec);
+  ghost_update_in_progress = false;
+  ghosts_stale = false;
+}
+
+//---------------------------------------------------------
+
+void SpaceVariable3D::UpdateGhosts()
+{
+  if(!dm)
+    return;
+
+  if(ghost_update_in_progress)
+    EndGhostUpdate();
+  else if(ghosts_stale) {
+    BeginGhostUpdate();
+    EndGhostUpdate();
+  }
 }
 
 //---------------------------------------------------------
@@ -310,9 +394,15 @@ void SpaceVariable3D::SyncLocalToGlobal()
   if(!dm)
     return;
 
+  if(ghost_update_in_progress)
+    EndGhostUpdate();
+
   // sync local to global
+  ScopedTimer scoped_timer("GhostExchange");
   DMGlobalToLocalBegin(*dm, globalVec, INSERT_VALUES, localVec);
   DMGlobalToLocalEnd(*dm, globalVec, INSERT_VALUES, localVec);
+
+  ghosts_stale = false;
 }
 
 //---------------------------------------------------------
@@ -322,6 +412,9 @@ void SpaceVariable3D::Destroy()
   if(!dm)
     return;
 
+  if(ghost_update_in_progress)
+    EndGhostUpdate();
+
   VecDestroy(&globalVec);
   VecDestroy(&localVec);
 }
@@ -413,12 +506,58 @@ void SpaceVariable3D::SetOutputVariableName(const char *name)
 
 //---------------------------------------------------------
 
+void SpaceVariable3D::WriteLocalArrayToStream(std::ostream &out)
+{
+  if(!dm)
+    return;
+
+  UpdateGhosts(); //the saved internal ghost layer should be up-to-date
+
+  int layout[7] = {dof, ghost_i0, ghost_j0, ghost_k0, ghost_imax, ghost_jmax, ghost_kmax};
+  out.write(reinterpret_cast<const char*>(layout), sizeof(layout));
+
+  double *a;
+  VecGetArray(localVec, &a);
+  out.write(reinterpret_cast<const char*>(a), sizeof(double)*numNodes2*dof);
+  VecRestoreArray(localVec, &a);
+}
+
+//---------------------------------------------------------
+
+bool SpaceVariable3D::ReadLocalArrayFromStream(std::istream &in)
+{
+  if(!dm)
+    return true;
+
+  int layout[7];
+  in.read(reinterpret_cast<char*>(layout), sizeof(layout));
+  if(!in || layout[0] != dof || layout[1] != ghost_i0 || layout[2] != ghost_j0 || layout[3] != ghost_k0 ||
+     layout[4] != ghost_imax || layout[5] != ghost_jmax || layout[6] != ghost_kmax)
+    return false;
+
+  if(ghost_update_in_progress)
+    EndGhostUpdate();
+
+  double *a;
+  VecGetArray(localVec, &a);
+  in.read(reinterpret_cast<char*>(a), sizeof(double)*numNodes2*dof);
+  VecRestoreArray(localVec, &a);
+
+  // With INSERT_VALUES, this only copies the subdomain interior (no communication)
+  DMLocalToGlobal(*dm, localVec, INSERT_VALUES, globalVec);
+  ghosts_stale = false; //the ghost layer has also been read
+
+  return (bool)in;
+}
+
+//---------------------------------------------------------
+
 void SpaceVariable3D::AXPlusB(double a, double b, bool workOnGhost)
 {
   if(!dm)
     return;
 
-  double*** v = GetDataPointer();
+  double*** v = GetDataPointer(workOnGhost);
   int myi0, myj0, myk0, myimax, myjmax, mykmax;
 
   if(workOnGhost)
@@ -432,7 +571,10 @@ void SpaceVariable3D::AXPlusB(double a, double b, bool workOnGhost)
         for(int p=0; p<dof; p++)
           v[k][j][i*dof+p] = a*v[k][j][i*dof+p] + b;
 
-  RestoreDataPointerAndInsert();
+  if(workOnGhost)
+    RestoreDataPointerAndInsert();
+  else
+    RestoreDataPointerAndMarkGhostsStale(); //ghost layer updated when (and if) needed
 }
 
 //---------------------------------------------------------
@@ -444,8 +586,8 @@ void SpaceVariable3D::AXPlusBY(double a, double b, SpaceVariable3D &y, bool work
     exit_mpi();
   }
 
-  double*** v  = GetDataPointer();
-  double*** v2 = y.GetDataPointer();
+  double*** v  = GetDataPointer(workOnGhost);
+  double*** v2 = y.GetDataPointer(workOnGhost);
 
   int myi0, myj0, myk0, myimax, myjmax, mykmax;
 
@@ -460,7 +602,10 @@ void SpaceVariable3D::AXPlusBY(double a, double b, SpaceVariable3D &y, bool work
         for(int p=0; p<dof; p++)
           v[k][j][i*dof+p] = a*v[k][j][i*dof+p] + b*v2[k][j][i*dof+p];
 
-  RestoreDataPointerAndInsert();
+  if(workOnGhost)
+    RestoreDataPointerAndInsert();
+  else
+    RestoreDataPointerAndMarkGhostsStale(); //ghost layer updated when (and if) needed
   y.RestoreDataPointerToLocalVector(); //no changes
 }
 
@@ -490,8 +635,8 @@ void SpaceVariable3D::AXPlusBY(double a, double b, SpaceVariable3D &y, std::vect
     exit_mpi();
   }
 
-  double*** v  = GetDataPointer();
-  double*** v2 = y.GetDataPointer();
+  double*** v  = GetDataPointer(workOnGhost);
+  double*** v2 = y.GetDataPointer(workOnGhost);
 
   int myi0, myj0, myk0, myimax, myjmax, mykmax;
 
@@ -510,7 +655,10 @@ void SpaceVariable3D::AXPlusBY(double a, double b, SpaceVariable3D &y, std::vect
           v[k][j][i*dof+px] = a*v[k][j][i*dof+px] + b*v2[k][j][i*dof+py];
         }
 
-  RestoreDataPointerAndInsert();
+  if(workOnGhost)
+    RestoreDataPointerAndInsert();
+  else
+    RestoreDataPointerAndMarkGhostsStale(); //ghost layer updated when (and if) needed
   y.RestoreDataPointerToLocalVector(); //no changes
 }
 
@@ -518,7 +666,7 @@ void SpaceVariable3D::AXPlusBY(double a, double b, SpaceVariable3D &y, std::vect
 
 void SpaceVariable3D::SetConstantValue(double a, bool workOnGhost)
 {
-  double*** v  = GetDataPointer();
+  double*** v  = GetDataPointer(workOnGhost);
 
   int myi0, myj0, myk0, myimax, myjmax, mykmax;
 
@@ -533,7 +681,10 @@ void SpaceVariable3D::SetConstantValue(double a, bool workOnGhost)
         for(int p=0; p<dof; p++)
           v[k][j][i*dof+p] = a;
 
-  RestoreDataPointerAndInsert();
+  if(workOnGhost)
+    RestoreDataPointerAndInsert();
+  else
+    RestoreDataPointerAndMarkGhostsStale(); //ghost layer updated when (and if) needed
 }
 
 //---------------------------------------------------------
@@ -545,7 +696,7 @@ SpaceVariable3D::CalculateGlobalMin(int mydof, bool workOnGhost)
 
   double global_min = DBL_MAX;
 
-  double*** v  = GetDataPointer();
+  double*** v  = GetDataPointer(workOnGhost);
 
   int myi0, myj0, myk0, myimax, myjmax, mykmax;
 
@@ -575,7 +726,7 @@ SpaceVariable3D::CalculateGlobalMax(int mydof, bool workOnGhost)
 
   double global_max = -DBL_MAX;
 
-  double*** v  = GetDataPointer();
+  double*** v  = GetDataPointer(workOnGhost);
 
   int myi0, myj0, myk0, myimax, myjmax, mykmax;
 
@@ -636,8 +787,8 @@ SpaceVariable3D::CalculateFunctionNormsConRec(SpaceVariable3D &volume, vector<do
   norm2_dofs.assign(dof,0.0);
   norminf_dofs.assign(dof,0.0);
 
-  double*** v   = GetDataPointer();
-  double*** vol = volume.GetDataPointer();
+  double*** v   = GetDataPointer(false); //only the interior is needed
+  double*** vol = volume.GetDataPointer(false);
 
   for(int k=k0; k<kmax; k++)
     for(int j=j0; j<jmax; j++)
@@ -669,9 +820,9 @@ SpaceVariable3D::CalculateFunctionNormsConRec(SpaceVariable3D &ID, SpaceVariable
   norm2_dofs.assign(dof,0.0);
   norminf_dofs.assign(dof,0.0);
 
-  double*** v   = GetDataPointer();
-  double*** vol = volume.GetDataPointer();
-  double*** id  = ID.GetDataPointer();
+  double*** v   = GetDataPointer(false); //only the interior is needed
+  double*** vol = volume.GetDataPointer(false);
+  double*** id  = ID.GetDataPointer(false);
 
   for(int k=k0; k<kmax; k++)
     for(int j=j0; j<jmax; j++)
@@ -707,7 +858,7 @@ SpaceVariable3D::CalculateFunctionNormsConRec(GlobalMeshInfo &global_mesh, vecto
   norm2_dofs.assign(dof,0.0);
   norminf_dofs.assign(dof,0.0);
 
-  double*** v   = GetDataPointer();
+  double*** v   = GetDataPointer(false); //only the interior is needed
 
   double dz, dydz, dxdydz;
   for(int k=k0; k<kmax; k++) {
@@ -746,8 +897,8 @@ SpaceVariable3D::CalculateFunctionNormsConRec(SpaceVariable3D &ID,
   norm2_dofs.assign(dof,0.0);
   norminf_dofs.assign(dof,0.0);
 
-  double*** v  = GetDataPointer();
-  double*** id = ID.GetDataPointer();
+  double*** v  = GetDataPointer(false); //only the interior is needed
+  double*** id = ID.GetDataPointer(false);
 
   double dz, dydz, dxdydz;
   for(int k=k0; k<kmax; k++) {
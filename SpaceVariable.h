@@ -7,6 +7,7 @@
 #define _SPACEVARIABLE_
 #include <petscdmda.h>
 #include <vector>
+#include <iostream>
 
 /*******************************************
  * This class stores all the DM's
@@ -49,6 +50,8 @@ class GlobalMeshInfo;
 
 class SpaceVariable3D {
 
+  friend class GhostExchangeGroup; //!< packs several variables into one exchange
+
   MPI_Comm*  comm; 
   DM*        dm;   
   Vec        globalVec;  //!< each process only stores a local portion, without ghost
@@ -76,6 +79,9 @@ class SpaceVariable3D {
   long long  numNodes1; //number of interior nodes + internal ghost nodes
   long long  numNodes2; //number of interior nodes + internal & external ghost nodes
 
+  bool       ghosts_stale; //!< globalVec is up-to-date, but the internal ghost layer of localVec is not
+  bool       ghost_update_in_progress; //!< DMGlobalToLocalBegin has been called, End has not
+
 public:
   SpaceVariable3D(MPI_Comm &comm_, DM *dm_);
   SpaceVariable3D(); //must be followed by a call to function Setup(...)
@@ -83,7 +89,12 @@ public:
 
   void Setup(MPI_Comm &comm_, DM *dm_);
 
-  double*** GetDataPointer(); 
+  /** By default, a pending (stale or in-progress) ghost update is completed before the pointer is
+   *  returned. This may involve MPI communications, so all the processors must call it together.
+   *  With sync_ghosts = false, the pointer is returned right away. In this case, the caller must not
+   *  read the internal ghost layer, and if an update is in progress, must not write to the subdomain
+   *  interior or the internal ghost layer. (The external ghost layer is never communicated.) */
+  double*** GetDataPointer(bool sync_ghosts = true); 
 
   /** The following two functions involve MPI communications
    *  Note that only the data in the real domain gets "communicated" (i.e. inserted or added)
@@ -93,6 +104,17 @@ public:
   void RestoreDataPointerAndInsert();
   void RestoreDataPointerAndAdd();
 
+  /** Split-phase version of RestoreDataPointerAndInsert. globalVec is updated (no communication),
+   *  but the internal ghost layer is only marked "stale". It is refreshed by Begin/EndGhostUpdate
+   *  (e.g., to overlap communication with computation), UpdateGhosts, or the next call to
+   *  GetDataPointer(), whichever comes first. If the variable is written again before its ghost
+   *  layer is read, the exchange is skipped altogether. */
+  void RestoreDataPointerAndMarkGhostsStale();
+  void BeginGhostUpdate(); //!< starts DMGlobalToLocal if the ghost layer is stale (collective)
+  void EndGhostUpdate(); //!< completes the update started by BeginGhostUpdate (collective)
+  void UpdateGhosts(); //!< completes any pending ghost update (collective)
+  inline bool GhostsAreStale() {return ghosts_stale || ghost_update_in_progress;}
+
   void RestoreDataPointerToLocalVector(); //!< caution: does not update globalVec
   void Destroy(); //!< should be called before PetscFinalize!
 
@@ -102,6 +124,11 @@ public:
   void WriteToMatlabFile(const char *filename, const char *varname = NULL);
   void SetOutputVariableName(const char *name); //!< give it a name, which will show up in output files (VTR/VTK)
 
+  /** Raw binary I/O of the local array, including ghost layers (for checkpoint/restart). Reading requires
+   *  the same domain partition. Returns false if the data in the stream does not match this variable.*/
+  void WriteLocalArrayToStream(std::ostream &out);
+  bool ReadLocalArrayFromStream(std::istream &in);
+
   inline void GetCornerIndices(int *i0_, int *j0_, int *k0_, int *imax_=0, int *jmax_=0, int *kmax_=0) {
     *i0_ = i0; *j0_ = j0; *k0_ = k0; 
     if(imax_) *imax_ = imax; 
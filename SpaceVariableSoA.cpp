@@ -0,0 +1,122 @@
+/************************************************************************
+ * Copyright © 2020 The Multiphysics Modeling and Computation (M2C) Lab
+ * <kevin.wgy@gmail.com> <kevinw3@vt.edu>
+ ************************************************************************/
+
+#include<SpaceVariableSoA.h>
+#include<cstdlib> //aligned_alloc
+#include<algorithm> //std::fill
+#include<cassert>
+
+//! alignment of each component array (in bytes). 64 bytes = one AVX-512 register / cache line
+static const int SOA_ALIGNMENT = 64;
+
+//---------------------------------------------------------
+
+SpaceVariable3DSoA::SpaceVariable3DSoA() : dof(0), size(0), stride(0), data(NULL)
+{ }
+
+//---------------------------------------------------------
+
+SpaceVariable3DSoA::~SpaceVariable3DSoA()
+{
+  Destroy();
+}
+
+//---------------------------------------------------------
+
+void
+SpaceVariable3DSoA::Destroy()
+{
+  if(data)
+    free(data);
+  data = NULL;
+  size = stride = 0;
+}
+
+//---------------------------------------------------------
+
+void
+SpaceVariable3DSoA::Setup(SpaceVariable3D &U)
+{
+  int new_dof = U.NumDOF();
+  U.GetCornerIndices(&i0, &j0, &k0, &imax, &jmax, &kmax);
+  U.GetGhostedCornerIndices(&ghost_i0, &ghost_j0, &ghost_k0, &ghost_imax, &ghost_jmax, &ghost_kmax);
+  ghost_nx = ghost_imax - ghost_i0;
+  ghost_ny = ghost_jmax - ghost_j0;
+  ghost_nz = ghost_kmax - ghost_k0;
+
+  long long new_size = (long long)ghost_nx*ghost_ny*ghost_nz;
+  if(data && new_dof == dof && new_size == size)
+    return; //nothing to do
+
+  Destroy();
+
+  dof  = new_dof;
+  size = new_size;
+
+  int n_align = SOA_ALIGNMENT/sizeof(double);
+  stride = (size + n_align - 1)/n_align*n_align;
+
+  data = (double*)aligned_alloc(SOA_ALIGNMENT, sizeof(double)*stride*dof);
+  assert(data);
+  std::fill(data, data + stride*dof, 0.0); //also initializes the padding
+}
+
+//---------------------------------------------------------
+
+void
+SpaceVariable3DSoA::Gather(SpaceVariable3D &U, bool workOnGhost)
+{
+  assert(U.NumDOF() == dof);
+
+  double*** u = U.GetDataPointer(workOnGhost);
+
+  int myi0, myj0, myk0, myimax, myjmax, mykmax;
+  if(workOnGhost)
+    U.GetGhostedCornerIndices(&myi0, &myj0, &myk0, &myimax, &myjmax, &mykmax);
+  else
+    U.GetCornerIndices(&myi0, &myj0, &myk0, &myimax, &myjmax, &mykmax);
+
+  for(int p=0; p<dof; p++) {
+    double *a = Component(p);
+    for(int k=myk0; k<mykmax; k++)
+      for(int j=myj0; j<myjmax; j++) {
+        double *row = a + Index(0,j,k);
+        double *urow = u[k][j];
+        for(int i=myi0; i<myimax; i++)
+          row[i] = urow[i*dof+p];
+      }
+  }
+
+  U.RestoreDataPointerToLocalVector(); //no changes made
+}
+
+//---------------------------------------------------------
+
+void
+SpaceVariable3DSoA::Scatter(SpaceVariable3D &U, bool workOnGhost)
+{
+  assert(U.NumDOF() == dof);
+
+  double*** u = U.GetDataPointer(false);
+
+  int myi0, myj0, myk0, myimax, myjmax, mykmax;
+  if(workOnGhost)
+    U.GetGhostedCornerIndices(&myi0, &myj0, &myk0, &myimax, &myjmax, &mykmax);
+  else
+    U.GetCornerIndices(&myi0, &myj0, &myk0, &myimax, &myjmax, &mykmax);
+
+  for(int k=myk0; k<mykmax; k++)
+    for(int j=myj0; j<myjmax; j++) {
+      double *urow = u[k][j];
+      long long n0 = Index(0,j,k);
+      for(int i=myi0; i<myimax; i++)
+        for(int p=0; p<dof; p++)
+          urow[i*dof+p] = data[p*stride + n0 + i];
+    }
+
+  U.RestoreDataPointerAndMarkGhostsStale();
+}
+
+//---------------------------------------------------------
@@ -0,0 +1,63 @@
+/************************************************************************
+ * Copyright © 2020 The Multiphysics Modeling and Computation (M2C) Lab
+ * <kevin.wgy@gmail.com> <kevinw3@vt.edu>
+ ************************************************************************/
+
+#ifndef _SPACEVARIABLE_SOA_H_
+#define _SPACEVARIABLE_SOA_H_
+
+#include<SpaceVariable.h>
+
+/*********************************************************************
+ * class SpaceVariable3DSoA stores a multi-dof field (e.g., V or U) in
+ * the "structure-of-arrays" (SoA) layout: one contiguous (64-byte
+ * aligned) array per component, covering the ghosted subdomain. This
+ * allows the compiler to vectorize element-wise kernels across
+ * neighboring cells, which is not possible with the interleaved layout
+ * of SpaceVariable3D (i.e. Vec5D***).
+ * Notes:
+ *   - This is a work buffer attached to a SpaceVariable3D, which keeps
+ *     the PETSc vectors (for ghost exchange, I/O, etc.). Data are moved
+ *     between the two layouts by Gather and Scatter.
+ *   - Index(i,j,k) gives the position of node (i,j,k) in each component
+ *     array. Along i, nodes are contiguous.
+ *********************************************************************
+*/
+
+class SpaceVariable3DSoA
+{
+  int dof;
+
+  int i0, j0, k0, imax, jmax, kmax; //!< corners of the actual subdomain
+  int ghost_i0, ghost_j0, ghost_k0, ghost_imax, ghost_jmax, ghost_kmax; //!< corners of the ghosted subdomain
+  int ghost_nx, ghost_ny, ghost_nz;
+
+  long long size; //!< number of nodes in the ghosted subdomain
+  long long stride; //!< distance between the first entries of two components (>= size, padded for alignment)
+
+  double *data;
+
+public:
+
+  SpaceVariable3DSoA();
+  ~SpaceVariable3DSoA();
+
+  //! takes the dof and the subdomain of U (no data is copied). Can be called again with a different U.
+  void Setup(SpaceVariable3D &U);
+  void Destroy();
+
+  inline bool IsSetup() {return data != NULL;}
+  inline int  NumDOF() {return dof;}
+
+  inline double* Component(int p) {return data + p*stride;}
+  inline long long Index(int i, int j, int k) {
+    return ((long long)(k-ghost_k0)*ghost_ny + (j-ghost_j0))*ghost_nx + (i-ghost_i0);}
+
+  //! U (interleaved) --> this (SoA). If workOnGhost, the ghost layer is also copied.
+  void Gather(SpaceVariable3D &U, bool workOnGhost = false);
+  //! this (SoA) --> U (interleaved). The ghost layer of U is marked stale (not exchanged).
+  void Scatter(SpaceVariable3D &U, bool workOnGhost = false);
+
+};
+
+#endif
@@ -35,6 +35,39 @@ SteadyStateOperator::Destroy()
 
 //--------------------------------------------------------------------------
 
+void
+SteadyStateOperator::WriteRestartData(std::ostream &out)
+{
+  int ref = ref_calculated ? 1 : 0;
+  int nref = Rref.size();
+  out.write(reinterpret_cast<const char*>(&ref), sizeof(int));
+  out.write(reinterpret_cast<const char*>(&nref), sizeof(int));
+  out.write(reinterpret_cast<const char*>(Rref.data()), sizeof(double)*nref);
+  double norms[3] = {R1_init, R2_init, Rinf_init};
+  out.write(reinterpret_cast<const char*>(norms), sizeof(norms));
+}
+
+//--------------------------------------------------------------------------
+
+void
+SteadyStateOperator::ReadRestartData(std::istream &in)
+{
+  int ref, nref;
+  in.read(reinterpret_cast<char*>(&ref), sizeof(int));
+  in.read(reinterpret_cast<char*>(&nref), sizeof(int));
+  Rref.resize(nref);
+  in.read(reinterpret_cast<char*>(Rref.data()), sizeof(double)*nref);
+  double norms[3];
+  in.read(reinterpret_cast<char*>(norms), sizeof(norms));
+
+  ref_calculated = (ref==1);
+  R1_init   = norms[0];
+  R2_init   = norms[1];
+  Rinf_init = norms[2];
+}
+
+//--------------------------------------------------------------------------
+
 void
 SteadyStateOperator::MonitorConvergence(SpaceVariable3D &R, SpaceVariable3D &ID)
 {
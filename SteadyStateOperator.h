@@ -53,6 +53,10 @@ public:
  
   double GetResidualInfNorm() {return Rinf;}
   double GetRelativeResidualInfNorm() {return Rinf/Rinf_init;}
+
+  //! checkpoint/restart (the reference and initial residuals)
+  void WriteRestartData(std::ostream &out);
+  void ReadRestartData(std::istream &in);
  
 protected:
 
@@ -23,7 +23,8 @@ TimeIntegratorBase::TimeIntegratorBase(MPI_Comm &comm_, IoData& iod_, DataManage
                         LaserAbsorptionSolver* laser_, EmbeddedBoundaryOperator* embed_,
                         HyperelasticityOperator* heo_, PrescribedMotionOperator* pmo_)
                   : comm(comm_), iod(iod_), spo(spo_), lso(lso_), mpo(mpo_), laser(laser_), embed(embed_),
-                    heo(heo_), pmo(pmo_), IDn(comm_, &(dms_.ghosted1_1dof)), sso(NULL),
+                    heo(heo_), pmo(pmo_), IDn(comm_, &(dms_.ghosted1_1dof)), ghost_exchange(comm_), fused_ls(NULL),
+                    sso(NULL),
                     local_time_stepping(iod.ts.local_dt == TsData::YES)
 {
 
@@ -38,6 +39,15 @@ TimeIntegratorBase::TimeIntegratorBase(MPI_Comm &comm_, IoData& iod_, DataManage
   if(local_time_stepping)
     assert(lso.size()==0);
 
+  if(iod.schemes.fuse_levelsets == SchemesData::YES && !lso.empty()) {
+    if(FusedLevelSetAdvector::Applicable(lso))
+      fused_ls = new FusedLevelSetAdvector(comm_, dms_, spo.GetMeshCoordinates(), spo.GetMeshDeltaXYZ(),
+                                           lso.size());
+    else
+      print_warning("Warning: Level sets cannot be fused (requires the full-domain finite difference "
+                    "scheme for all). Advancing them one by one.\n");
+  }
+
   if(iod.ts.convergence_tolerance>0.0) //steady-state analysis
     sso = new SteadyStateOperator(comm_, iod.ts, spo.GetGlobalMeshInfo());
 }
@@ -48,6 +58,8 @@ TimeIntegratorBase::~TimeIntegratorBase()
 {
   if(sso)
     delete sso;
+  if(fused_ls)
+    delete fused_ls;
 } 
 
 //----------------------------------------------------------------------------
@@ -57,6 +69,11 @@ TimeIntegratorBase::Destroy()
 {
   IDn.Destroy();
 
+  ghost_exchange.Destroy();
+
+  if(fused_ls)
+    fused_ls->Destroy();
+
   for(int i=0; i<(int)Phi_tmp.size(); i++) {
     Phi_tmp[i]->Destroy(); 
     delete Phi_tmp[i];
@@ -68,6 +85,60 @@ TimeIntegratorBase::Destroy()
 
 //----------------------------------------------------------------------------
 
+void
+TimeIntegratorBase::WriteRestartData(std::ostream &out)
+{
+  int has_sso = sso ? 1 : 0;
+  out.write(reinterpret_cast<const char*>(&has_sso), sizeof(int));
+  if(sso)
+    sso->WriteRestartData(out);
+}
+
+//----------------------------------------------------------------------------
+
+void
+TimeIntegratorBase::ReadRestartData(std::istream &in)
+{
+  int has_sso = 0;
+  in.read(reinterpret_cast<char*>(&has_sso), sizeof(int));
+  if((has_sso==1) != (sso!=NULL)) {
+    print_error(comm, "*** Error: The restart files and the input file disagree on steady-state analysis.\n");
+    exit_mpi();
+  }
+  if(sso)
+    sso->ReadRestartData(in);
+}
+
+//----------------------------------------------------------------------------
+
+void
+TimeIntegratorBase::ExchangeGhostLayers(SpaceVariable3D &V, vector<SpaceVariable3D*> &Phi, SpaceVariable3D *Xi)
+{
+  ghost_exchange.Clear();
+  ghost_exchange.Add(V);
+  ghost_exchange.Add(Phi);
+  if(Xi)
+    ghost_exchange.Add(*Xi);
+  ghost_exchange.Exchange(); //only those with "stale" ghost layers are exchanged
+}
+
+//----------------------------------------------------------------------------
+
+void
+TimeIntegratorBase::ComputeLevelSetResiduals(SpaceVariable3D &V, vector<SpaceVariable3D*> &Phi,
+                                             vector<SpaceVariable3D*> &R, double time)
+{
+  if(fused_ls && Phi.size()>0) {
+    fused_ls->ComputeResiduals(V, Phi, R);
+    return;
+  }
+
+  for(int i=0; i<(int)Phi.size(); i++)
+    lso[i]->ComputeResidual(V, *Phi[i], *R[i], time);
+}
+
+//----------------------------------------------------------------------------
+
 void
 TimeIntegratorBase::AddFluxWithLocalTimeStep(SpaceVariable3D &U, double alpha,
                                              SpaceVariable3D *Dt, SpaceVariable3D &R)
@@ -203,8 +274,8 @@ TimeIntegratorFE::AdvanceOneTimeStep(SpaceVariable3D &V, SpaceVariable3D &ID,
   // -------------------------------------------------------------------------------
   // Forward Euler step for the level set equation(s): Phi(n+1) = Phi(n) + dt*R(Phi(n))
   // -------------------------------------------------------------------------------
+  ComputeLevelSetResiduals(V, Phi, Rn_ls, time-dt); //compute Rn_ls (level set)
   for(int i=0; i<(int)Phi.size(); i++) {
-    lso[i]->ComputeResidual(V, *Phi[i], *Rn_ls[i], time-dt); //compute Rn_ls (level set)
     lso[i]->AXPlusBY(1.0, *Phi[i], dt, *Rn_ls[i]); //in case of narrow-band, go over only useful nodes
     lso[i]->ApplyBoundaryConditions(*Phi[i]);
 
@@ -359,19 +430,15 @@ TimeIntegratorRK2::AdvanceOneTimeStep(SpaceVariable3D &V, SpaceVariable3D &ID,
   int clipped = spo.ClipDensityAndPressure(V1, ID);
   if(clipped)
     spo.PrimitiveToConservative(V1, ID, U1); //update U1 after clipping
-
-  // Apply B.C. to the intermediate state (fill ghost cells)
-  spo.ApplyBoundaryConditions(V1); 
   //***************************************************
 
 
   //****************** STEP 1 FOR LS ****************** 
   // Forward Euler step for the level set equation(s): Phi1 = Phi(n) + dt*R(Phi(n))
+  ComputeLevelSetResiduals(V, Phi, Rls, time-dt); //compute R(Phi(n))
   for(int i=0; i<(int)Phi.size(); i++) {
-    lso[i]->ComputeResidual(V, *Phi[i], *Rls[i], time-dt); //compute R(Phi(n))
     lso[i]->AXPlusBY(0.0, *Phi1[i], 1.0, *Phi[i]); //in case of narrow-band, go over only useful nodes
     lso[i]->AXPlusBY(1.0, *Phi1[i], dt, *Rls[i]); //in case of narrow-band, go over only useful nodes
-    lso[i]->ApplyBoundaryConditions(*Phi1[i]);
   }
   //***************************************************
 
@@ -386,12 +453,24 @@ TimeIntegratorRK2::AdvanceOneTimeStep(SpaceVariable3D &V, SpaceVariable3D &ID,
       AddFluxWithLocalTimeStep(*Xi1, 1.0, Dt, *Rxi);
     else
       Xi1->AXPlusBY(1.0, dt, *Rxi); //Xi1 = Xi(n) + dt*R(Xi(n))
-    heo->ApplyBoundaryConditionsToReferenceMap(*Xi1);
   }
   //***************************************************
 
 
 
+  //****************** STEP 1: B.C. ******************
+  // Update the internal ghost layers of V1, Phi1 and Xi1 in one round of communication, then
+  // populate the external ghost layers
+  ExchangeGhostLayers(V1, Phi1, Xi ? Xi1 : NULL);
+  spo.ApplyBoundaryConditions(V1);
+  for(int i=0; i<(int)Phi.size(); i++)
+    lso[i]->ApplyBoundaryConditions(*Phi1[i]);
+  if(Xi)
+    heo->ApplyBoundaryConditionsToReferenceMap(*Xi1);
+  //***************************************************
+
+
+
   //****************** STEP 2 FOR NS ******************
   // Step 2: U(n+1) = 0.5*U(n) + 0.5*U1 + 0.5*dt*R(V1)
   //compute R(V1) using prev.Phi, "loose coupling"
@@ -409,17 +488,15 @@ TimeIntegratorRK2::AdvanceOneTimeStep(SpaceVariable3D &V, SpaceVariable3D &ID,
   
   spo.ConservativeToPrimitive(U1, ID, V); //updates V = V(n+1)
   spo.ClipDensityAndPressure(V, ID);
-  spo.ApplyBoundaryConditions(V);
   //***************************************************
 
 
   //****************** STEP 2 FOR LS ******************
   // Step 2 for the level set equations: Phi(n+1) = 0.5*Phi(n) + 0.5*Phi1 + 0.5*dt*R(Phi1)
+  ComputeLevelSetResiduals(V1, Phi1, Rls, time);
   for(int i=0; i<(int)Phi.size(); i++) {
-    lso[i]->ComputeResidual(V1, *Phi1[i], *Rls[i], time);
     lso[i]->AXPlusBY(0.5, *Phi[i], 0.5, *Phi1[i]); //in case of narrow-band, go over only useful nodes
     lso[i]->AXPlusBY(1.0, *Phi[i], 0.5*dt, *Rls[i]); //in case of narrow-band, go over only useful nodes
-    lso[i]->ApplyBoundaryConditions(*Phi[i]);
   }
   //***************************************************
 
@@ -434,11 +511,22 @@ TimeIntegratorRK2::AdvanceOneTimeStep(SpaceVariable3D &V, SpaceVariable3D &ID,
       AddFluxWithLocalTimeStep(*Xi, 0.5, Dt, *Rxi);
     else
       Xi->AXPlusBY(1.0, 0.5*dt, *Rxi); 
-    heo->ApplyBoundaryConditionsToReferenceMap(*Xi); //pass t(n+1)
   }
   //***************************************************
 
 
+  //****************** STEP 2: B.C. ******************
+  // Update the internal ghost layers of V, Phi and Xi in one round of communication, then
+  // populate the external ghost layers
+  ExchangeGhostLayers(V, Phi, Xi);
+  spo.ApplyBoundaryConditions(V);
+  for(int i=0; i<(int)Phi.size(); i++)
+    lso[i]->ApplyBoundaryConditions(*Phi[i]);
+  if(Xi)
+    heo->ApplyBoundaryConditionsToReferenceMap(*Xi);
+  //***************************************************
+
+
   // Check of convergence (for steady-state computations)
   if(sso)
     sso->MonitorConvergence(R,ID); //Strictly speaking, should recompute R using updated V. But this is OK.
@@ -565,19 +653,15 @@ TimeIntegratorRK3::AdvanceOneTimeStep(SpaceVariable3D &V, SpaceVariable3D &ID,
   int clipped = spo.ClipDensityAndPressure(V1, ID);
   if(clipped)
     spo.PrimitiveToConservative(V1, ID, U1); //update U1 after clipping
-
-  // Apply B.C. to the intermediate state (fill ghost cells)
-  spo.ApplyBoundaryConditions(V1); 
   //***************************************************
 
 
   //****************** STEP 1 FOR LS ******************
   // Forward Euler step for the level set equation(s): Phi1 = Phi(n) + dt*R(Phi(n))
+  ComputeLevelSetResiduals(V, Phi, Rls, time-dt); //compute R(Phi(n))
   for(int i=0; i<(int)Phi.size(); i++) {
-    lso[i]->ComputeResidual(V, *Phi[i], *Rls[i], time-dt); //compute R(Phi(n))
     lso[i]->AXPlusBY(0.0, *Phi1[i], 1.0, *Phi[i]); //in case of narrow-band, go over only useful nodes
     lso[i]->AXPlusBY(1.0, *Phi1[i], dt, *Rls[i]); //in case of narrow-band, go over only useful nodes
-    lso[i]->ApplyBoundaryConditions(*Phi1[i]);
   }
   //***************************************************
 
@@ -592,12 +676,24 @@ TimeIntegratorRK3::AdvanceOneTimeStep(SpaceVariable3D &V, SpaceVariable3D &ID,
       AddFluxWithLocalTimeStep(*Xi1, 1.0, Dt, *Rxi);
     else
       Xi1->AXPlusBY(1.0, dt, *Rxi); //Xi1 = Xi(n) + dt*R(Xi(n))
-    heo->ApplyBoundaryConditionsToReferenceMap(*Xi1);
   }
   //***************************************************
 
 
 
+  //****************** STEP 1: B.C. ******************
+  // Update the internal ghost layers of V1, Phi1 and Xi1 in one round of communication, then
+  // populate the external ghost layers
+  ExchangeGhostLayers(V1, Phi1, Xi ? Xi1 : NULL);
+  spo.ApplyBoundaryConditions(V1);
+  for(int i=0; i<(int)Phi.size(); i++)
+    lso[i]->ApplyBoundaryConditions(*Phi1[i]);
+  if(Xi)
+    heo->ApplyBoundaryConditionsToReferenceMap(*Xi1);
+  //***************************************************
+
+
+
   //****************** STEP 2 FOR NS ******************
   // Step 2: U2 = 0.75*U(n) + 0.25*U1 + 0.25*dt*R(V1))
   //compute R(V1) using prev.Phi, "loose coupling"
@@ -619,19 +715,15 @@ TimeIntegratorRK3::AdvanceOneTimeStep(SpaceVariable3D &V, SpaceVariable3D &ID,
   clipped = spo.ClipDensityAndPressure(V2, ID);
   if(clipped)
     spo.PrimitiveToConservative(V2, ID, U1); //update U2 after clipping
-
-  // Apply B.C. to the intermediate state (fill ghost cells)
-  spo.ApplyBoundaryConditions(V2); //apply B.C. by populating the ghost layer
   //***************************************************
 
 
   //****************** STEP 2 FOR LS ******************
   // Step 2: Phi2 = 0.75*Phi(n) + 0.25*Phi1 + 0.25*dt*R(Phi1)
+  ComputeLevelSetResiduals(V1, Phi1, Rls, time);
   for(int i=0; i<(int)Phi.size(); i++) {
-    lso[i]->ComputeResidual(V1, *Phi1[i], *Rls[i], time);
     lso[i]->AXPlusBY(0.25, *Phi1[i], 0.75, *Phi[i]); //in case of narrow-band, go over only useful nodes
     lso[i]->AXPlusBY(1.0, *Phi1[i], 0.25*dt, *Rls[i]); //in case of narrow-band, go over only useful nodes
-    lso[i]->ApplyBoundaryConditions(*Phi1[i]);
   }
   //***************************************************
 
@@ -646,12 +738,24 @@ TimeIntegratorRK3::AdvanceOneTimeStep(SpaceVariable3D &V, SpaceVariable3D &ID,
       AddFluxWithLocalTimeStep(*Xi1, 0.25, Dt, *Rxi);
     else
       Xi1->AXPlusBY(1.0, 0.25*dt, *Rxi); 
-    heo->ApplyBoundaryConditionsToReferenceMap(*Xi1); //t(n+1)
   }
   //***************************************************
 
 
 
+  //****************** STEP 2: B.C. ******************
+  // Update the internal ghost layers of V2, Phi1 and Xi1 in one round of communication, then
+  // populate the external ghost layers
+  ExchangeGhostLayers(V2, Phi1, Xi ? Xi1 : NULL);
+  spo.ApplyBoundaryConditions(V2);
+  for(int i=0; i<(int)Phi.size(); i++)
+    lso[i]->ApplyBoundaryConditions(*Phi1[i]);
+  if(Xi)
+    heo->ApplyBoundaryConditionsToReferenceMap(*Xi1);
+  //***************************************************
+
+
+
   //****************** STEP 3 FOR NS ******************
   // Step 3: U(n+1) = 1/3*U(n) + 2/3*U2 + 2/3*dt*R(V2)
   //compute R(V2) using prev.Phi,"loose coupling"
@@ -669,17 +773,15 @@ TimeIntegratorRK3::AdvanceOneTimeStep(SpaceVariable3D &V, SpaceVariable3D &ID,
 
   spo.ConservativeToPrimitive(U1, ID, V); //updates V = V(n+1)
   spo.ClipDensityAndPressure(V, ID);
-  spo.ApplyBoundaryConditions(V);
   //***************************************************
 
 
   //****************** STEP 3 FOR LS ******************
   // Step 3: Phi(n+1) = 1/3*Phi(n) + 2/3*Phi2 + 2/3*dt*R(Phi2)
+  ComputeLevelSetResiduals(V2, Phi1, Rls, time-0.5*dt);
   for(int i=0; i<(int)Phi.size(); i++) {
-    lso[i]->ComputeResidual(V2, *Phi1[i], *Rls[i], time-0.5*dt);
     lso[i]->AXPlusBY(1.0/3.0, *Phi[i], 2.0/3.0, *Phi1[i]); //in case of narrow-band, go over only useful nodes
     lso[i]->AXPlusBY(1.0, *Phi[i], 2.0/3.0*dt, *Rls[i]); //in case of narrow-band, go over only useful nodes
-    lso[i]->ApplyBoundaryConditions(*Phi[i]);
   }
   //***************************************************
 
@@ -694,11 +796,22 @@ TimeIntegratorRK3::AdvanceOneTimeStep(SpaceVariable3D &V, SpaceVariable3D &ID,
       AddFluxWithLocalTimeStep(*Xi, 2.0/3.0, Dt, *Rxi);
     else
       Xi->AXPlusBY(1.0, 2.0/3.0*dt, *Rxi); 
-    heo->ApplyBoundaryConditionsToReferenceMap(*Xi); //t(n+1)
   }
   //***************************************************
 
 
+  //****************** STEP 3: B.C. ******************
+  // Update the internal ghost layers of V, Phi and Xi in one round of communication, then
+  // populate the external ghost layers
+  ExchangeGhostLayers(V, Phi, Xi);
+  spo.ApplyBoundaryConditions(V);
+  for(int i=0; i<(int)Phi.size(); i++)
+    lso[i]->ApplyBoundaryConditions(*Phi[i]);
+  if(Xi)
+    heo->ApplyBoundaryConditionsToReferenceMap(*Xi);
+  //***************************************************
+
+
   // Check of convergence (for steady-state computations)
   if(sso)
     sso->MonitorConvergence(R,ID); //Strictly speaking, should recompute R using updated V. But this is OK.
@@ -734,9 +847,15 @@ TimeIntegratorBase::UpdateSolutionAfterTimeStepping(SpaceVariable3D &V, SpaceVar
 
     // Update ID, V, and possibly also Phi (skipped for single-material simulations)
     IDn.AXPlusBY(0.0, 1.0, ID);  //IDn = ID
+    mpo.StartTrackingIDChanges(); //from here, ID is only changed at nodes swept by the interfaces
+
+    // narrow bands (NULL for full-domain level sets). If all are narrow-band, only the bands are checked.
+    vector<vector<Int3>*> bands;
+    for(int i=0; i<(int)lso.size(); i++)
+      bands.push_back(lso[i]->GetPointerToUsefulNodes());
 
     mpo.UpdateMaterialIDByLevelSet(Phi_tmp, Phi, embed ? embed->GetPointerToIntersectors() : nullptr,
-                                   ID); //update mat. id. (including the ghost layer outside the physical domain)
+                                   ID, &bands); //update mat. id. (including the ghost layer outside the physical domain)
 
     // Correct ID and Phi to be consistent with embedded surfaces (to avoid "leaking")
     if(EBDS) {
@@ -781,7 +900,7 @@ TimeIntegratorBase::UpdateSolutionAfterTimeStepping(SpaceVariable3D &V, SpaceVar
         for(int i=0; i<(int)Phi.size(); i++)
           lso[i]->Reinitialize(time, dts, time_step, *Phi[i], 0, true); //will NOT change sign of phi
         mpo.UpdateMaterialIDByLevelSet(Phi_tmp, Phi, embed ? embed->GetPointerToIntersectors() : nullptr,
-                                       ID); //should only update ID of unresolved cells      
+                                       ID, &bands); //should only update ID of unresolved cells      
       }
 
       mpo.FixUnresolvedNodes(unresolved, IDn, ID, V, embed ? embed->GetPointerToIntersectors() : nullptr,
@@ -790,6 +909,7 @@ TimeIntegratorBase::UpdateSolutionAfterTimeStepping(SpaceVariable3D &V, SpaceVar
 
     // add stored latent heat (Lambda) to cells that changed phase due to interface motion
     mpo.AddLambdaToEnthalpyAfterInterfaceMotion(IDn, ID, V);
+    mpo.StopTrackingIDChanges();
 
     spo.ClipDensityAndPressure(V, ID);
     spo.ApplyBoundaryConditions(V);
@@ -15,6 +15,8 @@
 #include <HyperelasticityOperator.h>
 #include <PrescribedMotionOperator.h>
 #include <SteadyStateOperator.h>
+#include <GhostExchangeGroup.h>
+#include <FusedLevelSetAdvector.h>
 using std::vector;
 
 /********************************************************************
@@ -51,6 +53,12 @@ protected:
   //! Internal variable to temporarily store old ID
   SpaceVariable3D IDn;
 
+  //! Exchanges the ghost layers of several variables together (e.g., V, Phi, Xi)
+  GhostExchangeGroup ghost_exchange;
+
+  //! Computes the level set residuals together (NULL if not requested, or not applicable)
+  FusedLevelSetAdvector* fused_ls;
+
   //! Internal variable to temporarily store Phi (e.g., for material ID updates)
   vector<SpaceVariable3D*> Phi_tmp;
 
@@ -101,11 +109,23 @@ public:
   double GetRelativeResidual2Norm() {assert(sso); return sso->GetRelativeResidual2Norm();} //function L2 norm
   double GetRelativeResidualInfNorm() {assert(sso); return sso->GetRelativeResidualInfNorm();}
 
+  //! Checkpoint/restart. The base class stores the state of steady-state analysis (if any). The solution
+  //! vectors (V, ID, Phi, etc.) are handled by RestartHandler.
+  virtual void WriteRestartData(std::ostream &out);
+  virtual void ReadRestartData(std::istream &in);
+
 protected:
 
   //! compute U += a*dt*R, where dt can be different for different cells (for steady-state computation)
   void AddFluxWithLocalTimeStep(SpaceVariable3D &U, double a, SpaceVariable3D *Dt, SpaceVariable3D &R);
 
+  //! update the internal ghost layers of V, Phi, and Xi (if not NULL) in one round of communication
+  void ExchangeGhostLayers(SpaceVariable3D &V, vector<SpaceVariable3D*> &Phi, SpaceVariable3D *Xi);
+
+  //! compute the residuals of all the level set equations (together, if fused_ls is not NULL)
+  void ComputeLevelSetResiduals(SpaceVariable3D &V, vector<SpaceVariable3D*> &Phi,
+                                vector<SpaceVariable3D*> &R, double time);
+
 };
 
 /********************************************************************
@@ -0,0 +1,256 @@
+/************************************************************************
+ * Copyright © 2020 The Multiphysics Modeling and Computation (M2C) Lab
+ * <kevin.wgy@gmail.com> <kevinw3@vt.edu>
+ ************************************************************************/
+
+#include<Timer.h>
+#include<Utils.h>
+#include<algorithm>
+#include<set>
+#include<cstring>
+#ifdef _OPENMP
+#include<omp.h>
+#endif
+using std::string;
+using std::vector;
+
+//---------------------------------------------------------
+
+Timer::Timer() : current(0)
+{
+  nodes.push_back(Node("Total", -1));
+}
+
+//---------------------------------------------------------
+
+int
+Timer::Start(const char* name)
+{
+#ifdef _OPENMP
+  if(omp_in_parallel()) //sections inside threaded loops are not timed (counted in the enclosing section)
+    return -1;
+#endif
+
+  int id = -1;
+  for(auto&& c : nodes[current].children)
+    if(nodes[c].name.compare(name) == 0) {
+      id = c;
+      break;
+    }
+
+  if(id<0) { //first call
+    id = nodes.size();
+    nodes.push_back(Node(name, current));
+    nodes[current].children.push_back(id);
+  }
+
+  current = id;
+  nodes[id].t0 = walltime();
+  return id;
+}
+
+//---------------------------------------------------------
+
+void
+Timer::Stop(int id)
+{
+  if(id<=0 || id>=(int)nodes.size())
+    return;
+
+  Node &node(nodes[id]);
+  node.total += walltime() - node.t0;
+  node.calls++;
+
+  current = node.parent;
+}
+
+//---------------------------------------------------------
+
+void
+Timer::AddCount(const char* name, double n)
+{
+#ifdef _OPENMP
+  if(omp_in_parallel()) {
+#pragma omp critical (m2c_timer_counters)
+    counters[name] += n;
+    return;
+  }
+#endif
+  counters[name] += n;
+}
+
+//---------------------------------------------------------
+
+string
+Timer::GetPath(int id)
+{
+  string path = nodes[id].name;
+  for(int p = nodes[id].parent; p>0; p = nodes[p].parent)
+    path = nodes[p].name + "/" + path;
+  return path;
+}
+
+//---------------------------------------------------------
+
+// Gathers the union of the keys on all the processors. Returned in the same order on all procs.
+static vector<string>
+GatherUnionOfKeys(MPI_Comm &comm, vector<string> &keys)
+{
+  string packed;
+  for(auto&& k : keys)
+    packed += k + '\n';
+
+  int size;
+  MPI_Comm_size(comm, &size);
+  int my_len = packed.size();
+  vector<int> lens(size), displ(size, 0);
+  MPI_Allgather(&my_len, 1, MPI_INT, lens.data(), 1, MPI_INT, comm);
+  for(int i=1; i<size; i++)
+    displ[i] = displ[i-1] + lens[i-1];
+
+  vector<char> all(displ[size-1] + lens[size-1] + 1, '\0');
+  MPI_Allgatherv(packed.data(), my_len, MPI_CHAR, all.data(), lens.data(), displ.data(), MPI_CHAR, comm);
+
+  // sort by path components (so that children follow their parents)
+  std::set<vector<string> > sorted;
+  string line;
+  for(int i=0; i<(int)all.size()-1; i++) {
+    if(all[i] != '\n') {
+      line += all[i];
+      continue;
+    }
+    vector<string> comps;
+    size_t b = 0, e;
+    while((e = line.find('/', b)) != string::npos) {
+      comps.push_back(line.substr(b, e-b));
+      b = e+1;
+    }
+    comps.push_back(line.substr(b));
+    sorted.insert(comps);
+    line.clear();
+  }
+
+  vector<string> result;
+  for(auto&& comps : sorted) {
+    string path = comps[0];
+    for(int i=1; i<(int)comps.size(); i++)
+      path += "/" + comps[i];
+    result.push_back(path);
+  }
+  return result;
+}
+
+//---------------------------------------------------------
+
+void
+Timer::Report(MPI_Comm &comm, double total_time, const char* json_file)
+{
+  int mpi_rank, mpi_size;
+  MPI_Comm_rank(comm, &mpi_rank);
+  MPI_Comm_size(comm, &mpi_size);
+
+  // ---------------------------
+  // Timers
+  // ---------------------------
+  std::map<string, int> my_paths;
+  for(int id=1; id<(int)nodes.size(); id++)
+    my_paths[GetPath(id)] = id;
+  vector<string> keys;
+  for(auto&& mp : my_paths)
+    keys.push_back(mp.first);
+  vector<string> paths = GatherUnionOfKeys(comm, keys);
+
+  int N = paths.size();
+  vector<double> tmin(N+1, 0.0), tmax(N+1, 0.0), tsum(N+1, 0.0), calls(N+1, 0.0);
+  tmin[0] = tmax[0] = tsum[0] = total_time;
+  for(int i=0; i<N; i++) {
+    auto it = my_paths.find(paths[i]);
+    if(it != my_paths.end()) {
+      tmin[i+1] = tmax[i+1] = tsum[i+1] = nodes[it->second].total;
+      calls[i+1] = nodes[it->second].calls;
+    }
+  }
+  MPI_Allreduce(MPI_IN_PLACE, tmin.data(), N+1, MPI_DOUBLE, MPI_MIN, comm);
+  MPI_Allreduce(MPI_IN_PLACE, tmax.data(), N+1, MPI_DOUBLE, MPI_MAX, comm);
+  MPI_Allreduce(MPI_IN_PLACE, tsum.data(), N+1, MPI_DOUBLE, MPI_SUM, comm);
+  MPI_Allreduce(MPI_IN_PLACE, calls.data(), N+1, MPI_DOUBLE, MPI_MAX, comm);
+
+  // ---------------------------
+  // Counters
+  // ---------------------------
+  keys.clear();
+  for(auto&& c : counters)
+    keys.push_back(c.first);
+  vector<string> cnames = GatherUnionOfKeys(comm, keys);
+
+  int M = cnames.size();
+  vector<double> cmin(M, 0.0), cmax(M, 0.0), csum(M, 0.0);
+  for(int i=0; i<M; i++) {
+    auto it = counters.find(cnames[i]);
+    if(it != counters.end())
+      cmin[i] = cmax[i] = csum[i] = it->second;
+  }
+  if(M>0) {
+    MPI_Allreduce(MPI_IN_PLACE, cmin.data(), M, MPI_DOUBLE, MPI_MIN, comm);
+    MPI_Allreduce(MPI_IN_PLACE, cmax.data(), M, MPI_DOUBLE, MPI_MAX, comm);
+    MPI_Allreduce(MPI_IN_PLACE, csum.data(), M, MPI_DOUBLE, MPI_SUM, comm);
+  }
+
+  // ---------------------------
+  // Screen output
+  // ---------------------------
+  print(comm, "- Timing report (wall-clock time in sec., min/avg/max over %d processor(s)):\n", mpi_size);
+  print(comm, "  %-48s %12s %12s %12s %12s %8s\n", "Section", "Calls(max)", "Min", "Avg", "Max", "%Total");
+  double tavg_total = tsum[0]/mpi_size;
+  for(int i=0; i<=N; i++) {
+    string label = i==0 ? string("Total") : paths[i-1];
+    int depth = std::count(label.begin(), label.end(), '/');
+    if(i>0) {
+      depth++;
+      label = label.substr(label.rfind('/')+1); //works also if '/' is not found
+    }
+    label = string(2*depth, ' ') + label;
+    double tavg = tsum[i]/mpi_size;
+    print(comm, "  %-48s %12.0f %12.4e %12.4e %12.4e %7.2f%%\n", label.c_str(), i==0 ? 1.0 : calls[i],
+          tmin[i], tavg, tmax[i], tavg_total>0 ? 100.0*tavg/tavg_total : 0.0);
+  }
+  if(M>0) {
+    print(comm, "  %-48s %12s %12s %12s %12s\n", "Counter", "Sum", "Min", "Avg", "Max");
+    for(int i=0; i<M; i++)
+      print(comm, "  %-48s %12.4e %12.4e %12.4e %12.4e\n", cnames[i].c_str(), csum[i], cmin[i],
+            csum[i]/mpi_size, cmax[i]);
+  }
+  print(comm, "\n");
+
+  // ---------------------------
+  // JSON file
+  // ---------------------------
+  if(!json_file || !strcmp(json_file, "") || mpi_rank != 0)
+    return;
+
+  FILE* file = fopen(json_file, "w");
+  if(!file) {
+    print_warning(comm, "Warning: Unable to open file %s for the timing report.\n", json_file);
+    return;
+  }
+
+  fprintf(file, "{\n");
+  fprintf(file, "  \"num_processors\": %d,\n", mpi_size);
+  fprintf(file, "  \"timers\": [\n");
+  for(int i=0; i<=N; i++) {
+    string path = i==0 ? string("Total") : paths[i-1];
+    fprintf(file, "    {\"path\": \"%s\", \"calls\": %.0f, \"min\": %.6e, \"avg\": %.6e, \"max\": %.6e}%s\n",
+            path.c_str(), i==0 ? 1.0 : calls[i], tmin[i], tsum[i]/mpi_size, tmax[i], i<N ? "," : "");
+  }
+  fprintf(file, "  ],\n");
+  fprintf(file, "  \"counters\": [\n");
+  for(int i=0; i<M; i++)
+    fprintf(file, "    {\"name\": \"%s\", \"sum\": %.6e, \"min\": %.6e, \"avg\": %.6e, \"max\": %.6e}%s\n",
+            cnames[i].c_str(), csum[i], cmin[i], csum[i]/mpi_size, cmax[i], i<M-1 ? "," : "");
+  fprintf(file, "  ]\n");
+  fprintf(file, "}\n");
+
+  fclose(file);
+}
+
+//---------------------------------------------------------
@@ -0,0 +1,81 @@
+/************************************************************************
+ * Copyright © 2020 The Multiphysics Modeling and Computation (M2C) Lab
+ * <kevin.wgy@gmail.com> <kevinw3@vt.edu>
+ ************************************************************************/
+
+#ifndef _TIMER_H_
+#define _TIMER_H_
+
+#include<mpi.h>
+#include<vector>
+#include<string>
+#include<map>
+
+/*********************************************************************
+ * class Timer measures the wall-clock time spent in (nested) sections
+ * of the code, and counts user-defined events. Sections are organized
+ * as a tree following the call stack: a section started while another
+ * one is running becomes its child (e.g., "TimeStep/ComputeResidual/
+ * Reconstruct"). At the end of a run, Report(...) gathers the results
+ * from all the processors, prints the min/avg/max to the screen, and
+ * (optionally) writes a JSON file.
+ * Notes:
+ *   - Sections are meant to be coarse-grained (a few per function call);
+ *     the overhead of Start/Stop is a call to MPI_Wtime and a search
+ *     among the children of the running section.
+ *   - Usually accessed through ScopedTimer and the global object m2c_timer.
+ *   - With OpenMP, sections started within a parallel region are ignored,
+ *     i.e. their time is included in the enclosing (serial) section.
+ *********************************************************************
+*/
+
+class Timer
+{
+  struct Node {
+    std::string name;
+    int parent;
+    std::vector<int> children;
+    double total; //!< accumulated time (sec.)
+    long long calls;
+    double t0; //!< start time of the current call
+    Node(const char* name_, int parent_) : name(name_), parent(parent_), total(0.0), calls(0), t0(0.0) {}
+  };
+
+  std::vector<Node> nodes; //!< nodes[0] is the root (i.e. the entire run)
+  int current; //!< the section that is running
+
+  std::map<std::string, double> counters;
+
+public:
+
+  Timer();
+  ~Timer() {}
+
+  int Start(const char* name); //!< returns an id to be passed to Stop
+  void Stop(int id);
+
+  void AddCount(const char* name, double n = 1.0);
+
+  //! Collective. Prints a summary and writes "json_file" (if not NULL or empty) from proc #0
+  void Report(MPI_Comm &comm, double total_time, const char* json_file = NULL);
+
+private:
+
+  std::string GetPath(int id);
+
+};
+
+//! The global timer (defined in Main.cpp)
+extern Timer m2c_timer;
+
+//! Times the lifetime of the object (i.e. till the end of the scope)
+class ScopedTimer
+{
+  Timer &timer;
+  int id;
+public:
+  ScopedTimer(const char* name, Timer &timer_ = m2c_timer) : timer(timer_), id(timer_.Start(name)) {}
+  ~ScopedTimer() {timer.Stop(id);}
+};
+
+#endif
@@ -11,6 +11,9 @@
 #include <mpi.h>
 #include <cctype>
 #include <cassert>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using std::string;
 
@@ -57,6 +60,24 @@ void exit_mpi();
 bool isTimeToWrite(double time, double dt, int time_step, double frequency_dt, int frequency,
                    double last_snapshot_time, bool force_write);
 //--------------------------------------------------
+//! Multi-threading (OpenMP) within each MPI process. Without OpenMP, each process has one thread.
+inline int get_max_threads()
+{
+#ifdef _OPENMP
+  return omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
+inline int get_thread_num()
+{
+#ifdef _OPENMP
+  return omp_get_thread_num();
+#else
+  return 0;
+#endif
+}
+//--------------------------------------------------
 //! case-insensitive string compare (true: equal;  false: unequal)
 inline bool same_strings_insensitive(std::string str1, std::string str2)
 {
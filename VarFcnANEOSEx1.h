@@ -11,6 +11,9 @@
 #include<tuple>
 #include<boost/math/tools/roots.hpp>
 #include<boost/math/interpolators/cubic_b_spline.hpp>  //spline interpolation
+#ifdef _OPENMP
+#include<omp.h>
+#endif
 
 extern double avogadro_number;
 
@@ -132,8 +135,19 @@ private:
   //! build spline interpolation for Debye function D(x)
   void InitializeInterpolationForDebyeFunction(double expmx_min, double expmx_max, int sample_size);
 
+  //! The storage of calculated values is shared. It is not used within multi-threaded loops
+  bool UseStorage() {
+#ifdef _OPENMP
+    return !omp_in_parallel();
+#else
+    return true;
+#endif
+  }
+
   //! Update rho_e_T
   void Update_rho_e_T(double rho, double e, double T) {
+    if(!UseStorage())
+      return;
     for(int i=0; i<(int)rho_e_T.size()-1; i++)
       rho_e_T[i] = rho_e_T[i+1];
     rho_e_T.back() = std::make_tuple(rho,e,T);
@@ -141,6 +155,8 @@ private:
 
   //! Update rho_e_p_T
   void Update_rho_e_p_T(double rho, double e, double p, double T) {
+    if(!UseStorage())
+      return;
     for(int i=0; i<(int)rho_e_p_T.size()-1; i++)
       rho_e_p_T[i] = rho_e_p_T[i+1];
     rho_e_p_T.back() = std::make_tuple(rho,e,p,T);
@@ -293,9 +309,10 @@ VarFcnANEOSEx1::GetInternalEnergyPerUnitMass(double rho, double p)
 {
 
   // Check storage
-  for(auto&& mytuple : rho_e_p_T)
-    if(std::get<0>(mytuple) == rho && std::get<2>(mytuple) == p)
-      return std::get<1>(mytuple);
+  if(UseStorage())
+    for(auto&& mytuple : rho_e_p_T)
+      if(std::get<0>(mytuple) == rho && std::get<2>(mytuple) == p)
+        return std::get<1>(mytuple);
 
   // -------------------------------------------------------------------------------
   // solve a nonlinear equation (p(rho,T)/(rho*rho) - e_cold'(rho) - dF_l(rho,T)/drho = 0) to find T
@@ -349,9 +366,10 @@ VarFcnANEOSEx1::GetDensity(double p, double e)
 {
 
   // Check storage
-  for(auto&& mytuple : rho_e_p_T)
-    if(std::get<1>(mytuple) == e && std::get<2>(mytuple) == p)
-      return std::get<0>(mytuple);
+  if(UseStorage())
+    for(auto&& mytuple : rho_e_p_T)
+      if(std::get<1>(mytuple) == e && std::get<2>(mytuple) == p)
+        return std::get<0>(mytuple);
   
   //TODO: This function is not really needed at the moment. Therefore, it is not implemented
 
@@ -367,12 +385,14 @@ VarFcnANEOSEx1::GetTemperature(double rho, double e)
 {
   
   // Check storage
-  for(auto&& mytuple : rho_e_T)
-    if(std::get<0>(mytuple) == rho && std::get<1>(mytuple) == e)
-      return std::get<2>(mytuple);
-  for(auto&& mytuple : rho_e_p_T)
-    if(std::get<0>(mytuple) == rho && std::get<1>(mytuple) == e)
-      return std::get<3>(mytuple);
+  if(UseStorage())
+    for(auto&& mytuple : rho_e_T)
+      if(std::get<0>(mytuple) == rho && std::get<1>(mytuple) == e)
+        return std::get<2>(mytuple);
+  if(UseStorage())
+    for(auto&& mytuple : rho_e_p_T)
+      if(std::get<0>(mytuple) == rho && std::get<1>(mytuple) == e)
+        return std::get<3>(mytuple);
 
   // -------------------------------
   // solve a nonlinear equation (e - e_cold(rho) - delta_e - el(rho,T) = 0) to find T
@@ -437,12 +457,14 @@ VarFcnANEOSEx1::GetInternalEnergyPerUnitMassFromTemperature(double rho, double T
 {
 
   // Check storage
-  for(auto&& mytuple : rho_e_T)
-    if(std::get<0>(mytuple) == rho && std::get<2>(mytuple) == T)
-      return std::get<1>(mytuple);
-  for(auto&& mytuple : rho_e_p_T)
-    if(std::get<0>(mytuple) == rho && std::get<3>(mytuple) == T)
-      return std::get<1>(mytuple);
+  if(UseStorage())
+    for(auto&& mytuple : rho_e_T)
+      if(std::get<0>(mytuple) == rho && std::get<2>(mytuple) == T)
+        return std::get<1>(mytuple);
+  if(UseStorage())
+    for(auto&& mytuple : rho_e_p_T)
+      if(std::get<0>(mytuple) == rho && std::get<3>(mytuple) == T)
+        return std::get<1>(mytuple);
 
   // Computation
   double e = ComputeColdSpecificEnergy(rho) + ComputeThermalSpecificEnergy(rho,T) + delta_e;
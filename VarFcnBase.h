@@ -159,6 +159,18 @@ public:
   virtual void ConservativeToPrimitive(double *U, double *V); 
   virtual void PrimitiveToConservative(double *V, double *U);
 
+  //----- Batched EOS Evaluations -----//
+  //! Evaluate the EOS for n states stored in contiguous arrays, with one virtual call per batch.
+  //! The default implementations call the point-wise functions. EOS with closed-form expressions
+  //! override them with loops that can be inlined and vectorized. Outputs must not overlap inputs.
+  virtual void GetPressureBatch(int n, const double *rho, const double *e, double *p);
+  virtual void GetInternalEnergyPerUnitMassBatch(int n, const double *rho, const double *p, double *e);
+  virtual void ComputeSoundSpeedSquareBatch(int n, const double *rho, const double *e, double *c2);
+  virtual void GetDpdrhoBatch(int n, const double *rho, const double *e, double *dpdrho);
+  virtual void GetBigGammaBatch(int n, const double *rho, const double *e, double *Gamma);
+  //! Same as CheckState(rho[i], p[i], silence), i = 0, ..., n-1. Returns the number of states that fail the check.
+  virtual int CheckStateBatch(int n, const double *rho, const double *p, bool silence = false);
+
   //----- General Functions -----//
   inline int GetType() const{ return type; }
 
@@ -207,6 +219,62 @@ void VarFcnBase::PrimitiveToConservative(double *V, double *U)
 
 //------------------------------------------------------------------------------
 
+inline
+void VarFcnBase::GetPressureBatch(int n, const double *rho, const double *e, double *p)
+{
+  for(int i=0; i<n; i++)
+    p[i] = GetPressure(rho[i], e[i]);
+}
+
+//------------------------------------------------------------------------------
+
+inline
+void VarFcnBase::GetInternalEnergyPerUnitMassBatch(int n, const double *rho, const double *p, double *e)
+{
+  for(int i=0; i<n; i++)
+    e[i] = GetInternalEnergyPerUnitMass(rho[i], p[i]);
+}
+
+//------------------------------------------------------------------------------
+
+inline
+void VarFcnBase::ComputeSoundSpeedSquareBatch(int n, const double *rho, const double *e, double *c2)
+{
+  for(int i=0; i<n; i++)
+    c2[i] = ComputeSoundSpeedSquare(rho[i], e[i]);
+}
+
+//------------------------------------------------------------------------------
+
+inline
+void VarFcnBase::GetDpdrhoBatch(int n, const double *rho, const double *e, double *dpdrho)
+{
+  for(int i=0; i<n; i++)
+    dpdrho[i] = GetDpdrho(rho[i], e[i]);
+}
+
+//------------------------------------------------------------------------------
+
+inline
+void VarFcnBase::GetBigGammaBatch(int n, const double *rho, const double *e, double *Gamma)
+{
+  for(int i=0; i<n; i++)
+    Gamma[i] = GetBigGamma(rho[i], e[i]);
+}
+
+//------------------------------------------------------------------------------
+
+inline
+int VarFcnBase::CheckStateBatch(int n, const double *rho, const double *p, bool silence)
+{
+  int nbad = 0;
+  for(int i=0; i<n; i++)
+    nbad += (int)CheckState(rho[i], p[i], silence);
+  return nbad;
+}
+
+//------------------------------------------------------------------------------
+
 inline
 double VarFcnBase::ComputeSoundSpeed(double rho, double e)
 {
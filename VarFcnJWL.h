@@ -53,6 +53,27 @@ public:
   inline double GetBigGamma([[maybe_unused]] double rho, [[maybe_unused]] double e) {return omega;}
   inline double GetTemperature([[maybe_unused]] double rho, [[maybe_unused]] double e) {return 0.0;} //TODO
 
+  //! ----- Batched versions (non-virtual calls, vectorizable) -----
+  void GetPressureBatch(int n, const double *rho, const double *e, double *p) {
+    for(int i=0; i<n; i++) p[i] = VarFcnJWL::GetPressure(rho[i], e[i]);}
+  void GetInternalEnergyPerUnitMassBatch(int n, const double *rho, const double *p, double *e) {
+    for(int i=0; i<n; i++) e[i] = VarFcnJWL::GetInternalEnergyPerUnitMass(rho[i], p[i]);}
+  void ComputeSoundSpeedSquareBatch(int n, const double *rho, const double *e, double *c2) {
+    for(int i=0; i<n; i++) c2[i] = VarFcnJWL::GetDpdrho(rho[i], e[i]) + omega*VarFcnJWL::GetPressure(rho[i], e[i])/rho[i];}
+  void GetDpdrhoBatch(int n, const double *rho, const double *e, double *dpdrho) {
+    for(int i=0; i<n; i++) dpdrho[i] = VarFcnJWL::GetDpdrho(rho[i], e[i]);}
+  void GetBigGammaBatch(int n, const double *rho, const double *e, double *Gamma) {
+    for(int i=0; i<n; i++) Gamma[i] = VarFcnJWL::GetBigGamma(rho[i], e[i]);}
+  int CheckStateBatch(int n, const double *rho, const double *p, bool silence = false) {
+    int nbad = 0;
+    for(int i=0; i<n; i++) {
+      double e  = VarFcnJWL::GetInternalEnergyPerUnitMass(rho[i], p[i]);
+      double c2 = VarFcnJWL::GetDpdrho(rho[i], e) + p[i]/rho[i]*VarFcnJWL::GetBigGamma(rho[i], e);
+      if(!(std::isfinite(rho[i]) && std::isfinite(p[i]) && rho[i]>0.0 && c2>0.0)) //rare. (prints the message)
+        nbad += (int)VarFcnBase::CheckState(rho[i], p[i], silence);
+    }
+    return nbad;}
+
 protected:
   inline double Fun(double rho) {
     return  A1*(1.0-omega_over_R1rho0*rho)*exp(-R1rho0/rho) 
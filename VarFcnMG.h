@@ -86,6 +86,28 @@ public:
 
   inline double GetBigGamma(double rho, [[maybe_unused]] double e) {return Gamma0_rho0/rho;}
 
+  //! ----- Batched versions (non-virtual calls, vectorizable) -----
+  void GetPressureBatch(int n, const double *rho, const double *e, double *p) {
+    for(int i=0; i<n; i++) p[i] = VarFcnMG::GetPressure(rho[i], e[i]);}
+  void GetInternalEnergyPerUnitMassBatch(int n, const double *rho, const double *p, double *e) {
+    for(int i=0; i<n; i++) e[i] = VarFcnMG::GetInternalEnergyPerUnitMass(rho[i], p[i]);}
+  void ComputeSoundSpeedSquareBatch(int n, const double *rho, const double *e, double *c2) {
+    for(int i=0; i<n; i++) c2[i] = VarFcnMG::GetDpdrho(rho[i], e[i])
+                                      + VarFcnMG::GetPressure(rho[i], e[i])/rho[i]*VarFcnMG::GetBigGamma(rho[i], e[i]);}
+  void GetDpdrhoBatch(int n, const double *rho, const double *e, double *dpdrho) {
+    for(int i=0; i<n; i++) dpdrho[i] = VarFcnMG::GetDpdrho(rho[i], e[i]);}
+  void GetBigGammaBatch(int n, const double *rho, const double *e, double *Gamma) {
+    for(int i=0; i<n; i++) Gamma[i] = VarFcnMG::GetBigGamma(rho[i], e[i]);}
+  int CheckStateBatch(int n, const double *rho, const double *p, bool silence = false) {
+    int nbad = 0;
+    for(int i=0; i<n; i++) {
+      double e  = VarFcnMG::GetInternalEnergyPerUnitMass(rho[i], p[i]);
+      double c2 = VarFcnMG::GetDpdrho(rho[i], e) + p[i]/rho[i]*VarFcnMG::GetBigGamma(rho[i], e);
+      if(!(std::isfinite(rho[i]) && std::isfinite(p[i]) && rho[i]>0.0 && c2>0.0)) //rare. (prints the message)
+        nbad += (int)VarFcnBase::CheckState(rho[i], p[i], silence);
+    }
+    return nbad;}
+
   double GetTemperature(double rho, double e);
 
   inline double GetReferenceTemperature() {return T0;}
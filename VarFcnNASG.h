@@ -58,6 +58,23 @@ public:
   inline double GetDpdrho(double rho, double e) {double V = 1.0/rho; return gam1*V*V*(e-q)/((V-b)*(V-b));}
   inline double GetBigGamma(double rho, [[maybe_unused]] double e) {return gam1/(1.0 - b*rho);}
 
+  //! ----- Batched versions (non-virtual calls, vectorizable) -----
+  void GetPressureBatch(int n, const double *rho, const double *e, double *p) {
+    for(int i=0; i<n; i++) p[i] = VarFcnNASG::GetPressure(rho[i], e[i]);}
+  void GetInternalEnergyPerUnitMassBatch(int n, const double *rho, const double *p, double *e) {
+    for(int i=0; i<n; i++) e[i] = VarFcnNASG::GetInternalEnergyPerUnitMass(rho[i], p[i]);}
+  void ComputeSoundSpeedSquareBatch(int n, const double *rho, const double *e, double *c2) {
+    for(int i=0; i<n; i++) c2[i] = VarFcnNASG::GetDpdrho(rho[i], e[i])
+                                      + VarFcnNASG::GetPressure(rho[i], e[i])/rho[i]*VarFcnNASG::GetBigGamma(rho[i], e[i]);}
+  void GetDpdrhoBatch(int n, const double *rho, const double *e, double *dpdrho) {
+    for(int i=0; i<n; i++) dpdrho[i] = VarFcnNASG::GetDpdrho(rho[i], e[i]);}
+  void GetBigGammaBatch(int n, const double *rho, const double *e, double *Gamma) {
+    for(int i=0; i<n; i++) Gamma[i] = VarFcnNASG::GetBigGamma(rho[i], e[i]);}
+  int CheckStateBatch(int n, const double *rho, const double *p, bool silence = false) {
+    int nbad = 0;
+    for(int i=0; i<n; i++) nbad += (int)VarFcnNASG::CheckState(rho[i], p[i], silence);
+    return nbad;}
+
   inline double GetTemperature(double rho, double e) {double V = 1.0/rho; return invcv*(V-b)*((e - q)/(V-b) - pc - pc*pow((bigC/(V-b)),gam)/gam1);}
 
   inline double GetReferenceTemperature() {return 0.0;}
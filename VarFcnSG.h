@@ -67,6 +67,22 @@ public:
   inline double GetDpdrho([[maybe_unused]] double rho, double e) {return gam1*e;}
   inline double GetBigGamma([[maybe_unused]] double rho, [[maybe_unused]] double e) {return gam1;}
 
+  //! ----- Batched versions (non-virtual calls, vectorizable) -----
+  void GetPressureBatch(int n, const double *rho, const double *e, double *p) {
+    for(int i=0; i<n; i++) p[i] = VarFcnSG::GetPressure(rho[i], e[i]);}
+  void GetInternalEnergyPerUnitMassBatch(int n, const double *rho, const double *p, double *e) {
+    for(int i=0; i<n; i++) e[i] = VarFcnSG::GetInternalEnergyPerUnitMass(rho[i], p[i]);}
+  void ComputeSoundSpeedSquareBatch(int n, const double *rho, const double *e, double *c2) {
+    for(int i=0; i<n; i++) c2[i] = gam1*(e[i] + VarFcnSG::GetPressure(rho[i], e[i])/rho[i]);}
+  void GetDpdrhoBatch(int n, [[maybe_unused]] const double *rho, const double *e, double *dpdrho) {
+    for(int i=0; i<n; i++) dpdrho[i] = gam1*e[i];}
+  void GetBigGammaBatch(int n, [[maybe_unused]] const double *rho, [[maybe_unused]] const double *e, double *Gamma) {
+    for(int i=0; i<n; i++) Gamma[i] = gam1;}
+  int CheckStateBatch(int n, const double *rho, const double *p, bool silence = false) {
+    int nbad = 0;
+    for(int i=0; i<n; i++) nbad += (int)VarFcnSG::CheckState(rho[i], p[i], silence);
+    return nbad;}
+
   inline double GetTemperature(double rho, double e) {
     if(use_cv_advanced) { //Method 3
       return invcv*(e + Pstiff/rho) + pow(rho/rho0, gam1)*(T0 - invcv*(e0 + Pstiff/rho0));
@@ -0,0 +1,222 @@
+/************************************************************************
+ * Copyright © 2020 The Multiphysics Modeling and Computation (M2C) Lab
+ * <kevin.wgy@gmail.com> <kevinw3@vt.edu>
+ ************************************************************************/
+
+#ifndef _VAR_FCN_TABULATED_H_
+#define _VAR_FCN_TABULATED_H_
+
+#include <VarFcnBase.h>
+#include <Utils.h> //tabulate2Dfunction_uniform
+#include <vector>
+
+/********************************************************************************
+ * This class wraps an "exact" VarFcn (e.g., Tillotson, ANEOS, JWL), and replaces
+ * its (often expensive) functions by look-ups in tables that are generated at
+ * the beginning of the simulation on a uniform (rho, e) grid.
+ *   - p, dp/drho, Gamma (i.e. BigGamma), and T are interpolated bilinearly.
+ *   - e(rho,p) and rho(p,e) are obtained by inverting the bilinear interpolant of
+ *     p (binary search + a linear solve), so that p(rho, e(rho,p)) = p holds up
+ *     to round-off. This requires p to be strictly increasing in e (resp. rho)
+ *     along the grid lines involved; otherwise the exact function is called.
+ *   - Outside the table, and for functions that are not tabulated (e.g., e(rho,T)),
+ *     the exact VarFcn is called.
+ * The exact VarFcn is owned (and deleted) by this object.
+ * Memory: 4*Nrho*Ne doubles.
+ ********************************************************************************/
+class VarFcnTabulated : public VarFcnBase {
+
+private:
+  VarFcnBase *vf; //!< the exact EOS
+
+  double rho0, rhomax_tab, drho, invdrho;
+  double e0, emax_tab, de, invde;
+  int Nrho, Ne;
+
+  //! nodal values. f[j*Nrho+i] corresponds to (rho0 + i*drho, e0 + j*de)
+  std::vector<double> P, Dpdrho, Gamma, T;
+
+  std::vector<bool> p_increases_with_e;   //!< for each i, whether p(rho_i, e) is strictly increasing in e
+  std::vector<bool> p_increases_with_rho; //!< for each j, whether p(rho, e_j) is strictly increasing in rho
+
+public:
+  VarFcnTabulated(MaterialModelData &data, VarFcnBase *vf_exact);
+  ~VarFcnTabulated() {delete vf;}
+
+  //! ----- EOS-Specific Functions -----
+  inline double GetPressure(double rho, double e) {
+    int i, j; double xi, eta;
+    return Locate(rho, e, i, j, xi, eta) ? Interpolate(P, i, j, xi, eta) : vf->GetPressure(rho, e);}
+
+  inline double GetDpdrho(double rho, double e) {
+    int i, j; double xi, eta;
+    return Locate(rho, e, i, j, xi, eta) ? Interpolate(Dpdrho, i, j, xi, eta) : vf->GetDpdrho(rho, e);}
+
+  inline double GetBigGamma(double rho, double e) {
+    int i, j; double xi, eta;
+    return Locate(rho, e, i, j, xi, eta) ? Interpolate(Gamma, i, j, xi, eta) : vf->GetBigGamma(rho, e);}
+
+  inline double GetTemperature(double rho, double e) {
+    int i, j; double xi, eta;
+    return Locate(rho, e, i, j, xi, eta) ? Interpolate(T, i, j, xi, eta) : vf->GetTemperature(rho, e);}
+
+  double GetInternalEnergyPerUnitMass(double rho, double p);
+  double GetDensity(double p, double e);
+
+  //! not tabulated
+  inline double GetReferencePressure() {return vf->GetReferencePressure();}
+  inline double GetReferenceTemperature() {return vf->GetReferenceTemperature();}
+  inline double GetReferenceInternalEnergyPerUnitMass() {return vf->GetReferenceInternalEnergyPerUnitMass();}
+  inline double GetInternalEnergyPerUnitMassFromTemperature(double rho, double T_) {
+    return vf->GetInternalEnergyPerUnitMassFromTemperature(rho, T_);}
+  inline double GetInternalEnergyPerUnitMassFromEnthalpy(double rho, double h) {
+    return vf->GetInternalEnergyPerUnitMassFromEnthalpy(rho, h);}
+  inline bool CheckPhaseTransition(int id) {return vf->CheckPhaseTransition(id);}
+  inline bool CheckState(double rho, double p, bool silence = false) {return vf->CheckState(rho, p, silence);}
+  inline bool CheckState(double *V, bool silence = false) {return vf->CheckState(V, silence);}
+  inline bool ClipDensityAndPressure(double *V, double *U = 0) {return vf->ClipDensityAndPressure(V, U);}
+
+  //! ----- Batched versions (non-virtual calls) -----
+  void GetPressureBatch(int n, const double *rho, const double *e, double *p) {
+    for(int i=0; i<n; i++) p[i] = VarFcnTabulated::GetPressure(rho[i], e[i]);}
+  void GetInternalEnergyPerUnitMassBatch(int n, const double *rho, const double *p, double *e) {
+    for(int i=0; i<n; i++) e[i] = VarFcnTabulated::GetInternalEnergyPerUnitMass(rho[i], p[i]);}
+  void ComputeSoundSpeedSquareBatch(int n, const double *rho, const double *e, double *c2) {
+    for(int i=0; i<n; i++) c2[i] = VarFcnTabulated::GetDpdrho(rho[i], e[i])
+                                   + VarFcnTabulated::GetPressure(rho[i], e[i])/rho[i]*VarFcnTabulated::GetBigGamma(rho[i], e[i]);}
+  void GetDpdrhoBatch(int n, const double *rho, const double *e, double *dpdrho) {
+    for(int i=0; i<n; i++) dpdrho[i] = VarFcnTabulated::GetDpdrho(rho[i], e[i]);}
+  void GetBigGammaBatch(int n, const double *rho, const double *e, double *Gamma) {
+    for(int i=0; i<n; i++) Gamma[i] = VarFcnTabulated::GetBigGamma(rho[i], e[i]);}
+  int CheckStateBatch(int n, const double *rho, const double *p, bool silence = false) {
+    return vf->CheckStateBatch(n, rho, p, silence);}
+
+private:
+
+  //! Finds the cell containing (rho,e) and the local coordinates (xi,eta) in [0,1]. Returns false if
+  //! (rho,e) is outside the table (or not a number).
+  inline bool Locate(double rho, double e, int &i, int &j, double &xi, double &eta) {
+    double x = (rho - rho0)*invdrho, y = (e - e0)*invde;
+    if(!(x>=0.0 && x<=Nrho-1 && y>=0.0 && y<=Ne-1))
+      return false;
+    i = std::min((int)x, Nrho-2);  xi  = x - i;
+    j = std::min((int)y, Ne-2);    eta = y - j;
+    return true;
+  }
+
+  inline double Interpolate(std::vector<double> &f, int i, int j, double xi, double eta) {
+    double *f0 = &f[j*Nrho+i], *f1 = f0 + Nrho;
+    return (1.0-eta)*((1.0-xi)*f0[0] + xi*f0[1]) + eta*((1.0-xi)*f1[0] + xi*f1[1]);
+  }
+
+};
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+inline
+VarFcnTabulated::VarFcnTabulated(MaterialModelData &data, VarFcnBase *vf_exact)
+               : VarFcnBase(data), vf(vf_exact)
+{
+  type = vf->type; //behaves like the exact EOS
+
+  EOSRuntimeTableData &tab(data.eos_table);
+  if(tab.Nrho<2 || tab.Ne<2 || tab.rho0<=0.0 || tab.rhomax<=tab.rho0 || tab.emax<=tab.e0) {
+    fprintf(stdout, "*** Error: Detected invalid range or size of the EOS table for material %d: "
+            "rho in [%e, %e] (%d points), e in [%e, %e] (%d points).\n", data.id,
+            tab.rho0, tab.rhomax, tab.Nrho, tab.e0, tab.emax, tab.Ne);
+    exit(-1);
+  }
+
+  rho0 = tab.rho0;   rhomax_tab = tab.rhomax;  Nrho = tab.Nrho;
+  e0   = tab.e0;     emax_tab   = tab.emax;    Ne   = tab.Ne;
+  drho = (rhomax_tab - rho0)/(Nrho - 1);  invdrho = 1.0/drho;
+  de   = (emax_tab - e0)/(Ne - 1);        invde   = 1.0/de;
+
+  // generate the tables (same tool as EOSAnalyzer)
+  std::vector<std::vector<double> > result;
+  auto tabulate = [&](auto fun, std::vector<double> &f) {
+    tabulate2Dfunction_uniform(fun, rho0, rhomax_tab, Nrho, e0, emax_tab, Ne, result);
+    f.resize(Nrho*Ne);
+    for(int j=0; j<Ne; j++)
+      for(int i=0; i<Nrho; i++)
+        f[j*Nrho+i] = result[j][i];
+  };
+  tabulate([&](double rho, double e) {return vf->GetPressure(rho,e);}, P);
+  tabulate([&](double rho, double e) {return vf->GetDpdrho(rho,e);}, Dpdrho);
+  tabulate([&](double rho, double e) {return vf->GetBigGamma(rho,e);}, Gamma);
+  tabulate([&](double rho, double e) {return vf->GetTemperature(rho,e);}, T);
+
+  // check monotonicity (needed for inverting p)
+  p_increases_with_e.assign(Nrho, true);
+  p_increases_with_rho.assign(Ne, true);
+  for(int j=0; j<Ne; j++)
+    for(int i=0; i<Nrho; i++) {
+      if(j<Ne-1 && !(P[(j+1)*Nrho+i] > P[j*Nrho+i]))
+        p_increases_with_e[i] = false;
+      if(i<Nrho-1 && !(P[j*Nrho+i+1] > P[j*Nrho+i]))
+        p_increases_with_rho[j] = false;
+    }
+}
+
+//------------------------------------------------------------------------------
+
+inline double
+VarFcnTabulated::GetInternalEnergyPerUnitMass(double rho, double p)
+{
+  double x = (rho - rho0)*invdrho;
+  if(!(x>=0.0 && x<=Nrho-1))
+    return vf->GetInternalEnergyPerUnitMass(rho, p);
+  int i = std::min((int)x, Nrho-2);
+  double xi = x - i;
+  if(!p_increases_with_e[i] || !p_increases_with_e[i+1])
+    return vf->GetInternalEnergyPerUnitMass(rho, p);
+
+  // q(j) = interpolated p at (rho, e_j), strictly increasing in j
+  auto q = [&](int j) {return (1.0-xi)*P[j*Nrho+i] + xi*P[j*Nrho+i+1];};
+  double qlo = q(0), qhi = q(Ne-1);
+  if(!(p>=qlo && p<=qhi))
+    return vf->GetInternalEnergyPerUnitMass(rho, p);
+
+  int lo = 0, hi = Ne-1;
+  while(hi-lo>1) {
+    int mid = (lo+hi)/2;
+    double qmid = q(mid);
+    if(qmid<=p) {lo = mid; qlo = qmid;}
+    else        {hi = mid; qhi = qmid;}
+  }
+  return e0 + (lo + (p-qlo)/(qhi-qlo))*de;
+}
+
+//------------------------------------------------------------------------------
+
+inline double
+VarFcnTabulated::GetDensity(double p, double e)
+{
+  double y = (e - e0)*invde;
+  if(!(y>=0.0 && y<=Ne-1))
+    return vf->GetDensity(p, e);
+  int j = std::min((int)y, Ne-2);
+  double eta = y - j;
+  if(!p_increases_with_rho[j] || !p_increases_with_rho[j+1])
+    return vf->GetDensity(p, e);
+
+  // q(i) = interpolated p at (rho_i, e), strictly increasing in i
+  auto q = [&](int i) {return (1.0-eta)*P[j*Nrho+i] + eta*P[(j+1)*Nrho+i];};
+  double qlo = q(0), qhi = q(Nrho-1);
+  if(!(p>=qlo && p<=qhi))
+    return vf->GetDensity(p, e);
+
+  int lo = 0, hi = Nrho-1;
+  while(hi-lo>1) {
+    int mid = (lo+hi)/2;
+    double qmid = q(mid);
+    if(qmid<=p) {lo = mid; qlo = qmid;}
+    else        {hi = mid; qhi = qmid;}
+  }
+  return rho0 + (lo + (p-qlo)/(qhi-qlo))*drho;
+}
+
+//------------------------------------------------------------------------------
+
+#endif
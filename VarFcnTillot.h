@@ -12,6 +12,9 @@
 #include <vector>
 #include <algorithm> //std::lower_bound
 #include <boost/math/tools/roots.hpp>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 /********************************************************************************
  * This class is the VarFcn class for the Tillotson equation of state (EOS)
@@ -111,6 +114,7 @@ private:
 
   //! Get ecold from trajectory. Extend the trajectory if needed.
   double GetColdEnergy(double rho);
+  double LookUpColdEnergy(double rho); //!< not thread-safe (the trajectory may be extended)
 
   inline double GetChiWithEta(double eta, double e) {return 1.0/(e/(e0*eta*eta)+1.0);}
   inline double GetChiWithOmega(double omega, double e) {return 1.0/(e/e0*(omega+1.0)*(omega+1)+1.0);}
@@ -480,6 +484,22 @@ VarFcnTillot::ExtendColdEnergyTrajectoryDownwards(double rhomin)
 
 double
 VarFcnTillot::GetColdEnergy(double rho)
+{
+#ifdef _OPENMP
+  if(omp_in_parallel()) { //the trajectory is shared by all the threads
+    double ecold;
+#pragma omp critical (m2c_tillotson_cold_energy)
+    ecold = LookUpColdEnergy(rho);
+    return ecold;
+  }
+#endif
+  return LookUpColdEnergy(rho);
+}
+
+//------------------------------------------------------------------------------
+
+double
+VarFcnTillot::LookUpColdEnergy(double rho)
 {
   int ind, index;
   if(rho>=rho0) { // get from ecold_plus